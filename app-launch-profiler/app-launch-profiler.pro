@@ -10,6 +10,7 @@ app-launch-tracepoints.path = $$installPath
 app-launch-tracepoints.files = app-launch-tracepoints
 app-launch-scripts.path = $$installPath
 app-launch-scripts.files = app-launch-profiler-lttng \
+                           startup-flamegraph-lttng \
                            profile_appstart.sh \
                            appstart_test
 INSTALLS += app-launch-tracepoints
@@ -24,6 +24,7 @@ HEADERS += \
     $$PWD/logger.h \
     $$PWD/logger_p.h \
     $$PWD/overlay_p.h \
+    $$PWD/tracing_p.h \
     $$PWD/ubuntumetricsglobal.h \
     $$PWD/ubuntumetricsglobal_p.h \
 
@@ -34,6 +35,7 @@ SOURCES += \
     $$PWD/gputimer.cpp \
     $$PWD/logger.cpp \
     $$PWD/overlay.cpp \
+    $$PWD/tracing.cpp \
     $$PWD/ubuntumetricsglobal.cpp
 
 load(ubuntu_qt_module)
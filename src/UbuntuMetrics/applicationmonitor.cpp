@@ -708,6 +708,8 @@ WindowMonitor::WindowMonitor(
     , m_id(id)
     , m_flags(flags)
     , m_frameSize(window->width(), window->height())
+    , m_gpuTimeFrame(0)
+    , m_pushedFrame(0)
 {
     DASSERT(applicationMonitor == UMApplicationMonitor::instance());
     DASSERT(m_applicationMonitor);
@@ -776,10 +778,14 @@ void WindowMonitor::initializeGpuResources()
     // FIXME(loicm) We should actually provide an API call to let the user set
     //     that behavior programmatically.
     static bool noGpuTimer = qEnvironmentVariableIsSet("UM_NO_GPU_TIMER");
+    static int gpuTimerDepth = qEnvironmentVariableIsSet("UM_GPU_TIMER_DEPTH") ?
+        qEnvironmentVariableIntValue("UM_GPU_TIMER_DEPTH") : GPUTimer::DefaultDepth;
 
     m_overlay.initialize();
-    m_gpuTimer.initialize();
+    m_gpuTimer.initialize(gpuTimerDepth);
     m_frameEvent.frame.number = 0;
+    m_gpuTimeFrame = 0;
+    m_pushedFrame = 0;
     m_flags |= GpuResourcesInitialized | (!noGpuTimer ? GpuTimerAvailable : 0);
 }
 
@@ -800,6 +806,8 @@ void WindowMonitor::finalizeGpuResources()
     m_overlay.finalize();
 
     m_frameEvent.frame.number = 0;
+    m_gpuTimeFrame = 0;
+    m_pushedFrame = 0;
     m_flags &= ~(GpuResourcesInitialized | GpuTimerAvailable);
 }
 
@@ -845,7 +853,7 @@ void WindowMonitor::windowBeforeRendering()
     if (m_flags & GpuResourcesInitialized) {
         m_sceneGraphTimer.start();
         if (m_flags & GpuTimerAvailable) {
-            m_gpuTimer.start();
+            m_gpuTimer.start(m_frameEvent.frame.number + 1);
         }
     }
 }
@@ -854,8 +862,13 @@ void WindowMonitor::windowAfterRendering()
 {
     if (m_flags & GpuResourcesInitialized) {
         m_frameEvent.frame.renderTime = m_sceneGraphTimer.nsecsElapsed();
-        m_frameEvent.frame.gpuTime = (m_flags & GpuTimerAvailable) ? m_gpuTimer.stop() : 0;
         m_frameEvent.frame.number++;
+        if (m_flags & GpuTimerAvailable) {
+            m_gpuTimer.stop();
+            harvestGpuTimes();
+        } else {
+            m_frameEvent.frame.gpuTime = 0;
+        }
         if (m_flags & UMApplicationMonitorPrivate::Overlay) {
             m_mutex.lock();
             m_overlay.render(m_frameEvent, m_frameSize);
@@ -874,7 +887,15 @@ void WindowMonitor::windowFrameSwapped()
             (m_flags & UMApplicationMonitor::FrameEvent)) {
             m_frameEvent.frame.swapTime = m_sceneGraphTimer.nsecsElapsed();
             m_frameEvent.timeStamp = UMEventUtils::timeStamp();
-            m_loggingThread->push(&m_frameEvent);
+            if (m_flags & GpuTimerAvailable) {
+                m_pendingFrames[m_frameEvent.frame.number % PendingFrameCount] = m_frameEvent;
+                pushFrameEvents();
+            } else {
+                m_loggingThread->push(&m_frameEvent);
+            }
+        } else {
+            // Frames not logged are never pushed.
+            m_pushedFrame = m_frameEvent.frame.number;
         }
     } else {
         initializeGpuResources();  // Get everything ready for the next frame.
@@ -884,6 +905,46 @@ void WindowMonitor::windowFrameSwapped()
     }
 }
 
+// Retrieves the GPU times of the previous frames available without waiting. The
+// overlay shows the latest one known. Times the timer couldn't measure are
+// reported as 0, which stands for not available in the events.
+void WindowMonitor::harvestGpuTimes()
+{
+    quint32 frame;
+    qint64 measuredTime;
+    while (m_gpuTimer.harvest(&frame, &measuredTime)) {
+        const quint64 time = measuredTime > 0 ? measuredTime : 0;
+        // Frames missing in the sequence have been dropped by the timer.
+        quint32 first = (frame - m_gpuTimeFrame > PendingFrameCount) ?
+            frame - PendingFrameCount + 1 : m_gpuTimeFrame + 1;
+        for (quint32 i = first; i < frame; ++i) {
+            m_pendingGpuTimes[i % PendingFrameCount] = 0;
+        }
+        m_pendingGpuTimes[frame % PendingFrameCount] = time;
+        m_gpuTimeFrame = frame;
+        m_frameEvent.frame.gpuTime = time;
+    }
+}
+
+// Pushes the swapped frame events to the logging thread, in order, as soon as
+// their GPU time is known so that each event carries the time of its own frame.
+void WindowMonitor::pushFrameEvents()
+{
+    const quint32 swappedFrame = m_frameEvent.frame.number;
+    while (m_pushedFrame < swappedFrame) {
+        const quint32 frame = m_pushedFrame + 1;
+        // Don't wait any longer once the slot is about to be reused.
+        if (frame > m_gpuTimeFrame && swappedFrame - frame < PendingFrameCount - 1) {
+            break;
+        }
+        UMEvent& event = m_pendingFrames[frame % PendingFrameCount];
+        event.frame.gpuTime =
+            (frame <= m_gpuTimeFrame) ? m_pendingGpuTimes[frame % PendingFrameCount] : 0;
+        m_loggingThread->push(&event);
+        m_pushedFrame = frame;
+    }
+}
+
 void WindowMonitor::windowSceneGraphAboutToStop()
 {
 #if !defined(QT_NO_DEBUG)
@@ -196,6 +196,11 @@ private:
     }
     void initializeGpuResources();
     void finalizeGpuResources();
+    void harvestGpuTimes();
+    void pushFrameEvents();
+
+    // Number of frame events which can wait for their GPU time.
+    enum { PendingFrameCount = 2 * GPUTimer::MaxDepth };
 
     UMApplicationMonitor* m_applicationMonitor;
     LoggingThread* m_loggingThread;
@@ -209,6 +214,12 @@ private:
     quint32 m_flags;
     QSize m_frameSize;
     UMEvent m_frameEvent;
+    // Frame events and GPU times indexed by frame number modulo
+    // PendingFrameCount. m_gpuTimeFrame is the last frame with a known GPU time.
+    UMEvent m_pendingFrames[PendingFrameCount];
+    quint64 m_pendingGpuTimes[PendingFrameCount];
+    quint32 m_gpuTimeFrame;
+    quint32 m_pushedFrame;
 
     friend class WindowMonitorDeleter;
     friend class WindowMonitorFlagSetter;
@@ -20,31 +20,229 @@
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
-#include <cstdio>
 
 #include <QtCore/QElapsedTimer>
 
 #include "ubuntumetricsglobal_p.h"
 
-const int bufferSize = 128;
+// Big enough for the biggest file read, /proc/self/status.
+const int bufferSize = 4096;
 const int bufferAlignment = 64;
 
-UMEventUtils::UMEventUtils()
-    : d_ptr(new EventUtilsPrivate)
+static const char* const procFiles[] = {
+    "/proc/self/stat", "/proc/self/status", "/proc/self/schedstat", "/proc/self/smaps_rollup",
+    "/proc/self/io"
+};
+
+// Parses the unsigned decimal number following the spaces at text. Returns the
+// position following the number.
+static const char* parseNumber(const char* text, const char* end, quint64* value)
 {
+    while (text < end && (*text == ' ' || *text == '\t')) {
+        text++;
+    }
+    quint64 result = 0;
+    while (text < end && *text >= '0' && *text <= '9') {
+        result = result * 10 + (*text++ - '0');
+    }
+    *value = result;
+    return text;
 }
 
-EventUtilsPrivate::EventUtilsPrivate()
+// Looks for the line starting with the given key from text. Returns the
+// position following the key, or nullptr if not found.
+static const char* findKey(const char* text, const char* end, const char* key, int keySize)
+{
+    while (end - text >= keySize) {
+        if (!memcmp(text, key, keySize)) {
+            return text + keySize;
+        }
+        text = static_cast<const char*>(memchr(text, '\n', end - text));
+        if (!text) {
+            return nullptr;
+        }
+        text++;
+    }
+    return nullptr;
+}
+
+// Parses the value of the line starting with the given key literal. text is
+// moved after the value if found, keys have to be looked up in file order.
+#define PARSE_KEY(text, end, key, value)                                \
+    parseKey(text, end, key, sizeof(key) - 1, value)
+
+static bool parseKey(const char*& text, const char* end, const char* key, int keySize,
+                     quint64* value)
 {
+    const char* found = findKey(text, end, key, keySize);
+    if (!found) {
+        *value = 0;
+        return false;
+    }
+    text = parseNumber(found, end, value);
+    return true;
+}
+
+ProcessSampler::ProcessSampler()
+{
+    Q_STATIC_ASSERT(ARRAY_SIZE(procFiles) == FileCount);
+
 #if !defined(QT_NO_DEBUG)
     ASSERT(m_buffer = static_cast<char*>(alignedAlloc(bufferAlignment, bufferSize)));
 #else
     m_buffer = static_cast<char*>(alignedAlloc(bufferAlignment, bufferSize));
 #endif
+    for (int i = 0; i < FileCount; i++) {
+        // smaps_rollup requires Linux 4.14 and io a kernel with task I/O
+        // accounting, their metrics are just left to 0 when not available.
+        if ((m_fd[i] = open(procFiles[i], O_RDONLY | O_CLOEXEC)) == -1) {
+            DWARN("EventUtils: can't open '%s'", procFiles[i]);
+        }
+    }
+    m_pageSize = sysconf(_SC_PAGESIZE);
+}
+
+ProcessSampler::~ProcessSampler()
+{
+    for (int i = 0; i < FileCount; i++) {
+        if (m_fd[i] != -1) {
+            close(m_fd[i]);
+        }
+    }
+    free(m_buffer);
+}
+
+// Reads the whole file in the buffer and returns its size, 0 on error.
+int ProcessSampler::read(File file)
+{
+    if (m_fd[file] == -1) {
+        return 0;
+    }
+    // /proc files are generated at read time, reading from offset 0 gets
+    // up-to-date content without having to reopen the file.
+    const ssize_t size = pread(m_fd[file], m_buffer, bufferSize, 0);
+    if (size <= 0) {
+        DWARN("EventUtils: can't read '%s'", procFiles[file]);
+        return 0;
+    }
+    DASSERT(size < bufferSize);  // Consider increasing bufferSize.
+    return size;
+}
+
+void ProcessSampler::sample(UMProcessEvent* event)
+{
+    DASSERT(event);
+
+    sampleStat(event, read(Stat));
+    sampleStatus(event, read(Status));
+    sampleSchedStat(event, read(SchedStat));
+    sampleSmapsRollup(event, read(SmapsRollup));
+    sampleIo(event, read(Io));
+}
+
+void ProcessSampler::sampleStat(UMProcessEvent* event, int size)
+{
+    // Entries starting from 1 (as listed by 'man proc').
+    const int minorFaultsEntry = 10;
+    const int majorFaultsEntry = 12;
+    const int numThreadsEntry = 20;
+    const int vsizeEntry = 23;
+    const int rssEntry = 24;
+
+    // The command name (entry 2) is enclosed in parentheses and can contain
+    // spaces, entries are counted from the closing one.
+    const char* end = m_buffer + size;
+    const char* text = static_cast<const char*>(memrchr(m_buffer, ')', size));
+    if (!text) {
+        return;
+    }
+    for (int entry = 3; entry <= rssEntry; entry++) {
+        text = static_cast<const char*>(memchr(text, ' ', end - text));
+        if (!text) {
+            DNOT_REACHED();  // Missing entries in /proc/self/stat.
+            return;
+        }
+        text++;
+        quint64 value;
+        switch (entry) {
+        case minorFaultsEntry:
+            parseNumber(text, end, &value);
+            event->minorFaults = value;
+            break;
+        case majorFaultsEntry:
+            parseNumber(text, end, &value);
+            event->majorFaults = value;
+            break;
+        case numThreadsEntry:
+            parseNumber(text, end, &value);
+            event->threadCount = value;
+            break;
+        case vsizeEntry:
+            parseNumber(text, end, &value);
+            event->vszMemory = value >> 10;
+            break;
+        case rssEntry:
+            parseNumber(text, end, &value);
+            event->rssMemory = (value * m_pageSize) >> 10;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void ProcessSampler::sampleStatus(UMProcessEvent* event, int size)
+{
+    const char* text = m_buffer;
+    const char* end = m_buffer + size;
+    quint64 value;
+    PARSE_KEY(text, end, "voluntary_ctxt_switches:", &value);
+    event->voluntaryContextSwitches = value;
+    PARSE_KEY(text, end, "nonvoluntary_ctxt_switches:", &value);
+    event->involuntaryContextSwitches = value;
+}
+
+void ProcessSampler::sampleSchedStat(UMProcessEvent* event, int size)
+{
+    // Time spent on the CPU, time spent waiting on a run queue and number of
+    // time slices, in that order.
+    const char* end = m_buffer + size;
+    quint64 value;
+    const char* text = parseNumber(m_buffer, end, &value);
+    parseNumber(text, end, &value);
+    event->schedulingWaitTime = value;
+}
+
+void ProcessSampler::sampleSmapsRollup(UMProcessEvent* event, int size)
+{
+    const char* text = m_buffer;
+    const char* end = m_buffer + size;
+    quint64 pss, privateClean, privateDirty;
+    PARSE_KEY(text, end, "Pss:", &pss);
+    PARSE_KEY(text, end, "Private_Clean:", &privateClean);
+    PARSE_KEY(text, end, "Private_Dirty:", &privateDirty);
+    event->pssMemory = pss;
+    event->ussMemory = privateClean + privateDirty;
+}
+
+void ProcessSampler::sampleIo(UMProcessEvent* event, int size)
+{
+    const char* text = m_buffer;
+    const char* end = m_buffer + size;
+    PARSE_KEY(text, end, "read_bytes:", &event->ioReadBytes);
+    PARSE_KEY(text, end, "write_bytes:", &event->ioWriteBytes);
+}
+
+UMEventUtils::UMEventUtils()
+    : d_ptr(new EventUtilsPrivate)
+{
+}
+
+EventUtilsPrivate::EventUtilsPrivate()
+{
     m_cpuTimer.start();
     m_cpuTicks = times(&m_cpuTimes);
     m_cpuOnlineCores = sysconf(_SC_NPROCESSORS_ONLN);
-    m_pageSize = sysconf(_SC_PAGESIZE);
 }
 
 UMEventUtils::~UMEventUtils()
@@ -54,7 +252,6 @@ UMEventUtils::~UMEventUtils()
 
 EventUtilsPrivate::~EventUtilsPrivate()
 {
-    free(m_buffer);
 }
 
 void UMEventUtils::updateProcessEvent(UMEvent* event)
@@ -65,7 +262,7 @@ void UMEventUtils::updateProcessEvent(UMEvent* event)
     event->type = UMEvent::Process;
     event->timeStamp = UMEventUtils::timeStamp();
     d->updateCpuUsage(event);
-    d->updateProcStatMetrics(event);
+    d->m_processSampler.sample(&event->process);
 }
 
 void EventUtilsPrivate::updateCpuUsage(UMEvent* event)
@@ -88,63 +285,6 @@ void EventUtilsPrivate::updateCpuUsage(UMEvent* event)
     }
 }
 
-void EventUtilsPrivate::updateProcStatMetrics(UMEvent* event)
-{
-    int fd = open("/proc/self/stat", O_RDONLY);
-    if (fd == -1) {
-        DWARN("EventUtils: can't open '/proc/self/stat'");
-        return;
-    }
-    int readSize;
-    if ((readSize = read(fd, m_buffer, bufferSize)) == 0) {
-        DWARN("EventUtils: can't read '/proc/self/stat'");
-        close(fd);
-        return;
-    }
-
-    // Entries starting from 1 (as listed by 'man proc').
-    const int numThreadsEntry = 20;
-    const int vsizeEntry = 23;
-    const int rssEntry = 24;
-    const int lastEntry = rssEntry;
-
-    // Get the indices of num_threads, vsize and rss entries and check if
-    // the buffer is big enough.
-    int sourceIndex = 0, spaceCount = 0;
-    quint16 entryIndices[lastEntry + 1];
-    entryIndices[sourceIndex] = 0;
-    while (spaceCount < lastEntry) {
-        if (sourceIndex < readSize) {
-            if (m_buffer[sourceIndex++] == ' ') {
-                entryIndices[++spaceCount] = sourceIndex;
-            }
-        } else {
-            DASSERT(readSize == bufferSize); // Missing entries in /proc/self/stat.
-            DNOT_REACHED();  // Consider increasing bufferSize.
-            close(fd);
-            return;
-        }
-    }
-
-    unsigned long vsize;
-    long threadCount, rss;
-#if !defined(QT_NO_DEBUG)
-    int value =  sscanf(&m_buffer[entryIndices[numThreadsEntry-1]], "%ld", &threadCount);
-    ASSERT(value == 1);
-    value =  sscanf(&m_buffer[entryIndices[vsizeEntry-1]], "%lu %ld", &vsize, &rss);
-    ASSERT(value == 2);
-#else
-    sscanf(&m_buffer[entryIndices[numThreadsEntry-1]], "%ld", &threadCount);
-    sscanf(&m_buffer[entryIndices[vsizeEntry-1]], "%lu %ld", &vsize, &rss);
-#endif
-
-    event->process.vszMemory = vsize >> 10;
-    event->process.rssMemory = (rss * m_pageSize) >> 10;
-    event->process.threadCount = threadCount;
-
-    close(fd);
-}
-
 // static.
 quint64 UMEventUtils::timeStamp()
 {
@@ -39,9 +39,39 @@ struct UBUNTU_METRICS_EXPORT UMProcessEvent
     // Number of threads at buffer swap.
     quint16 threadCount;
 
+    // Proportional set size (PSS) of the process in kilobytes, shared pages
+    // being divided by the number of processes mapping them. 0 if the kernel
+    // doesn't provide /proc/self/smaps_rollup.
+    quint32 pssMemory;
+
+    // Unique set size (USS) of the process in kilobytes, the memory which
+    // would be freed if the process was terminated.
+    quint32 ussMemory;
+
+    // Number of voluntary (blocked waiting for a resource) and involuntary
+    // (preempted) context switches since the process start.
+    quint32 voluntaryContextSwitches;
+    quint32 involuntaryContextSwitches;
+
+    // Number of major page faults (requiring a disk access) since the process
+    // start.
+    quint32 majorFaults;
+
+    // Number of minor page faults since the process start.
+    quint64 minorFaults;
+
+    // Number of bytes read from and written to the storage layer since the
+    // process start.
+    quint64 ioReadBytes;
+    quint64 ioWriteBytes;
+
+    // Time in nanoseconds spent by the main thread waiting on a run queue since
+    // the process start.
+    quint64 schedulingWaitTime;
+
     // The whole struct must take 112 bytes to allow future additions and best
     // memory alignment, don't forget to update when adding new metrics.
-    quint8 __reserved[/*12 bytes taken,*/ 100 /*bytes free*/];
+    quint8 __reserved[/*64 bytes taken,*/ 48 /*bytes free*/];
 };
 Q_STATIC_ASSERT(sizeof(UMProcessEvent) == 112);
 
@@ -87,7 +117,7 @@ struct UBUNTU_METRICS_EXPORT UMFrameEvent
     quint64 renderTime;
 
     // Time in nanoseconds taken by the GPU to execute the graphics commands
-    // pushed during the QtQuick scene graph render pass.
+    // pushed during the QtQuick scene graph render pass, 0 if not available.
     quint64 gpuTime;
 
     // Time in nanoseconds taken by the graphics subsystem's buffer swap call.
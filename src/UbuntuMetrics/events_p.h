@@ -26,6 +26,34 @@
 
 #include <UbuntuMetrics/private/ubuntumetricsglobal_p.h>
 
+// Samples the process metrics exposed by the kernel in /proc/self. The files
+// are opened once and read again from the start with pread() into a fixed
+// buffer at each sample, there's no allocation and no sscanf() involved.
+class UBUNTU_METRICS_PRIVATE_EXPORT ProcessSampler
+{
+public:
+    ProcessSampler();
+    ~ProcessSampler();
+
+    // Fills the memory, fault, context switch, I/O and scheduling metrics of
+    // the process event. Metrics of files which can't be read are set to 0.
+    void sample(UMProcessEvent* event);
+
+private:
+    enum File { Stat = 0, Status, SchedStat, SmapsRollup, Io, FileCount };
+
+    int read(File file);
+    void sampleStat(UMProcessEvent* event, int size);
+    void sampleStatus(UMProcessEvent* event, int size);
+    void sampleSchedStat(UMProcessEvent* event, int size);
+    void sampleSmapsRollup(UMProcessEvent* event, int size);
+    void sampleIo(UMProcessEvent* event, int size);
+
+    char* m_buffer;
+    int m_fd[FileCount];
+    quint16 m_pageSize;
+};
+
 class UBUNTU_METRICS_PRIVATE_EXPORT EventUtilsPrivate
 {
 public:
@@ -33,14 +61,12 @@ public:
     ~EventUtilsPrivate();
 
     void updateCpuUsage(UMEvent* event);
-    void updateProcStatMetrics(UMEvent* event);
 
-    char* m_buffer;
+    ProcessSampler m_processSampler;
     QElapsedTimer m_cpuTimer;
     struct tms m_cpuTimes;
     clock_t m_cpuTicks;
     quint16 m_cpuOnlineCores;
-    quint16 m_pageSize;
 };
 
 #endif  // EVENTS_P_H
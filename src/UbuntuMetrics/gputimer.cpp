@@ -17,15 +17,16 @@
 
 #include "gputimer_p.h"
 
-#include <QtCore/QElapsedTimer>
-
 #include "ubuntumetricsglobal_p.h"
 
 #if !defined(QT_OPENGL_ES) && !defined(GL_TIME_ELAPSED)
 #define GL_TIME_ELAPSED 0x88BF  // For GL_EXT_timer_query.
 #endif
+#if !defined(QT_OPENGL_ES) && !defined(GL_QUERY_RESULT_AVAILABLE)
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
 
-void GPUTimer::initialize()
+void GPUTimer::initialize(int depth)
 {
     DASSERT(QOpenGLContext::currentContext());
     DASSERT(m_type == Unset);
@@ -34,6 +35,12 @@ void GPUTimer::initialize()
     m_context = QOpenGLContext::currentContext();
 #endif
 
+    m_depth = qBound(1, depth, static_cast<int>(MaxDepth));
+    m_head = 0;
+    m_count = 0;
+    m_dropped = 0;
+    m_clock.start();
+
 #if defined(QT_OPENGL_ES)
     QList<QByteArray> eglExtensions = QByteArray(
         static_cast<const char*>(
@@ -54,6 +61,9 @@ void GPUTimer::initialize()
         m_fenceSyncKHR.clientWaitSyncKHR = reinterpret_cast<
             EGLint (QOPENGLF_APIENTRYP)(EGLDisplay, EGLSyncKHR, EGLint, EGLTimeKHR)>(
                 eglGetProcAddress("eglClientWaitSyncKHR"));
+        for (int i = 0; i < 2 * MaxDepth; ++i) {
+            m_sync[i] = EGL_NO_SYNC_KHR;
+        }
         m_type = KHRFence;
         DLOG("GPUTimer is based on GL_OES_EGL_sync");
 
@@ -66,9 +76,9 @@ void GPUTimer::initialize()
                 eglGetProcAddress("glDeleteFencesNV"));
         m_fenceNV.setFenceNV = reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint, GLenum)>(
             eglGetProcAddress("glSetFenceNV"));
-        m_fenceNV.finishFenceNV = reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint)>(
-            eglGetProcAddress("glFinishFenceNV"));
-        m_fenceNV.genFencesNV(2, m_fence);
+        m_fenceNV.testFenceNV = reinterpret_cast<GLboolean (QOPENGLF_APIENTRYP)(GLuint)>(
+            eglGetProcAddress("glTestFenceNV"));
+        m_fenceNV.genFencesNV(2 * m_depth, m_fence);
         m_type = NVFence;
         DLOG("GPUTimer is based on GL_NV_fence");
     }
@@ -89,12 +99,15 @@ void GPUTimer::initialize()
         m_timerQuery.deleteQueries =
             reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLsizei, const GLuint*)>(
                 context->getProcAddress("glDeleteQueries"));
+        m_timerQuery.getQueryObjectuiv =
+            reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint, GLenum, GLuint*)>(
+                context->getProcAddress("glGetQueryObjectuiv"));
         m_timerQuery.getQueryObjectui64v =
             reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint, GLenum, GLuint64*)>(
                 context->getProcAddress("glGetQueryObjectui64v"));
         m_timerQuery.queryCounter = reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint, GLenum)>(
             context->getProcAddress("glQueryCounter"));
-        m_timerQuery.genQueries(2, m_timer);
+        m_timerQuery.genQueries(2 * m_depth, m_timer);
         m_type = ARBTimerQuery;
         DLOG("GPUTimer is based on GL_ARB_timer_query");
 
@@ -109,10 +122,16 @@ void GPUTimer::initialize()
             context->getProcAddress("glBeginQuery"));
         m_timerQuery.endQuery = reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLenum)>(
             context->getProcAddress("glEndQuery"));
+        m_timerQuery.getQueryObjectuiv =
+            reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint, GLenum, GLuint*)>(
+                context->getProcAddress("glGetQueryObjectuiv"));
         m_timerQuery.getQueryObjectui64vExt =
             reinterpret_cast<void (QOPENGLF_APIENTRYP)(GLuint, GLenum, GLuint64EXT*)>(
                 context->getProcAddress("glGetQueryObjectui64vEXT"));
-        m_timerQuery.genQueries(1, m_timer);
+        // One query per frame, stored at even indices.
+        for (int i = 0; i < m_depth; ++i) {
+            m_timerQuery.genQueries(1, &m_timer[2 * i]);
+        }
         m_type = EXTTimerQuery;
         DLOG("GPUTimer is based on GL_EXT_timer_query");
     }
@@ -120,7 +139,7 @@ void GPUTimer::initialize()
 
     else {
         m_type = Finish;
-        DLOG("GPUTimer is based on glFinish");
+        DLOG("GPUTimer is based on CPU timings");
     }
 }
 
@@ -133,34 +152,62 @@ void GPUTimer::finalize()
     m_context = nullptr;
 #endif
 
+    while (m_count > 0) {
+        releaseFrame(m_head);
+        m_head = (m_head + 1) % m_depth;
+        m_count--;
+    }
+
 #if defined(QT_OPENGL_ES)
     // KHRFence.
     if (m_type == KHRFence) {
-        if (m_beforeSync != EGL_NO_SYNC_KHR) {
-            m_fenceSyncKHR.destroySyncKHR(eglGetCurrentDisplay(), m_beforeSync);
+        // Syncs of an unstopped frame.
+        for (int i = 0; i < 2 * MaxDepth; ++i) {
+            if (m_sync[i] != EGL_NO_SYNC_KHR) {
+                m_fenceSyncKHR.destroySyncKHR(eglGetCurrentDisplay(), m_sync[i]);
+                m_sync[i] = EGL_NO_SYNC_KHR;
+            }
         }
-        m_type = Unset;
 
     // NVFence.
     } else if (m_type == NVFence) {
-        m_fenceNV.deleteFencesNV(2, m_fence);
-        m_type = Unset;
+        m_fenceNV.deleteFencesNV(2 * m_depth, m_fence);
     }
 #else
     // ARBTimerQuery.
     if (m_type == ARBTimerQuery) {
-        m_timerQuery.deleteQueries(2, m_timer);
-        m_type = Unset;
+        m_timerQuery.deleteQueries(2 * m_depth, m_timer);
 
     // EXTTimerQuery.
     } else if (m_type == EXTTimerQuery) {
-        m_timerQuery.deleteQueries(1, m_timer);
-        m_type = Unset;
+        for (int i = 0; i < m_depth; ++i) {
+            m_timerQuery.deleteQueries(1, &m_timer[2 * i]);
+        }
+    }
+#endif
+
+    m_type = Unset;
+}
+
+// Frees the per frame resources which can't be reused as is.
+void GPUTimer::releaseFrame(int index)
+{
+#if defined(QT_OPENGL_ES)
+    if (m_type == KHRFence) {
+        EGLDisplay dpy = eglGetCurrentDisplay();
+        for (int i = 2 * index; i < 2 * index + 2; ++i) {
+            if (m_sync[i] != EGL_NO_SYNC_KHR) {
+                m_fenceSyncKHR.destroySyncKHR(dpy, m_sync[i]);
+                m_sync[i] = EGL_NO_SYNC_KHR;
+            }
+        }
     }
+#else
+    Q_UNUSED(index);
 #endif
 }
 
-void GPUTimer::start()
+void GPUTimer::start(quint32 frame)
 {
     DASSERT(m_context == QOpenGLContext::currentContext());
     DASSERT(m_type != Unset);
@@ -170,29 +217,47 @@ void GPUTimer::start()
     m_started = true;
 #endif
 
+    // Drop the oldest frame rather than waiting for it.
+    if (m_count == m_depth) {
+        releaseFrame(m_head);
+        m_head = (m_head + 1) % m_depth;
+        m_count--;
+        m_dropped++;
+    }
+    const int index = (m_head + m_count) % m_depth;
+    Frame& current = m_frames[index];
+    current.number = frame;
+    current.signaled = 0;
+
 #if defined(QT_OPENGL_ES)
     // KHRFence.
     if (m_type == KHRFence) {
-        m_beforeSync = m_fenceSyncKHR.createSyncKHR(
+        pollFences();
+        m_sync[2 * index] = m_fenceSyncKHR.createSyncKHR(
             eglGetCurrentDisplay(), EGL_SYNC_FENCE_KHR, NULL);
 
     // NVFence.
     } else if (m_type == NVFence) {
-        m_fenceNV.setFenceNV(m_fence[0], GL_ALL_COMPLETED_NV);
+        pollFences();
+        m_fenceNV.setFenceNV(m_fence[2 * index], GL_ALL_COMPLETED_NV);
     }
 #else
     // ARBTimerQuery.
     if (m_type == ARBTimerQuery) {
-        m_timerQuery.queryCounter(m_timer[0], GL_TIMESTAMP);
+        m_timerQuery.queryCounter(m_timer[2 * index], GL_TIMESTAMP);
 
     // EXTTimerQuery.
     } else if (m_type == EXTTimerQuery) {
-        m_timerQuery.beginQuery(GL_TIME_ELAPSED, m_timer[0]);
+        m_timerQuery.beginQuery(GL_TIME_ELAPSED, m_timer[2 * index]);
     }
 #endif
+    // Finish.
+    else {
+        current.cpuTime[0] = m_clock.nsecsElapsed();
+    }
 }
 
-quint64 GPUTimer::stop()
+void GPUTimer::stop()
 {
     DASSERT(m_context == QOpenGLContext::currentContext());
     DASSERT(m_type != Unset);
@@ -202,69 +267,137 @@ quint64 GPUTimer::stop()
     m_started = false;
 #endif
 
+    const int index = (m_head + m_count) % m_depth;
+
 #if defined(QT_OPENGL_ES)
     // KHRFence.
     if (m_type == KHRFence) {
-        QElapsedTimer timer;
-        EGLDisplay dpy = eglGetCurrentDisplay();
-        EGLSyncKHR afterSync = m_fenceSyncKHR.createSyncKHR(dpy, EGL_SYNC_FENCE_KHR, NULL);
-        EGLint beforeSyncValue =
-            m_fenceSyncKHR.clientWaitSyncKHR(dpy, m_beforeSync, 0, EGL_FOREVER_KHR);
-        quint64 beforeTime = timer.nsecsElapsed();
-        EGLint afterSyncValue =
-            m_fenceSyncKHR.clientWaitSyncKHR(
-                dpy, afterSync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, EGL_FOREVER_KHR);
-        quint64 afterTime = timer.nsecsElapsed();
-        m_fenceSyncKHR.destroySyncKHR(dpy, afterSync);
-        m_fenceSyncKHR.destroySyncKHR(dpy, m_beforeSync);
-        m_beforeSync = EGL_NO_SYNC_KHR;
-        if (beforeSyncValue == EGL_CONDITION_SATISFIED_KHR
-            && afterSyncValue == EGL_CONDITION_SATISFIED_KHR) {
-            return afterTime - beforeTime;
-        } else {
-            return 0;
-        }
+        pollFences();
+        m_sync[2 * index + 1] = m_fenceSyncKHR.createSyncKHR(
+            eglGetCurrentDisplay(), EGL_SYNC_FENCE_KHR, NULL);
 
     // NVFence.
     } else if (m_type == NVFence) {
-        QElapsedTimer timer;
-        m_fenceNV.setFenceNV(m_fence[1], GL_ALL_COMPLETED_NV);
-        m_fenceNV.finishFenceNV(m_fence[0]);
-        quint64 beforeTime = timer.nsecsElapsed();
-        m_fenceNV.finishFenceNV(m_fence[1]);
-        quint64 afterTime = timer.nsecsElapsed();
-        return afterTime - beforeTime;
+        pollFences();
+        m_fenceNV.setFenceNV(m_fence[2 * index + 1], GL_ALL_COMPLETED_NV);
     }
 #else
     // ARBTimerQuery.
     if (m_type == ARBTimerQuery) {
-        GLuint64 time[2] = { 0, 0 };
-        m_timerQuery.queryCounter(m_timer[1], GL_TIMESTAMP);
-        m_timerQuery.getQueryObjectui64v(m_timer[0], GL_QUERY_RESULT, &time[0]);
-        m_timerQuery.getQueryObjectui64v(m_timer[1], GL_QUERY_RESULT, &time[1]);
-        if (time[0] != 0 && time[1] != 0) {
-            return time[1] - time[0];
-        } else {
-            return -1;
-        }
+        m_timerQuery.queryCounter(m_timer[2 * index + 1], GL_TIMESTAMP);
 
     // EXTTimerQuery.
     } else if (m_type == EXTTimerQuery) {
-        GLuint64EXT time;
         m_timerQuery.endQuery(GL_TIME_ELAPSED);
-        m_timerQuery.getQueryObjectui64vExt(m_timer[0], GL_QUERY_RESULT, &time);
-        return time;
+    }
+#endif
+    // Finish. The time taken to push the commands from the CPU is used as an
+    // approximation, glFinish() would stall the render thread.
+    else {
+        m_frames[index].cpuTime[1] = m_clock.nsecsElapsed();
+        m_frames[index].signaled = 0x3;
+    }
+
+    m_count++;
+}
+
+#if defined(QT_OPENGL_ES)
+// Fences don't carry GPU timestamps, the time is approximated by the CPU time
+// at which each of them is first seen signaled. The frames in flight are polled
+// at each start(), stop() and harvest(), so the precision depends on that rate.
+// The fences of a frame first seen signaled in the same poll leave its time
+// unknown.
+void GPUTimer::pollFences()
+{
+    EGLDisplay dpy = eglGetCurrentDisplay();
+    const quint64 now = m_clock.nsecsElapsed();
+    for (int i = 0; i < m_count; ++i) {
+        const int index = (m_head + i) % m_depth;
+        Frame& frame = m_frames[index];
+        for (int j = 0; j < 2; ++j) {
+            if (frame.signaled & (1 << j)) {
+                continue;
+            }
+            bool signaled;
+            if (m_type == KHRFence) {
+                // A zero timeout returns immediately, the flush ensures the
+                // fence will eventually be signaled.
+                signaled = m_fenceSyncKHR.clientWaitSyncKHR(
+                    dpy, m_sync[2 * index + j], EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, 0)
+                    == EGL_CONDITION_SATISFIED_KHR;
+            } else {
+                signaled = m_fenceNV.testFenceNV(m_fence[2 * index + j]) == GL_TRUE;
+            }
+            if (!signaled) {
+                // Later fences can't be signaled either.
+                return;
+            }
+            frame.cpuTime[j] = now;
+            frame.signaled |= 1 << j;
+        }
+    }
+}
+#endif
+
+bool GPUTimer::harvest(quint32* frame, qint64* time)
+{
+    DASSERT(m_context == QOpenGLContext::currentContext());
+    DASSERT(m_type != Unset);
+    DASSERT(frame);
+    DASSERT(time);
+
+    if (m_count == 0) {
+        return false;
+    }
+    const int index = m_head;
+
+#if defined(QT_OPENGL_ES)
+    // KHRFence and NVFence.
+    if (m_type == KHRFence || m_type == NVFence) {
+        pollFences();
+        if (m_frames[index].signaled != 0x3) {
+            return false;
+        }
+        *time = (m_frames[index].cpuTime[1] > m_frames[index].cpuTime[0])
+            ? m_frames[index].cpuTime[1] - m_frames[index].cpuTime[0] : -1;
+    }
+#else
+    // ARBTimerQuery.
+    if (m_type == ARBTimerQuery) {
+        GLuint available = GL_FALSE;
+        m_timerQuery.getQueryObjectuiv(
+            m_timer[2 * index + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+        // Queries complete in order, both results are there without waiting.
+        GLuint64 timeStamp[2] = { 0, 0 };
+        m_timerQuery.getQueryObjectui64v(m_timer[2 * index], GL_QUERY_RESULT, &timeStamp[0]);
+        m_timerQuery.getQueryObjectui64v(m_timer[2 * index + 1], GL_QUERY_RESULT, &timeStamp[1]);
+        *time = (timeStamp[0] != 0 && timeStamp[1] > timeStamp[0])
+            ? timeStamp[1] - timeStamp[0] : -1;
+
+    // EXTTimerQuery.
+    } else if (m_type == EXTTimerQuery) {
+        GLuint available = GL_FALSE;
+        m_timerQuery.getQueryObjectuiv(
+            m_timer[2 * index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+        GLuint64EXT elapsed = 0;
+        m_timerQuery.getQueryObjectui64vExt(m_timer[2 * index], GL_QUERY_RESULT, &elapsed);
+        *time = elapsed;
     }
 #endif
     // Finish.
     else {
-        QOpenGLFunctions* functions = QOpenGLContext::currentContext()->functions();
-        QElapsedTimer timer;
-        timer.start();
-        functions->glFinish();
-        return static_cast<quint64>(timer.nsecsElapsed());
+        *time = m_frames[index].cpuTime[1] - m_frames[index].cpuTime[0];
     }
 
-    DNOT_REACHED();
-    return 0;
+    *frame = m_frames[index].number;
+    releaseFrame(index);
+    m_head = (m_head + 1) % m_depth;
+    m_count--;
+    return true;
 }
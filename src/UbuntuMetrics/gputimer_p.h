@@ -18,6 +18,7 @@
 #ifndef GPUTIMER_P_H
 #define GPUTIMER_P_H
 
+#include <QtCore/QElapsedTimer>
 #include <QtGui/QOpenGLFunctions>
 
 #if defined(QT_OPENGL_ES)
@@ -33,29 +34,48 @@
 // in the command buffer from the CPU, this timer pushes dedicated
 // synchronization commands to the command buffer, which the GPU signals
 // whenever completed. That allows to get accurate GPU timings.
+//
+// The timer never waits for the GPU. Up to depth() frames can be in flight, the
+// results being retrieved a few frames later with harvest() once the GPU has
+// signaled them.
 class UBUNTU_METRICS_PRIVATE_EXPORT GPUTimer
 {
 public:
+    enum { MaxDepth = 8, DefaultDepth = 3 };
+
     GPUTimer() :
 #if !defined QT_NO_DEBUG
         m_context(nullptr), m_started(false),
 #endif
-        m_type(Unset) {}
+        m_type(Unset), m_depth(0), m_head(0), m_count(0), m_dropped(0) {}
 
     // Allocates/Deletes the OpenGL resources. finalize() is not called at
     // destruction, it must be explicitly called to free the resources at the
     // right time in a thread with the same OpenGL context bound than at
-    // initialize().
-    void initialize();
+    // initialize(). depth is the number of frames which can be timed
+    // simultaneously, clamped to [1, MaxDepth].
+    void initialize(int depth = DefaultDepth);
     void finalize();
 
-    // Starts/Stops the timer. stop() returns the time elapsed in nanoseconds
-    // since the call to start(). Calling start()/stop() two times in a row
-    // triggers an assertion in debug builds and leads to undefined results in
-    // non-debug builds. Must be called in a thread with the same OpenGL context
-    // bound than at initialize().
-    void start();
-    quint64 stop();
+    // Starts/Stops timing the graphics commands of the given frame. If depth()
+    // frames are still in flight at start(), the oldest one is dropped. Calling
+    // start()/stop() two times in a row triggers an assertion in debug builds
+    // and leads to undefined results in non-debug builds. Must be called in a
+    // thread with the same OpenGL context bound than at initialize().
+    void start(quint32 frame);
+    void stop();
+
+    // Gets the time in nanoseconds taken by the oldest frame in flight if the
+    // GPU is done with it, in which case true is returned and the frame is
+    // removed. The time is -1 if it couldn't be measured. Results come in
+    // start() order, frames missing in the sequence have been dropped. Must be
+    // called in a thread with the same OpenGL context bound than at
+    // initialize().
+    bool harvest(quint32* frame, qint64* time);
+
+    int depth() const { return m_depth; }
+    int pendingCount() const { return m_count; }
+    quint32 droppedCount() const { return m_dropped; }
 
 private:
     enum Type {
@@ -70,20 +90,39 @@ private:
 #endif
     };
 
+    struct Frame {
+        quint32 number;
+        // CPU times at which the start and stop commands have been seen
+        // completed (fences) or issued (Finish).
+        quint64 cpuTime[2];
+        quint8 signaled;
+    };
+
+    void releaseFrame(int index);
+#if defined(QT_OPENGL_ES)
+    void pollFences();
+#endif
+
 #if !defined QT_NO_DEBUG
     QOpenGLContext* m_context;
     bool m_started;
 #endif
     Type m_type;
+    int m_depth;
+    int m_head;
+    int m_count;
+    quint32 m_dropped;
+    QElapsedTimer m_clock;
+    Frame m_frames[MaxDepth];
 
 #if defined(QT_OPENGL_ES)
     struct {
         void (QOPENGLF_APIENTRYP genFencesNV)(GLsizei n, GLuint* fences);
         void (QOPENGLF_APIENTRYP deleteFencesNV)(GLsizei n, const GLuint* fences);
         void (QOPENGLF_APIENTRYP setFenceNV)(GLuint fence, GLenum condition);
-        void (QOPENGLF_APIENTRYP finishFenceNV)(GLuint fence);
+        GLboolean (QOPENGLF_APIENTRYP testFenceNV)(GLuint fence);
     } m_fenceNV;
-    GLuint m_fence[2];
+    GLuint m_fence[2 * MaxDepth];
 
     struct {
         EGLSyncKHR (QOPENGLF_APIENTRYP createSyncKHR)(EGLDisplay dpy, EGLenum type,
@@ -92,7 +131,7 @@ private:
         EGLint (QOPENGLF_APIENTRYP clientWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags,
                                                       EGLTimeKHR timeout);
     } m_fenceSyncKHR;
-    EGLSyncKHR m_beforeSync;
+    EGLSyncKHR m_sync[2 * MaxDepth];
 
 #else
     struct {
@@ -100,12 +139,13 @@ private:
         void (QOPENGLF_APIENTRYP deleteQueries)(GLsizei n, const GLuint* ids);
         void (QOPENGLF_APIENTRYP beginQuery)(GLenum target, GLuint id);
         void (QOPENGLF_APIENTRYP endQuery)(GLenum target);
+        void (QOPENGLF_APIENTRYP getQueryObjectuiv)(GLuint id, GLenum pname, GLuint* params);
         void (QOPENGLF_APIENTRYP getQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params);
         void (QOPENGLF_APIENTRYP getQueryObjectui64vExt)(GLuint id, GLenum pname,
                                                          GLuint64EXT* params);
         void (QOPENGLF_APIENTRYP queryCounter)(GLuint id, GLenum target);
     } m_timerQuery;
-    GLuint m_timer[2];
+    GLuint m_timer[2 * MaxDepth];
 #endif
 };
 
@@ -127,7 +127,16 @@ void UMFileLoggerPrivate::log(const UMEvent& event)
                     << event.process.cpuUsage << ' '
                     << event.process.vszMemory << ' '
                     << event.process.rssMemory << ' '
-                    << event.process.threadCount << '\n' << flush;
+                    << event.process.threadCount << ' '
+                    << event.process.pssMemory << ' '
+                    << event.process.ussMemory << ' '
+                    << event.process.minorFaults << ' '
+                    << event.process.majorFaults << ' '
+                    << event.process.voluntaryContextSwitches << ' '
+                    << event.process.involuntaryContextSwitches << ' '
+                    << event.process.ioReadBytes << ' '
+                    << event.process.ioWriteBytes << ' '
+                    << event.process.schedulingWaitTime << '\n' << flush;
             } else {
                 m_textStream
                     << (m_flags & Colored ? "\033[33mP\033[00m " : "P ")
@@ -135,7 +144,16 @@ void UMFileLoggerPrivate::log(const UMEvent& event)
                     << "CPU" << dimColon << event.process.cpuUsage << "% "
                     << "VSZ" << dimColon << event.process.vszMemory << "kB "
                     << "RSS" << dimColon << event.process.rssMemory << "kB "
-                    << "Threads" << dimColon << event.process.threadCount
+                    << "PSS" << dimColon << event.process.pssMemory << "kB "
+                    << "USS" << dimColon << event.process.ussMemory << "kB "
+                    << "Threads" << dimColon << event.process.threadCount << ' '
+                    << "Faults" << dimColon << event.process.minorFaults << '/'
+                    << event.process.majorFaults << ' '
+                    << "Switches" << dimColon << event.process.voluntaryContextSwitches << '/'
+                    << event.process.involuntaryContextSwitches << ' '
+                    << "IO" << dimColon << (event.process.ioReadBytes >> 10) << '/'
+                    << (event.process.ioWriteBytes >> 10) << "kB "
+                    << "Wait" << dimColon << event.process.schedulingWaitTime * 0.000001f << "ms"
                     << '\n' << flush;
             }
             break;
@@ -236,14 +254,17 @@ bool UMFileLogger::parsable()
 UMLTTNGPlugin* UMLTTNGLogger::m_plugin = nullptr;
 bool UMLTTNGLogger::m_error = false;
 
-UMLTTNGLogger::UMLTTNGLogger()
+UMLTTNGPlugin* umLTTNGPlugin()
 {
     // The LTTng tracepoints are dlopen'd so that we don't directly link to
     // liblttng-ust which spawns two threads when the lib is loaded. That allows
     // to avoid the cost of it at startup when the user doesn't use LTTng (as
     // well as not showing them in the metrics).
 
-    if (!m_error && !m_plugin) {
+    static UMLTTNGPlugin* plugin = nullptr;
+    static bool error = false;
+
+    if (!error && !plugin) {
         // Ensure the plugin is first loaded from the build path to ease
         // development on the toolkit from uninstalled sources.
         // FIXME(loicm) Security concerns?
@@ -252,16 +273,25 @@ UMLTTNGLogger::UMLTTNGLogger()
             handle = dlopen(LTTNG_PLUGIN_INSTALL_PATH, RTLD_LAZY);
             if (!handle) {
                 WARN("ApplicationMonitor: %s", dlerror());
-                m_error = true;
-                return;
+                error = true;
+                return nullptr;
             }
         }
-        m_plugin = static_cast<UMLTTNGPlugin*>(dlsym(handle, "umLttngPlugin"));
-        if (!m_plugin) {
+        plugin = static_cast<UMLTTNGPlugin*>(dlsym(handle, "umLttngPlugin"));
+        if (!plugin) {
             WARN("ApplicationMonitor: %s", dlerror());
-            m_error = true;
+            error = true;
         }
     }
+    return plugin;
+}
+
+UMLTTNGLogger::UMLTTNGLogger()
+{
+    if (!m_error && !m_plugin) {
+        m_plugin = umLTTNGPlugin();
+        m_error = !m_plugin;
+    }
 }
 
 void UMLTTNGLogger::log(const UMEvent& event)
@@ -274,7 +304,16 @@ void UMLTTNGLogger::log(const UMEvent& event)
                 .vszMemory = event.process.vszMemory,
                 .rssMemory = event.process.rssMemory,
                 .cpuUsage = event.process.cpuUsage,
-                .threadCount = event.process.threadCount
+                .threadCount = event.process.threadCount,
+                .pssMemory = event.process.pssMemory,
+                .ussMemory = event.process.ussMemory,
+                .voluntaryContextSwitches = event.process.voluntaryContextSwitches,
+                .involuntaryContextSwitches = event.process.involuntaryContextSwitches,
+                .majorFaults = event.process.majorFaults,
+                .minorFaults = event.process.minorFaults,
+                .ioReadBytes = event.process.ioReadBytes,
+                .ioWriteBytes = event.process.ioWriteBytes,
+                .schedulingWaitTime = event.process.schedulingWaitTime
             };
             m_plugin->logProcessEvent(&processEvent);
             break;
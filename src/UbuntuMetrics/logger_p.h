@@ -45,4 +45,12 @@ public:
     quint8 m_flags;
 };
 
+#if defined(Q_OS_LINUX)
+
+// Get the LTTng tracepoints plugin, loading it on the first call. Returns
+// nullptr if it can't be loaded.
+UMLTTNGPlugin* umLTTNGPlugin();
+
+#endif  // defined(Q_OS_LINUX)
+
 #endif  // LOGGER_P_H
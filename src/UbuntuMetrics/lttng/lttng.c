@@ -38,9 +38,21 @@ static void logGenericEvent(UMLTTNGGenericEvent* event)
     tracepoint(UbuntuMetrics, generic, event);
 }
 
+static void logSpanBeginEvent(UMLTTNGSpanEvent* event)
+{
+    tracepoint(UbuntuMetrics, span_begin, event);
+}
+
+static void logSpanEndEvent(UMLTTNGSpanEvent* event)
+{
+    tracepoint(UbuntuMetrics, span_end, event);
+}
+
 const struct UMLTTNGPlugin umLttngPlugin = {
     &logProcessEvent,
     &logFrameEvent,
     &logWindowEvent,
     &logGenericEvent,
+    &logSpanBeginEvent,
+    &logSpanEndEvent,
 };
@@ -25,12 +25,15 @@ typedef struct _UMLTTNGProcessEvent UMLTTNGProcessEvent;
 typedef struct _UMLTTNGFrameEvent UMLTTNGFrameEvent;
 typedef struct _UMLTTNGWindowEvent UMLTTNGWindowEvent;
 typedef struct _UMLTTNGGenericEvent UMLTTNGGenericEvent;
+typedef struct _UMLTTNGSpanEvent UMLTTNGSpanEvent;
 
 struct UMLTTNGPlugin {
     void (*logProcessEvent)(UMLTTNGProcessEvent*);
     void (*logFrameEvent)(UMLTTNGFrameEvent*);
     void (*logWindowEvent)(UMLTTNGWindowEvent*);
     void (*logGenericEvent)(UMLTTNGGenericEvent*);
+    void (*logSpanBeginEvent)(UMLTTNGSpanEvent*);
+    void (*logSpanEndEvent)(UMLTTNGSpanEvent*);
 };
 
 struct _UMLTTNGProcessEvent {
@@ -38,6 +41,15 @@ struct _UMLTTNGProcessEvent {
     uint32_t rssMemory;
     uint16_t cpuUsage;
     uint16_t threadCount;
+    uint32_t pssMemory;
+    uint32_t ussMemory;
+    uint32_t voluntaryContextSwitches;
+    uint32_t involuntaryContextSwitches;
+    uint32_t majorFaults;
+    uint64_t minorFaults;
+    uint64_t ioReadBytes;
+    uint64_t ioWriteBytes;
+    uint64_t schedulingWaitTime;
 };
 
 struct _UMLTTNGFrameEvent {
@@ -65,4 +77,8 @@ struct _UMLTTNGGenericEvent {
     char string[64];
 };
 
+struct _UMLTTNGSpanEvent {
+    const char* name;
+};
+
 #endif  // LTTNG_P_H
@@ -36,6 +36,16 @@ TRACEPOINT_EVENT(
         ctf_integer(uint32_t, vsz_memory, processEvent->vszMemory)
         ctf_integer(uint32_t, rss_memory, processEvent->rssMemory)
         ctf_integer(uint16_t, thread_count, processEvent->threadCount)
+        ctf_integer(uint32_t, pss_memory, processEvent->pssMemory)
+        ctf_integer(uint32_t, uss_memory, processEvent->ussMemory)
+        ctf_integer(uint64_t, minor_faults, processEvent->minorFaults)
+        ctf_integer(uint32_t, major_faults, processEvent->majorFaults)
+        ctf_integer(uint32_t, voluntary_context_switches, processEvent->voluntaryContextSwitches)
+        ctf_integer(uint32_t, involuntary_context_switches,
+                    processEvent->involuntaryContextSwitches)
+        ctf_integer(uint64_t, io_read_bytes, processEvent->ioReadBytes)
+        ctf_integer(uint64_t, io_write_bytes, processEvent->ioWriteBytes)
+        ctf_integer(uint64_t, scheduling_wait_time, processEvent->schedulingWaitTime)
     )
 )
 
@@ -79,5 +89,25 @@ TRACEPOINT_EVENT(
     )
 )
 
+TRACEPOINT_EVENT(
+    UbuntuMetrics, span_begin,
+    TP_ARGS(
+        UMLTTNGSpanEvent*, spanEvent
+    ),
+    TP_FIELDS(
+        ctf_string(name, spanEvent->name)
+    )
+)
+
+TRACEPOINT_EVENT(
+    UbuntuMetrics, span_end,
+    TP_ARGS(
+        UMLTTNGSpanEvent*, spanEvent
+    ),
+    TP_FIELDS(
+        ctf_string(name, spanEvent->name)
+    )
+)
+
 #endif  // TRACEPOINTS_P_H
 #include <lttng/tracepoint-event.h>
@@ -51,22 +51,32 @@ static const struct {
     quint16 defaultWidth;
     UMEvent::Type type;
 } metricInfo[] = {
-    { "cpuUsage",    sizeof("cpuUsage") - 1,    3, UMEvent::Process },
-    { "threadCount", sizeof("threadCount") - 1, 3, UMEvent::Process },
-    { "vszMemory",   sizeof("vszMemory") - 1,   8, UMEvent::Process },
-    { "rssMemory",   sizeof("rssMemory") - 1,   8, UMEvent::Process },
-    { "windowId",    sizeof("windowId") - 1,    2, UMEvent::Window  },
-    { "windowSize",  sizeof("windowSize") - 1,  9, UMEvent::Window  },
-    { "frameNumber", sizeof("frameNumber") - 1, 7, UMEvent::Frame   },
-    { "deltaTime",   sizeof("deltaTime") - 1,   7, UMEvent::Frame   },
-    { "syncTime",    sizeof("syncTime") - 1,    7, UMEvent::Frame   },
-    { "renderTime",  sizeof("renderTime") - 1,  7, UMEvent::Frame   },
-    { "gpuTime",     sizeof("gpuTime") - 1,     7, UMEvent::Frame   },
-    { "totalTime",   sizeof("totalTime") - 1,   7, UMEvent::Frame   }
+    { "cpuUsage",            sizeof("cpuUsage") - 1,            3, UMEvent::Process },
+    { "threadCount",         sizeof("threadCount") - 1,         3, UMEvent::Process },
+    { "vszMemory",           sizeof("vszMemory") - 1,           8, UMEvent::Process },
+    { "rssMemory",           sizeof("rssMemory") - 1,           8, UMEvent::Process },
+    { "pssMemory",           sizeof("pssMemory") - 1,           8, UMEvent::Process },
+    { "ussMemory",           sizeof("ussMemory") - 1,           8, UMEvent::Process },
+    { "minorFaults",         sizeof("minorFaults") - 1,         8, UMEvent::Process },
+    { "majorFaults",         sizeof("majorFaults") - 1,         6, UMEvent::Process },
+    { "voluntarySwitches",   sizeof("voluntarySwitches") - 1,   8, UMEvent::Process },
+    { "involuntarySwitches", sizeof("involuntarySwitches") - 1, 8, UMEvent::Process },
+    { "ioRead",              sizeof("ioRead") - 1,              8, UMEvent::Process },
+    { "ioWrite",             sizeof("ioWrite") - 1,             8, UMEvent::Process },
+    { "waitTime",            sizeof("waitTime") - 1,            9, UMEvent::Process },
+    { "windowId",            sizeof("windowId") - 1,            2, UMEvent::Window  },
+    { "windowSize",          sizeof("windowSize") - 1,          9, UMEvent::Window  },
+    { "frameNumber",         sizeof("frameNumber") - 1,         7, UMEvent::Frame   },
+    { "deltaTime",           sizeof("deltaTime") - 1,           7, UMEvent::Frame   },
+    { "syncTime",            sizeof("syncTime") - 1,            7, UMEvent::Frame   },
+    { "renderTime",          sizeof("renderTime") - 1,          7, UMEvent::Frame   },
+    { "gpuTime",             sizeof("gpuTime") - 1,             7, UMEvent::Frame   },
+    { "totalTime",           sizeof("totalTime") - 1,           7, UMEvent::Frame   }
 };
 enum {
-    CpuUsage = 0, ThreadCount, VszMemory, RssMemory, WindowId, WindowSize, FrameNumber, DeltaTime,
-    SyncTime, RenderTime, GpuTime, TotalTime, MetricCount
+    CpuUsage = 0, ThreadCount, VszMemory, RssMemory, PssMemory, UssMemory, MinorFaults,
+    MajorFaults, VoluntarySwitches, InvoluntarySwitches, IoRead, IoWrite, WaitTime, WindowId,
+    WindowSize, FrameNumber, DeltaTime, SyncTime, RenderTime, GpuTime, TotalTime, MetricCount
 };
 Q_STATIC_ASSERT(ARRAY_SIZE(metricInfo) == MetricCount);
 
@@ -343,6 +353,34 @@ void Overlay::updateProcessMetrics()
         case RssMemory:
             integerMetricToText(m_processEvent.process.rssMemory, text, textWidth);
             break;
+        case PssMemory:
+            integerMetricToText(m_processEvent.process.pssMemory, text, textWidth);
+            break;
+        case UssMemory:
+            integerMetricToText(m_processEvent.process.ussMemory, text, textWidth);
+            break;
+        case MinorFaults:
+            integerMetricToText(m_processEvent.process.minorFaults, text, textWidth);
+            break;
+        case MajorFaults:
+            integerMetricToText(m_processEvent.process.majorFaults, text, textWidth);
+            break;
+        case VoluntarySwitches:
+            integerMetricToText(m_processEvent.process.voluntaryContextSwitches, text, textWidth);
+            break;
+        case InvoluntarySwitches:
+            integerMetricToText(
+                m_processEvent.process.involuntaryContextSwitches, text, textWidth);
+            break;
+        case IoRead:
+            integerMetricToText(m_processEvent.process.ioReadBytes >> 10, text, textWidth);
+            break;
+        case IoWrite:
+            integerMetricToText(m_processEvent.process.ioWriteBytes >> 10, text, textWidth);
+            break;
+        case WaitTime:
+            timeMetricToText(m_processEvent.process.schedulingWaitTime, text, textWidth);
+            break;
         default:
             DNOT_REACHED();
             break;
@@ -0,0 +1,114 @@
+// Copyright © 2017 Canonical Ltd.
+//
+// This file is part of Ubuntu UI Toolkit.
+//
+// Ubuntu UI Toolkit is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; version 3.
+//
+// Ubuntu UI Toolkit is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Ubuntu UI Toolkit. If not, see <http://www.gnu.org/licenses/>.
+
+#include "tracing_p.h"
+
+#include <QtCore/QAtomicInteger>
+
+#include "events.h"
+#include "logger_p.h"
+#if defined(Q_OS_LINUX)
+#include "lttng/lttng_p.h"
+#endif  // defined(Q_OS_LINUX)
+
+Q_STATIC_ASSERT(IS_POWER_OF_TWO(UMTracing::memorySpanCount));
+
+#if defined(Q_OS_LINUX)
+static UMLTTNGPlugin* lttngPlugin = nullptr;
+#endif  // defined(Q_OS_LINUX)
+
+// Ring buffer of the memory backend. The index is incremented atomically so
+// that spans can be logged from different threads.
+static UMTracing::Span spanRing[UMTracing::memorySpanCount];
+static QAtomicInteger<quint32> spanRingIndex(0);
+
+static UMTracing::Backend initialBackend()
+{
+    const QByteArray tracing = qgetenv("UM_TRACING");
+    if (tracing == "lttng") {
+#if defined(Q_OS_LINUX)
+        lttngPlugin = umLTTNGPlugin();
+        if (lttngPlugin) {
+            return UMTracing::LTTNGBackend;
+        }
+#endif  // defined(Q_OS_LINUX)
+        return UMTracing::MemoryBackend;
+    } else if (tracing == "memory") {
+        return UMTracing::MemoryBackend;
+    }
+    return UMTracing::NoBackend;
+}
+
+UMTracing::Backend UMTracing::m_backend = initialBackend();
+
+// static.
+void UMTracing::setBackend(Backend backend)
+{
+    if (backend == LTTNGBackend) {
+#if defined(Q_OS_LINUX)
+        lttngPlugin = umLTTNGPlugin();
+        if (!lttngPlugin) {
+            backend = MemoryBackend;
+        }
+#else
+        backend = MemoryBackend;
+#endif  // defined(Q_OS_LINUX)
+    }
+    m_backend = backend;
+}
+
+// static.
+void UMTracing::logSpan(const char* name, bool begin)
+{
+    DASSERT(name);
+
+#if defined(Q_OS_LINUX)
+    if (m_backend == LTTNGBackend) {
+        UMLTTNGSpanEvent spanEvent = { .name = name };
+        if (begin) {
+            lttngPlugin->logSpanBeginEvent(&spanEvent);
+        } else {
+            lttngPlugin->logSpanEndEvent(&spanEvent);
+        }
+        return;
+    }
+#endif  // defined(Q_OS_LINUX)
+
+    const quint32 index = spanRingIndex.fetchAndAddRelaxed(1) & (memorySpanCount - 1);
+    spanRing[index].name = name;
+    spanRing[index].timeStamp = UMEventUtils::timeStamp();
+    spanRing[index].begin = begin;
+}
+
+// static.
+int UMTracing::memorySpans(Span* spans, int maxCount)
+{
+    DASSERT(spans);
+
+    const quint32 end = spanRingIndex.loadAcquire();
+    const quint32 count = qMin(qMin(end, static_cast<quint32>(memorySpanCount)),
+                               static_cast<quint32>(qMax(maxCount, 0)));
+    for (quint32 i = 0; i < count; ++i) {
+        spans[i] = spanRing[(end - count + i) & (memorySpanCount - 1)];
+    }
+    return static_cast<int>(count);
+}
+
+// static.
+void UMTracing::clearMemorySpans()
+{
+    spanRingIndex.storeRelease(0);
+}
@@ -0,0 +1,81 @@
+// Copyright © 2017 Canonical Ltd.
+//
+// This file is part of Ubuntu UI Toolkit.
+//
+// Ubuntu UI Toolkit is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; version 3.
+//
+// Ubuntu UI Toolkit is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Ubuntu UI Toolkit. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TRACING_P_H
+#define TRACING_P_H
+
+#include <UbuntuMetrics/private/ubuntumetricsglobal_p.h>
+
+// Spans marking the beginning and the end of the startup phases. Spans are
+// named with static strings and can be nested. The backend is set with the
+// UM_TRACING environment variable, "lttng" emits the UbuntuMetrics:span_begin
+// and UbuntuMetrics:span_end tracepoints and "memory" stores the spans in a
+// ring buffer (LTTng is not required, useful for tests). Spans are dropped at
+// the cost of a branch when there's no backend.
+class UBUNTU_METRICS_PRIVATE_EXPORT UMTracing
+{
+public:
+    enum Backend { NoBackend, LTTNGBackend, MemoryBackend };
+
+    struct Span {
+        const char* name;
+        quint64 timeStamp;
+        bool begin;
+    };
+
+    // Number of spans kept by the memory backend.
+    static const int memorySpanCount = 512;
+
+    // Get or set the backend. Setting the LTTng backend falls back to the
+    // memory backend if the tracepoints plugin can't be loaded.
+    static Backend backend() { return m_backend; }
+    static void setBackend(Backend backend);
+
+    static void beginSpan(const char* name) {
+        if (Q_UNLIKELY(m_backend != NoBackend)) {
+            logSpan(name, true);
+        }
+    }
+    static void endSpan(const char* name) {
+        if (Q_UNLIKELY(m_backend != NoBackend)) {
+            logSpan(name, false);
+        }
+    }
+
+    // Copy the last spans (up to maxCount) stored by the memory backend, oldest
+    // first, and return the number of spans copied.
+    static int memorySpans(Span* spans, int maxCount);
+    static void clearMemorySpans();
+
+private:
+    static void logSpan(const char* name, bool begin);
+
+    static Backend m_backend;
+};
+
+// Span covering the lifetime of the object.
+class UMTracingSpan
+{
+public:
+    explicit UMTracingSpan(const char* name) : m_name(name) { UMTracing::beginSpan(name); }
+    ~UMTracingSpan() { UMTracing::endSpan(m_name); }
+
+private:
+    Q_DISABLE_COPY(UMTracingSpan)
+    const char* const m_name;
+};
+
+#endif  // TRACING_P_H
@@ -1,6 +1,6 @@
 TARGET = UbuntuToolkit
 QT = core-private gui-private qml-private quick-private testlib dbus svg organizer \
-     UbuntuGestures-private UbuntuMetrics
+     UbuntuGestures-private UbuntuMetrics UbuntuMetrics-private
 
 #Qt SystemInfo
 QT *= systeminfo systeminfo-private
@@ -29,6 +29,7 @@ HEADERS += \
     $$PWD/asyncloader_p.h \
     $$PWD/asyncloader_p_p.h \
     $$PWD/colorutils_p.h \
+    $$PWD/componentcache_p.h \
     $$PWD/exclusivegroup_p.h \
     $$PWD/filterbehavior_p.h \
     $$PWD/i18n_p.h \
@@ -61,6 +62,7 @@ HEADERS += \
     $$PWD/qquickclipboard_p_p.h \
     $$PWD/qquickmimedata_p.h \
     $$PWD/quickutils_p.h \
+    $$PWD/relativedatetimeformatter_p.h \
     $$PWD/sortbehavior_p.h \
     $$PWD/sortfiltermodel_p.h \
     $$PWD/splitview_p.h \
@@ -145,6 +147,7 @@ SOURCES += \
     $$PWD/alarmmanager_p.cpp \
     $$PWD/asyncloader.cpp \
     $$PWD/colorutils.cpp \
+    $$PWD/componentcache.cpp \
     $$PWD/exclusivegroup.cpp \
     $$PWD/filterbehavior.cpp \
     $$PWD/i18n.cpp \
@@ -172,6 +175,7 @@ SOURCES += \
     $$PWD/qquickclipboard.cpp \
     $$PWD/qquickmimedata.cpp \
     $$PWD/quickutils.cpp \
+    $$PWD/relativedatetimeformatter.cpp \
     $$PWD/sortbehavior.cpp \
     $$PWD/sortfiltermodel.cpp \
     $$PWD/splitview.cpp \
@@ -32,6 +32,11 @@
 #include "ucalarm_p_p.h"
 
 static const QString alarmDatabase = QStringLiteral("%1/alarms.json");
+// append-only log of the changes made since the database was last written
+static const QString alarmJournal = QStringLiteral("%1/alarms.journal");
+// the journal is compacted into the database when it grows beyond this many
+// records or the number of alarms, whichever is bigger
+static const int journalCompactionLimit = 1000;
 
 // The main alarm manager engine used from Saucy onwards is EDS (Evolution Data
 // Server) based. Any previous release uses the generic "memory" manager engine
@@ -388,6 +393,10 @@ AlarmsAdapter::AlarmsAdapter(AlarmManager *qq)
     : QObject(qq)
     , AlarmManagerPrivate(qq)
     , manager(0)
+    , fileWrites(0)
+    , managerRequests(0)
+    , nextStorageKey(0)
+    , journalRecords(0)
 {
     // register QOrganizerItemId comparators so QVariant == operator can compare them
     QMetaType::registerComparators<QOrganizerItemId>();
@@ -425,9 +434,37 @@ AlarmsAdapter::AlarmsAdapter(AlarmManager *qq)
     }
 }
 
+// serializes the alarm into a storage record
+static QJsonObject alarmRecord(const UCAlarm *alarm, int key)
+{
+    QJsonObject object;
+    object[QStringLiteral("key")] = key;
+    object[QStringLiteral("message")] = alarm->message();
+    object[QStringLiteral("date")] = alarm->date().toString();
+    object[QStringLiteral("sound")] = alarm->sound().toString();
+    object[QStringLiteral("type")] = QJsonValue(alarm->type());
+    object[QStringLiteral("days")] = QJsonValue((int)alarm->daysOfWeek());
+    object[QStringLiteral("enabled")] = QJsonValue(alarm->enabled());
+    return object;
+}
+
 void AlarmsAdapter::alarmOperation(QList<QPair<QOrganizerItemId,QOrganizerManager::Operation> > list)
 {
     typedef QPair<QOrganizerItemId,QOrganizerManager::Operation> OperationPair;
+    const bool journal = (manager->managerName() == alarmManagerFallback);
+
+    // fetch the events of the batch in one go; they are kept until the next
+    // batch or fetch, so verifying the batch needs no further round-trips
+    QList<QOrganizerItemId> ids;
+    Q_FOREACH(const OperationPair &op, list) {
+        if (op.second != QOrganizerManager::Remove) {
+            ids << op.first;
+        }
+    }
+    cacheTodoItems(ids);
+
+    QByteArray records;
+    int recordCount = 0;
     Q_FOREACH(const OperationPair &op, list) {
         switch (op.second) {
         case QOrganizerManager::Add: {
@@ -440,12 +477,31 @@ void AlarmsAdapter::alarmOperation(QList<QPair<QOrganizerItemId,QOrganizerManage
         }
         case QOrganizerManager::Remove: {
             removeAlarm(op.first);
-            // save alarm data
             break;
         }
         }
+        if (!journal) {
+            continue;
+        }
+        // log the alarm data
+        if (op.second == QOrganizerManager::Remove) {
+            if (storageKeys.contains(op.first)) {
+                QJsonObject object;
+                object[QStringLiteral("key")] = storageKeys.take(op.first);
+                object[QStringLiteral("removed")] = true;
+                records += QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n';
+                recordCount++;
+            }
+        } else {
+            QOrganizerItemId id = todoItem(op.first).id();
+            const UCAlarm *alarm = alarmList.find(id);
+            if (alarm) {
+                records += QJsonDocument(alarmRecord(alarm, storageKey(id))).toJson(QJsonDocument::Compact) + '\n';
+                recordCount++;
+            }
+        }
     }
-    saveAlarms();
+    journalAlarms(records, recordCount);
 }
 
 void AlarmsAdapter::init()
@@ -469,21 +525,60 @@ UCAlarmPrivate * AlarmsAdapter::createAlarmData(UCAlarm *alarm)
     return new AlarmDataAdapter(alarm);
 }
 
+// reads the fallback manager data, the database with the journal replayed on it
+QMap<int, QJsonObject> AlarmsAdapter::storedAlarms(int *journalRecords) const
+{
+    QMap<int, QJsonObject> alarms;
+    QString location = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    QFile file(alarmDatabase.arg(location));
+    if (file.open(QFile::ReadOnly)) {
+        QJsonDocument document(QJsonDocument::fromJson(file.readAll()));
+        QJsonArray array = document.array();
+        for (int i = 0; i < array.size(); i++) {
+            QJsonObject object = array[i].toObject();
+            // databases written before the journal was introduced have no keys,
+            // negative keys cannot clash with the ones logged
+            int key = object.contains(QStringLiteral("key")) ? object[QStringLiteral("key")].toInt() : -(i + 1);
+            alarms.insert(key, object);
+        }
+        file.close();
+    }
+
+    int records = 0;
+    QFile journal(alarmJournal.arg(location));
+    if (journal.open(QFile::ReadOnly)) {
+        while (!journal.atEnd()) {
+            QJsonObject object = QJsonDocument::fromJson(journal.readLine()).object();
+            // skip incomplete records
+            if (!object.contains(QStringLiteral("key"))) {
+                continue;
+            }
+            records++;
+            int key = object[QStringLiteral("key")].toInt();
+            if (object[QStringLiteral("removed")].toBool()) {
+                alarms.remove(key);
+            } else {
+                alarms.insert(key, object);
+            }
+        }
+        journal.close();
+    }
+    if (journalRecords) {
+        *journalRecords = records;
+    }
+    return alarms;
+}
+
 // load fallback manager data
 void AlarmsAdapter::loadAlarms()
 {
     if (manager->managerName() != alarmManagerFallback) {
         return;
     }
-    QFile file(alarmDatabase.arg(QStandardPaths::writableLocation(QStandardPaths::DataLocation)));
-    if (!file.open(QFile::ReadOnly)) {
-        return;
-    }
-    QByteArray data = file.readAll();
-    QJsonDocument document(QJsonDocument::fromJson(data));
-    QJsonArray array = document.array();
-    for (int i = 0; i < array.size(); i++) {
-        QJsonObject object = array[i].toObject();
+    QMap<int, QJsonObject> alarms = storedAlarms(&journalRecords);
+    QMap<int, QJsonObject>::const_iterator i;
+    for (i = alarms.constBegin(); i != alarms.constEnd(); ++i) {
+        const QJsonObject &object = i.value();
 
         // use UCAlarm to save store JSON data
         UCAlarm alarm;
@@ -499,42 +594,87 @@ void AlarmsAdapter::loadAlarms()
         // call checkAlarm to complete field checks (i.e. type vs daysOfWeek, kick date, etc)
         pAlarm->checkAlarm();
         QOrganizerTodo event = pAlarm->data();
-        manager->saveItem(&event);
+        if (manager->saveItem(&event)) {
+            storageKeys.insert(event.id(), i.key());
+        }
+        nextStorageKey = qMax(nextStorageKey, i.key() + 1);
     }
-    file.close();
 }
 
-// save fallback manager data only
-void AlarmsAdapter::saveAlarms()
+// returns the storage key of the alarm, allocating one if needed
+int AlarmsAdapter::storageKey(const QOrganizerItemId &id)
 {
-    if (manager->managerName() != alarmManagerFallback) {
-        return;
+    QHash<QOrganizerItemId, int>::const_iterator i = storageKeys.constFind(id);
+    if (i != storageKeys.constEnd()) {
+        return i.value();
     }
+    storageKeys.insert(id, nextStorageKey);
+    return nextStorageKey++;
+}
+
+bool AlarmsAdapter::writeStorage(const QString &path, const QByteArray &data, QIODevice::OpenMode mode)
+{
     QDir dir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
     if (!dir.exists()) {
-        dir.mkpath(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
+        dir.mkpath(dir.path());
     }
-    QFile file(alarmDatabase.arg(dir.path()));
-    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+    QFile file(path.arg(dir.path()));
+    if (!file.open(mode)) {
+        return false;
+    }
+    fileWrites++;
+    bool result = (file.write(data) == data.size());
+    file.close();
+    return result;
+}
+
+// appends the records to the journal, compacting it when grown too big
+void AlarmsAdapter::journalAlarms(const QByteArray &records, int count)
+{
+    if (!count) {
+        return;
+    }
+    journalRecords += count;
+    if (journalRecords > qMax(journalCompactionLimit, alarmList.count())) {
+        saveAlarms();
+        return;
+    }
+    // terminate a record torn by an interrupted write, so that it does not
+    // swallow the first one appended
+    QByteArray data(records);
+    QFile journal(alarmJournal.arg(QStandardPaths::writableLocation(QStandardPaths::DataLocation)));
+    if (journal.size() > 0 && journal.open(QFile::ReadOnly)) {
+        char last = '\n';
+        if (journal.seek(journal.size() - 1)) {
+            journal.getChar(&last);
+        }
+        journal.close();
+        if (last != '\n') {
+            data.prepend('\n');
+        }
+    }
+    if (!writeStorage(alarmJournal, data, QFile::WriteOnly | QFile::Append)) {
+        // journal not writable, try the database
+        saveAlarms();
+    }
+}
+
+// save fallback manager data only; writes the database and drops the journal
+void AlarmsAdapter::saveAlarms()
+{
+    if (manager->managerName() != alarmManagerFallback) {
         return;
     }
     QJsonArray data;
     for(int i = 0; i < alarmList.count(); i++) {
-        // create an UCAlarm and set its event to ease conversions
         const UCAlarm *alarm = alarmList[i];
-        QJsonObject object;
-        object[QStringLiteral("message")] = alarm->message();
-        object[QStringLiteral("date")] = alarm->date().toString();
-        object[QStringLiteral("sound")] = alarm->sound().toString();
-        object[QStringLiteral("type")] = QJsonValue(alarm->type());
-        object[QStringLiteral("days")] = QJsonValue((int)alarm->daysOfWeek());
-        object[QStringLiteral("enabled")] = QJsonValue(alarm->enabled());
-        data.append(object);
-
+        data.append(alarmRecord(alarm, storageKey(alarm->cookie().value<QOrganizerItemId>())));
     }
     QJsonDocument document(data);
-    file.write(document.toJson());
-    file.close();
+    if (writeStorage(alarmDatabase, document.toJson(), QFile::WriteOnly | QFile::Truncate)) {
+        QFile::remove(alarmJournal.arg(QStandardPaths::writableLocation(QStandardPaths::DataLocation)));
+        journalRecords = 0;
+    }
 }
 
 /*-----------------------------------------------------------------------------
@@ -552,7 +692,12 @@ bool AlarmsAdapter::verifyChange(UCAlarm *alarm, AlarmManager::Change change, co
 {
     AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(alarm));
     QOrganizerItemId id = pAlarm->data().id();
-    QOrganizerTodo todo = static_cast<QOrganizerTodo>(manager->item(id));
+    // the event is most likely part of the last operation batch
+    QOrganizerTodo todo = todoCache.value(id);
+    if (todo.isEmpty()) {
+        managerRequests++;
+        todo = static_cast<QOrganizerTodo>(manager->item(id));
+    }
     if (todo.isEmpty()) {
         return false;
     }
@@ -643,7 +788,9 @@ bool AlarmsAdapter::fetchAlarms()
                          this, &AlarmsAdapter::completeFetchAlarms);
     }
 
+    todoCache.clear();
     Q_EMIT q_ptr->alarmsRefreshStarted();
+    managerRequests++;
     return fetchRequest->start();
 }
 
@@ -661,7 +808,11 @@ UCAlarm *AlarmsAdapter::getAlarmAt(int index) const
 bool AlarmsAdapter::findAlarm(const UCAlarm &alarm, const QVariant &cookie) const
 {
     QOrganizerItemId id = cookie.value<QOrganizerItemId>();
-    QOrganizerItem item = manager->item(id);
+    QOrganizerItem item = todoCache.value(id);
+    if (item.isEmpty() || item.id() != id) {
+        managerRequests++;
+        item = manager->item(id);
+    }
     if (item.type() == QOrganizerItemType::TypeTodo) {
         AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
         pAlarm->setData(static_cast<QOrganizerTodo>(item));
@@ -675,10 +826,16 @@ QOrganizerTodo AlarmsAdapter::todoItem(const QOrganizerItemId &id)
 {
     QOrganizerTodo event;
     if (!id.isNull()) {
+        QHash<QOrganizerItemId, QOrganizerTodo>::const_iterator cached = todoCache.constFind(id);
+        if (cached != todoCache.constEnd()) {
+            return cached.value();
+        }
+        managerRequests++;
         const QOrganizerItem item = manager->item(id);
         if (item.type() == QOrganizerItemType::TypeTodoOccurrence) {
             QOrganizerTodoOccurrence occurrence = static_cast<QOrganizerTodoOccurrence>(item);
             QOrganizerItemId eventId = occurrence.parentId();
+            managerRequests++;
             event = static_cast<QOrganizerTodo>(manager->item(eventId));
         } else if (item.type() == QOrganizerItemType::TypeTodo){
             event = static_cast<QOrganizerTodo>(item);
@@ -687,6 +844,42 @@ QOrganizerTodo AlarmsAdapter::todoItem(const QOrganizerItemId &id)
     return event;
 }
 
+// replaces the cached events with the ones of the given item ids, resolving
+// occurrences to their parent events; uses at most two manager round-trips
+void AlarmsAdapter::cacheTodoItems(const QList<QOrganizerItemId> &ids)
+{
+    todoCache.clear();
+    if (ids.isEmpty()) {
+        return;
+    }
+    managerRequests++;
+    QList<QOrganizerItem> items = manager->items(ids);
+    QMultiHash<QOrganizerItemId, QOrganizerItemId> occurrences;
+    Q_FOREACH(const QOrganizerItem &item, items) {
+        if (item.type() == QOrganizerItemType::TypeTodoOccurrence) {
+            QOrganizerTodoOccurrence occurrence = static_cast<QOrganizerTodoOccurrence>(item);
+            occurrences.insert(occurrence.parentId(), occurrence.id());
+        } else if (item.type() == QOrganizerItemType::TypeTodo) {
+            todoCache.insert(item.id(), static_cast<QOrganizerTodo>(item));
+        }
+    }
+    if (occurrences.isEmpty()) {
+        return;
+    }
+    managerRequests++;
+    items = manager->items(occurrences.uniqueKeys());
+    Q_FOREACH(const QOrganizerItem &item, items) {
+        if (item.type() != QOrganizerItemType::TypeTodo) {
+            continue;
+        }
+        QOrganizerTodo event = static_cast<QOrganizerTodo>(item);
+        todoCache.insert(event.id(), event);
+        Q_FOREACH(const QOrganizerItemId &occurrenceId, occurrences.values(event.id())) {
+            todoCache.insert(occurrenceId, event);
+        }
+    }
+}
+
 void AlarmsAdapter::insertAlarm(const QOrganizerItemId &id)
 {
     QOrganizerTodo event = todoItem(id);
@@ -773,6 +966,7 @@ void AlarmsAdapter::completeFetchAlarms()
                 continue;
             }
             parentId << eventId;
+            managerRequests++;
             event = static_cast<QOrganizerTodo>(manager->item(eventId));
         } else if (item.type() == QOrganizerItemType::TypeTodo){
             event = static_cast<QOrganizerTodo>(item);
@@ -812,6 +1006,7 @@ void AlarmsAdapter::adjustAlarmOccurrence(AlarmDataAdapter &alarm)
         endDate = startDate.addDays(8);
     }
 
+    managerRequests++;
     QList<QOrganizerItem> occurrences = manager->itemOccurrences(alarm.data(), startDate, endDate, 10);
     // get the first occurrence and use the date from it
     if ((occurrences.length() > 0) && (occurrences[0].type() == QOrganizerItemType::TypeTodoOccurrence)) {
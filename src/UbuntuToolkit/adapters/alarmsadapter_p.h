@@ -19,6 +19,10 @@
 #ifndef ALARMSADAPTER_P_H
 #define ALARMSADAPTER_P_H
 
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QVector>
 #include <QtOrganizer/QOrganizerManager>
 #include <QtOrganizer/QOrganizerAbstractRequest>
 #include <QtOrganizer/QOrganizerItemFetchRequest>
@@ -28,6 +32,8 @@
 #include <UbuntuToolkit/private/ucalarm_p_p.h>
 #include <UbuntuToolkit/private/alarmmanager_p_p.h>
 
+#include <algorithm>
+
 QTORGANIZER_USE_NAMESPACE
 
 UT_NAMESPACE_BEGIN
@@ -93,7 +99,9 @@ public:
 
     void clear()
     {
-        qDeleteAll(data);
+        Q_FOREACH(const Entry &entry, data) {
+            delete entry.alarm;
+        }
         data.clear();
         idHash.clear();
     }
@@ -103,8 +111,12 @@ public:
     }
     const UCAlarm *operator[](int index) const
     {
-        QPair<QDateTime, QOrganizerItemId> key = data.keys()[index];
-        return data.value(key);
+        return data[index].alarm;
+    }
+    // returns the alarm registered with the event id, null if there is none
+    const UCAlarm *find(const QOrganizerItemId &id) const
+    {
+        return idHash.value(id).alarm;
     }
     // update event at index, returns the new event index
     int update(int index, const UCAlarm &alarm)
@@ -115,29 +127,24 @@ public:
         AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(AlarmDataAdapter::get(oldAlarm));
         pAlarm->copyAlarmData(alarm);
         // and insert it back
-        QDateTime dt = oldAlarm->date();
-        QOrganizerItemId id = oldAlarm->cookie().value<QOrganizerItemId>();
-        idHash.insert(id, dt);
-        data.insert(QPair<QDateTime, QOrganizerItemId>(dt, id), oldAlarm);
-        return indexOf(id);
+        return insert(oldAlarm);
     }
     // insert an alarm event into the list
     int insert(const UCAlarm &alarm)
     {
-        QDateTime dt = alarm.date();
-        QOrganizerItemId id = alarm.cookie().value<QOrganizerItemId>();
-        idHash.insert(id, dt);
         UCAlarm *newAlarm = new UCAlarm;
         UCAlarmPrivate::get(newAlarm)->copyAlarmData(alarm);
-        data.insert(QPair<QDateTime, QOrganizerItemId>(dt, id), newAlarm);
-        return indexOf(id);
+        return insert(newAlarm);
     }
     // returns the index of the alarm matching the id, -1 on error
-    int indexOf(const QOrganizerItemId &id)
+    int indexOf(const QOrganizerItemId &id) const
     {
-        QDateTime dt = idHash.value(id);
-        QPair<QDateTime, QOrganizerItemId> key(dt, id);
-        return data.keys().indexOf(key);
+        QHash<QOrganizerItemId, Entry>::const_iterator it = idHash.constFind(id);
+        if (it == idHash.constEnd()) {
+            return -1;
+        }
+        QVector<Entry>::const_iterator pos = std::lower_bound(data.constBegin(), data.constEnd(), *it);
+        return (pos != data.constEnd() && pos->id == id) ? int(pos - data.constBegin()) : -1;
     }
     // remove alarm at index
     void removeAt(int index)
@@ -147,20 +154,45 @@ public:
     }
 
 protected:
+    struct Entry {
+        Entry() : alarm(Q_NULLPTR) {}
+        QDateTime date;
+        QOrganizerItemId id;
+        UCAlarm *alarm;
+
+        bool operator<(const Entry &other) const
+        {
+            return date < other.date || (!(other.date < date) && id < other.id);
+        }
+    };
+
+    // inserts an alarm owned by the list, returns its index
+    int insert(UCAlarm *alarm)
+    {
+        Entry entry;
+        entry.date = alarm->date();
+        entry.id = alarm->cookie().value<QOrganizerItemId>();
+        entry.alarm = alarm;
+        idHash.insert(entry.id, entry);
+        QVector<Entry>::iterator pos = std::lower_bound(data.begin(), data.end(), entry);
+        int index = int(pos - data.begin());
+        data.insert(index, entry);
+        return index;
+    }
     // removes alarm data at index and returns the alarm pointer
     UCAlarm *takeAt(int index)
     {
-        QPair<QDateTime, QOrganizerItemId> key = data.keys()[index];
-        UCAlarm *alarm = data.take(key);
-        idHash.remove(key.second);
-        return alarm;
+        Entry entry = data.takeAt(index);
+        idHash.remove(entry.id);
+        return entry.alarm;
     }
 
 private:
-    // ordered map by occurrence date + event id, ascending
-    QMap< QPair<QDateTime, QOrganizerItemId>, UCAlarm*> data;
-    // alarms ordered based on even id
-    QHash<QOrganizerItemId, QDateTime> idHash;
+    // ordered by occurrence date + event id, ascending; the key date is kept
+    // aside as the alarm data may be altered by its users
+    QVector<Entry> data;
+    // alarms by event id (cookie)
+    QHash<QOrganizerItemId, Entry> idHash;
 };
 
 class AlarmsAdapter : public QObject, public AlarmManagerPrivate
@@ -192,6 +224,11 @@ public:
 
     void loadAlarms();
     void saveAlarms();
+    QMap<int, QJsonObject> storedAlarms(int *journalRecords = Q_NULLPTR) const;
+
+    // number of fallback storage writes and organizer manager round-trips
+    int fileWrites;
+    mutable int managerRequests;
 
     bool verifyChange(UCAlarm *alarm, AlarmManager::Change change, const QVariant &value) override;
     UCAlarmPrivate *createAlarmData(UCAlarm *alarm) override;
@@ -208,7 +245,18 @@ private Q_SLOTS:
 protected:
     QPointer<QOrganizerItemFetchRequest> fetchRequest;
     AlarmList alarmList;
+    // todo events of the last operation batch only, by item (or occurrence) id
+    QHash<QOrganizerItemId, QOrganizerTodo> todoCache;
+    // keys identifying the alarms in the fallback storage
+    QHash<QOrganizerItemId, int> storageKeys;
+    int nextStorageKey;
+    int journalRecords;
+
     QOrganizerTodo todoItem(const QOrganizerItemId &id);
+    void cacheTodoItems(const QList<QOrganizerItemId> &ids);
+    int storageKey(const QOrganizerItemId &id);
+    bool writeStorage(const QString &path, const QByteArray &data, QIODevice::OpenMode mode);
+    void journalAlarms(const QByteArray &records, int count);
 };
 
 UT_NAMESPACE_END
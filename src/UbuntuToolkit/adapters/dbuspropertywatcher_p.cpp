@@ -19,6 +19,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusPendingReply>
 #include <QtDBus/QDBusReply>
 #include <QtQml/QQmlInfo>
 
@@ -102,6 +104,16 @@ bool DBusServiceProperties::setupInterface()
     QDBusReply<QDBusObjectPath> dbusObjectPath =
         iface->call(QStringLiteral("FindUserById"), qlonglong(getuid()));
     if (dbusObjectPath.isValid()) {
+        if (!objectPath.isEmpty()) {
+            // the service owner changed, drop the subscription to the old object
+            iface->connection().disconnect(
+                service,
+                objectPath,
+                dbusInterface,
+                QStringLiteral("PropertiesChanged"),
+                this,
+                SLOT(updateProperties(QString,QVariantMap,QStringList)));
+        }
         objectPath = dbusObjectPath.value().path();
         iface->connection().connect(
             service,
@@ -118,12 +130,36 @@ bool DBusServiceProperties::setupInterface()
     return false;
 }
 
+/*
+ * Builds a call on the properties interface of the watched object. Messages are
+ * built directly instead of using a QDBusInterface, which would introspect the
+ * object synchronously each time it is created.
+ */
+QDBusMessage DBusServiceProperties::propertiesCall(const QString &method) const
+{
+    return QDBusMessage::createMethodCall(service, objectPath, dbusInterface, method);
+}
+
+/*
+ * Fetches the values of all properties with a single GetAll call. Further
+ * changes are delivered by the PropertiesChanged signal.
+ */
 bool DBusServiceProperties::fetchPropertyValues()
 {
-    scannedProperties = properties;
-    Q_FOREACH(QString property, properties) {
-        readProperty(property);
+    if (objectPath.isEmpty()) {
+        return false;
+    }
+    Q_Q(UCServiceProperties);
+    QDBusMessage call = propertiesCall(QStringLiteral("GetAll"));
+    call << adaptor;
+    QDBusPendingCall pending = connection.asyncCall(call);
+    if (pending.isError()) {
+        warning(pending.error().message());
+        return false;
     }
+    QDBusPendingCallWatcher *callWatcher = new QDBusPendingCallWatcher(pending, q);
+    QObject::connect(callWatcher, SIGNAL(finished(QDBusPendingCallWatcher*)),
+                     this, SLOT(fetchFinished(QDBusPendingCallWatcher*)));
     return true;
 }
 
@@ -136,15 +172,9 @@ bool DBusServiceProperties::readProperty(const QString &property)
         return false;
     }
     Q_Q(UCServiceProperties);
-    QDBusInterface readIFace(iface->interface(), objectPath, dbusInterface, connection);
-    if (!readIFace.isValid()) {
-        // report invalid interface only if the property's first letter was with capital one!
-        if (property[0].isUpper()) {
-            warning(readIFace.lastError().message());
-        }
-        return false;
-    }
-    QDBusPendingCall pending = readIFace.asyncCall(QStringLiteral("Get"), adaptor, property);
+    QDBusMessage call = propertiesCall(QStringLiteral("Get"));
+    call << adaptor << property;
+    QDBusPendingCall pending = connection.asyncCall(call);
     if (pending.isError()) {
         warning(pending.error().message());
         return false;
@@ -155,6 +185,7 @@ bool DBusServiceProperties::readProperty(const QString &property)
 
     // set a dynamic property so we know which property are we reading
     callWatcher->setProperty(dynamicProperty, property);
+    scannedProperties << property;
     return true;
 }
 
@@ -166,25 +197,67 @@ bool DBusServiceProperties::testProperty(const QString &property, const QVariant
     if (objectPath.isEmpty()) {
         return false;
     }
-    QDBusInterface writeIFace(iface->interface(), objectPath, dbusInterface, connection);
-    if (!writeIFace.isValid()) {
-        // invalid interface
-        return false;
-    }
-    QDBusMessage msg = writeIFace.call(
-        QStringLiteral("Set"), adaptor, property, QVariant::fromValue(QDBusVariant(value)));
+    QDBusMessage call = propertiesCall(QStringLiteral("Set"));
+    call << adaptor << property << QVariant::fromValue(QDBusVariant(value));
+    QDBusMessage msg = connection.call(call);
     return msg.type() == QDBusMessage::ReplyMessage;
 }
 
+/*
+ * Updates a watched property value, making sure the property name starts with
+ * lower case.
+ */
+void DBusServiceProperties::updateProperty(QString property, const QVariant &value)
+{
+    Q_Q(UCServiceProperties);
+    property[0] = property[0].toLower();
+    q->setProperty(property.toLocal8Bit().constData(), value);
+}
+
+/*
+ * Slot called when the GetAll call issued by fetchPropertyValues() finishes.
+ */
+void DBusServiceProperties::fetchFinished(QDBusPendingCallWatcher *call)
+{
+    QDBusPendingReply<QVariantMap> reply = *call;
+    if (reply.isError()) {
+        // none of the properties can be read
+        properties.clear();
+        warning(reply.error().message());
+    } else {
+        const QVariantMap values = reply.value();
+        Q_FOREACH(const QString &property, properties) {
+            QVariantMap::const_iterator value = values.constFind(property);
+            if (value != values.constEnd()) {
+                updateProperty(property, *value);
+                continue;
+            }
+            // remove the property from being watched, as it has no property like that
+            properties.removeAll(property);
+            if (property[0].isUpper()) {
+                // report error!
+                warning(QStringLiteral("No such property '%1'").arg(property));
+            }
+        }
+    }
+
+    if ((status == UCServiceProperties::Synchronizing) && scannedProperties.isEmpty()) {
+        // set status to active
+        setStatus(UCServiceProperties::Active);
+    }
+
+    // delete watcher
+    call->deleteLater();
+}
+
 /*
  * Slot called when the async read operation finishes.
  */
 void DBusServiceProperties::readFinished(QDBusPendingCallWatcher *call)
 {
-    Q_Q(UCServiceProperties);
     QDBusPendingReply<QVariant> reply = *call;
     QString property = call->property(dynamicProperty).toString();
-    scannedProperties.removeAll(property);
+    scannedProperties.removeOne(property);
     if (reply.isError()) {
         // remove the property from being watched, as it has no property like that
         properties.removeAll(property);
@@ -194,9 +267,7 @@ void DBusServiceProperties::readFinished(QDBusPendingCallWatcher *call)
         }
     } else {
         // update watched property value
-        // make sure we have lower case when the property value is updated
-        property[0] = property[0].toLower();
-        q->setProperty(property.toLocal8Bit().constData(), reply.value());
+        updateProperty(property, reply.value());
     }
 
     if ((status == UCServiceProperties::Synchronizing) && scannedProperties.isEmpty()) {
@@ -226,10 +297,19 @@ void DBusServiceProperties::changeServiceOwner(const QString &serviceName, const
  */
 void DBusServiceProperties::updateProperties(const QString &onInterface, const QVariantMap &map, const QStringList &invalidated)
 {
-    Q_UNUSED(onInterface);
-    Q_UNUSED(map);
+    if (!adaptor.isEmpty() && (onInterface != adaptor)) {
+        return;
+    }
+    // changed values are carried by the signal, only invalidated ones need to be read
+    for (QVariantMap::const_iterator i = map.constBegin(); i != map.constEnd(); ++i) {
+        if (properties.contains(i.key())) {
+            updateProperty(i.key(), i.value());
+        }
+    }
     Q_FOREACH(const QString &property, invalidated) {
-        readProperty(property);
+        if (properties.contains(property)) {
+            readProperty(property);
+        }
     }
 }
 
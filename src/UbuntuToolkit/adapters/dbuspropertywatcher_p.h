@@ -48,8 +48,11 @@ public:
     QString objectPath;
 
     bool setupInterface();
+    QDBusMessage propertiesCall(const QString &method) const;
+    void updateProperty(QString property, const QVariant &value);
 
 public Q_SLOTS:
+    void fetchFinished(QDBusPendingCallWatcher *watcher);
     void readFinished(QDBusPendingCallWatcher *watcher);
     void changeServiceOwner(const QString &serviceName, const QString &oldOwner, const QString &newOwner);
     void updateProperties(const QString &iface, const QVariantMap &map, const QStringList &invalidated);
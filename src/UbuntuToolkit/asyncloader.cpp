@@ -17,6 +17,7 @@
  */
 
 #include "asyncloader_p_p.h"
+#include "componentcache_p.h"
 
 #include <QtQml/QQmlContext>
 #include <QtQml/QQmlComponent>
@@ -32,6 +33,8 @@ AsyncLoader::AsyncLoader(QObject *parent)
 AsyncLoader::~AsyncLoader()
 {
     reset();
+    // the component may be shared, make sure we don't get its signals anymore
+    d_func()->detachComponent();
 }
 
 // incubator methods
@@ -93,7 +96,7 @@ void AsyncLoaderPrivate::detachComponent()
     }
     componentHandler.reset();
     if (ownComponent) {
-        component->deleteLater();
+        ComponentCache::forEngine(component->engine())->release(component);
     }
     component = nullptr;
     ownComponent = false;
@@ -120,7 +123,8 @@ void AsyncLoaderPrivate::onComponentStatusChanged(QQmlComponent::Status status)
  * \param context
  * \return bool
  * The method initiates the loading of a given \e url within a specific \e context.
- * Returns true on success.
+ * The component is taken from the engine's ComponentCache, so documents loaded
+ * earlier are not compiled again. Returns true on success.
  * \note If the loading is initiated while there is a previous loading in place,
  * you must make sure you delete the object from the previous loading before you
  * trigger the new load.
@@ -136,7 +140,8 @@ bool AsyncLoader::load(const QUrl &url, QQmlContext *context)
         return false;
     }
     d->ownComponent = true;
-    return load(new QQmlComponent(context->engine(), url, QQmlComponent::Asynchronous), context);
+    QQmlComponent *component = ComponentCache::forEngine(context->engine())->acquire(url, QQmlComponent::Asynchronous);
+    return load(component, context);
 }
 
 /*!
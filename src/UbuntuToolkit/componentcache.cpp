@@ -0,0 +1,237 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "componentcache_p.h"
+
+#include <QtCore/QFileInfo>
+#include <QtQml/QQmlEngine>
+#include <QtQml/private/qqmlfile_p.h>
+
+UT_NAMESPACE_BEGIN
+
+// default cost limit of the idle components, in kilobytes of QML source
+const int defaultCostLimit = 1024;
+
+/*!
+ * \internal
+ * \class ComponentCache
+ * The ComponentCache holds the components created from URLs by the toolkit's
+ * dynamic loaders (AsyncLoader, PageWrapper, BottomEdge), so repeated loads of
+ * the same document reuse the compiled component instead of creating a new one.
+ * There is one cache per QML engine.
+ *
+ * Components are reference counted. A component returned by acquire() must be
+ * handed back to release() once the caller no longer needs it. Released
+ * components are kept alive until the total cost of the unused components
+ * exceeds costLimit(), in which case the least recently released ones are
+ * destroyed. Components which failed to compile are never cached.
+ */
+ComponentCache::ComponentCache(QQmlEngine *engine)
+    : QObject(engine)
+    , m_engine(engine)
+    , m_costLimit(defaultCostLimit)
+{
+}
+
+/*!
+ * \internal
+ * Returns the component cache of the given \e engine. The cache is created
+ * on first use and is destroyed together with the engine.
+ */
+ComponentCache *ComponentCache::forEngine(QQmlEngine *engine)
+{
+    if (!engine) {
+        return nullptr;
+    }
+    ComponentCache *cache = engine->findChild<ComponentCache*>(QString(), Qt::FindDirectChildrenOnly);
+    if (!cache) {
+        cache = new ComponentCache(engine);
+    }
+    return cache;
+}
+
+int ComponentCache::estimateCost(const QUrl &url)
+{
+    // the real size of a compiled component cannot be queried, use the size
+    // of the document as an estimate
+    QString path = QQmlFile::urlToLocalFileOrQrc(url);
+    qint64 size = path.isEmpty() ? 0 : QFileInfo(path).size();
+    return qMax<int>(1, size / 1024);
+}
+
+QQmlComponent *ComponentCache::lookup(const QUrl &url, QQmlComponent::CompilationMode mode, bool acquire)
+{
+    auto it = m_entries.find(url);
+    if (it != m_entries.end() && it->component->isError()) {
+        // failed components are never reused, give the document another chance
+        if (it->refCount == 0) {
+            m_idle.removeOne(url);
+            m_idleCost -= it->cost;
+            m_urls.remove(it->component);
+            it->component->deleteLater();
+            m_entries.erase(it);
+        } else {
+            // still used by someone, detach it from the cache
+            m_urls.remove(it->component);
+            m_entries.erase(it);
+        }
+        it = m_entries.end();
+    }
+
+    if (it != m_entries.end() && acquire && mode != QQmlComponent::Asynchronous
+            && it->component->isLoading()) {
+        // the document is still being loaded for an asynchronous user or by
+        // precompile(); a synchronous component makes the engine complete the
+        // loading right away
+        QQmlComponent *component = new QQmlComponent(m_engine, url, mode, this);
+        if (it->refCount > 0) {
+            // shared with asynchronous users, the caller gets its own
+            // component, deleted on release()
+            m_misses++;
+            return component;
+        }
+        // only precompiled so far, replace it
+        m_hits++;
+        m_idle.removeOne(url);
+        m_idleCost -= it->cost;
+        m_urls.remove(it->component);
+        it->component->deleteLater();
+        it->component = component;
+        it->refCount = 1;
+        m_urls.insert(component, url);
+        return component;
+    }
+
+    if (it != m_entries.end()) {
+        if (acquire) {
+            m_hits++;
+            if (it->refCount++ == 0) {
+                m_idle.removeOne(url);
+                m_idleCost -= it->cost;
+            }
+        }
+        return it->component;
+    }
+
+    Entry entry;
+    entry.component = new QQmlComponent(m_engine, url, mode, this);
+    entry.cost = estimateCost(url);
+    if (acquire) {
+        m_misses++;
+        entry.refCount = 1;
+    } else {
+        m_idle.append(url);
+        m_idleCost += entry.cost;
+    }
+    m_entries.insert(url, entry);
+    m_urls.insert(entry.component, url);
+    trim(m_costLimit);
+    return entry.component;
+}
+
+/*!
+ * \internal
+ * Returns the component for the given \e url, creating it with the given
+ * compilation \e mode if it is not yet cached. The returned component may
+ * still be loading, unless a synchronous \e mode was asked for and the document
+ * can be loaded synchronously. The caller must call release() when done with it.
+ */
+QQmlComponent *ComponentCache::acquire(const QUrl &url, QQmlComponent::CompilationMode mode)
+{
+    if (url.isEmpty() || !url.isValid()) {
+        return nullptr;
+    }
+    return lookup(url, mode, true);
+}
+
+/*!
+ * \internal
+ * Releases a \e component acquired earlier. Components not created by the
+ * cache, or those detached from it because of errors, are deleted.
+ */
+void ComponentCache::release(QQmlComponent *component)
+{
+    if (!component) {
+        return;
+    }
+    auto urlIt = m_urls.constFind(component);
+    if (urlIt == m_urls.constEnd()) {
+        component->deleteLater();
+        return;
+    }
+    const QUrl url = *urlIt;
+    auto it = m_entries.find(url);
+    Q_ASSERT(it != m_entries.end() && it->refCount > 0);
+    if (--it->refCount > 0) {
+        return;
+    }
+    if (component->isError()) {
+        m_urls.remove(component);
+        m_entries.erase(it);
+        component->deleteLater();
+        return;
+    }
+    m_idle.append(url);
+    m_idleCost += it->cost;
+    trim(m_costLimit);
+}
+
+/*!
+ * \internal
+ * Starts compiling the document at \e url asynchronously without creating any
+ * object from it, so a later acquire() finds it ready. Typically used from
+ * the idle phase of the application startup. Does not affect the statistics.
+ */
+void ComponentCache::precompile(const QUrl &url)
+{
+    if (url.isEmpty() || !url.isValid()) {
+        return;
+    }
+    lookup(url, QQmlComponent::Asynchronous, false);
+}
+
+/*!
+ * \internal
+ * Destroys all the unused components.
+ */
+void ComponentCache::clear()
+{
+    trim(0);
+}
+
+/*!
+ * \internal
+ * Sets the limit for the cost of the unused components in kilobytes.
+ */
+void ComponentCache::setCostLimit(int kilobytes)
+{
+    m_costLimit = qMax(0, kilobytes);
+    trim(m_costLimit);
+}
+
+void ComponentCache::trim(int limit)
+{
+    while (m_idleCost > limit && !m_idle.isEmpty()) {
+        const QUrl url = m_idle.takeFirst();
+        Entry entry = m_entries.take(url);
+        m_idleCost -= entry.cost;
+        m_urls.remove(entry.component);
+        // may be called from within a status change of the component
+        entry.component->deleteLater();
+    }
+}
+
+UT_NAMESPACE_END
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPONENTCACHE_P_H
+#define COMPONENTCACHE_P_H
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtQml/QQmlComponent>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+class QQmlEngine;
+
+UT_NAMESPACE_BEGIN
+
+class UBUNTUTOOLKIT_EXPORT ComponentCache : public QObject
+{
+    Q_OBJECT
+public:
+    static ComponentCache *forEngine(QQmlEngine *engine);
+
+    QQmlComponent *acquire(const QUrl &url,
+                           QQmlComponent::CompilationMode mode = QQmlComponent::Asynchronous);
+    void release(QQmlComponent *component);
+    void precompile(const QUrl &url);
+    void clear();
+
+    int costLimit() const
+    {
+        return m_costLimit;
+    }
+    void setCostLimit(int kilobytes);
+    int totalCost() const
+    {
+        return m_idleCost;
+    }
+    int count() const
+    {
+        return m_entries.count();
+    }
+
+    int hits() const
+    {
+        return m_hits;
+    }
+    int misses() const
+    {
+        return m_misses;
+    }
+    void resetStatistics()
+    {
+        m_hits = m_misses = 0;
+    }
+
+private:
+    struct Entry {
+        QQmlComponent *component = nullptr;
+        int refCount = 0;
+        int cost = 1;
+    };
+
+    explicit ComponentCache(QQmlEngine *engine);
+
+    QQmlComponent *lookup(const QUrl &url, QQmlComponent::CompilationMode mode, bool acquire);
+    void trim(int limit);
+    static int estimateCost(const QUrl &url);
+
+    QQmlEngine *m_engine;
+    QHash<QUrl, Entry> m_entries;
+    QHash<QQmlComponent*, QUrl> m_urls;
+    // least recently released components come first
+    QList<QUrl> m_idle;
+    int m_idleCost = 0;
+    int m_costLimit;
+    int m_hits = 0;
+    int m_misses = 0;
+};
+
+UT_NAMESPACE_END
+
+#endif // COMPONENTCACHE_P_H
@@ -28,8 +28,6 @@ namespace C {
 
 #include <QtCore/QDir>
 
-#include "timeutils_p.h"
-
 UT_NAMESPACE_BEGIN
 /*!
  * \qmltype i18n
@@ -57,7 +55,9 @@ UT_NAMESPACE_BEGIN
  */
 UbuntuI18n *UbuntuI18n::m_i18 = nullptr;
 
-UbuntuI18n::UbuntuI18n(QObject* parent) : QObject(parent)
+UbuntuI18n::UbuntuI18n(QObject* parent)
+    : QObject(parent)
+    , m_relativeDateTimeFormatter(this)
 {
     /*
      * setlocale
@@ -69,6 +69,10 @@ UbuntuI18n::UbuntuI18n(QObject* parent) : QObject(parent)
      *   defines the order of multiple locales
      */
     m_language = QString::fromLocal8Bit(setlocale(LC_ALL, ""));
+
+    // the cached translations depend on both
+    connect(this, &UbuntuI18n::languageChanged, this, &UbuntuI18n::clearTranslations);
+    connect(this, &UbuntuI18n::domainChanged, this, &UbuntuI18n::clearTranslations);
 }
 
 UbuntuI18n::~UbuntuI18n()
@@ -156,13 +160,57 @@ void UbuntuI18n::setLanguage(const QString &lang) {
     Q_EMIT languageChanged();
 }
 
+/*
+ * Translations are cached until the language or the text domain changes, so
+ * bindings re-evaluated while creating delegates do not go through the UTF-8
+ * conversions and the catalog lookup every time. gettext does not expose the
+ * plural form chosen for n, so plural translations are cached per n.
+ */
+QString UbuntuI18n::translate(const TranslationKey &key)
+{
+    // keep the cache bounded for texts with many different n values
+    static const int maxTranslations = 4096;
+
+    auto it = m_translations.constFind(key);
+    if (it != m_translations.constEnd()) {
+        return *it;
+    }
+
+    QByteArray domain = key.domain.toUtf8();
+    const char *domainName = key.currentDomain ? NULL : domain.constData();
+    QString translation;
+    switch (key.kind) {
+    case TranslationKey::Singular:
+        translation = QString::fromUtf8(C::dgettext(domainName, key.text.toUtf8()));
+        break;
+    case TranslationKey::Plural:
+        translation = QString::fromUtf8(C::dngettext(domainName, key.text.toUtf8(), key.extra.toUtf8(), key.n));
+        break;
+    case TranslationKey::Context:
+        translation = QString::fromUtf8(C::g_dpgettext2(domainName, key.extra.toUtf8(), key.text.toUtf8()));
+        break;
+    }
+
+    if (m_translations.size() >= maxTranslations) {
+        m_translations.clear();
+    }
+    m_translations.insert(key, translation);
+    return translation;
+}
+
+void UbuntuI18n::clearTranslations()
+{
+    m_translations.clear();
+    m_relativeDateTimeFormatter.invalidate();
+}
+
 /*!
  * \qmlmethod string i18n::tr(string text)
  * Translate \a text using gettext and return the translation.
  */
 QString UbuntuI18n::tr(const QString& text)
 {
-    return QString::fromUtf8(C::gettext(text.toUtf8()));
+    return translate({TranslationKey::Singular, true, QString(), QString(), text, 0});
 }
 
 /*!
@@ -175,7 +223,7 @@ QString UbuntuI18n::tr(const QString& text)
  */
 QString UbuntuI18n::tr(const QString &singular, const QString &plural, int n)
 {
-    return QString::fromUtf8(C::ngettext(singular.toUtf8(), plural.toUtf8(), n));
+    return translate({TranslationKey::Plural, true, QString(), plural, singular, n});
 }
 
 /*!
@@ -184,11 +232,7 @@ QString UbuntuI18n::tr(const QString &singular, const QString &plural, int n)
  */
 QString UbuntuI18n::dtr(const QString& domain, const QString& text)
 {
-    if (domain.isNull()) {
-        return QString::fromUtf8(C::dgettext(NULL, text.toUtf8()));
-    } else {
-        return QString::fromUtf8(C::dgettext(domain.toUtf8(), text.toUtf8()));
-    }
+    return translate({TranslationKey::Singular, domain.isNull(), domain, QString(), text, 0});
 }
 
 /*!
@@ -200,11 +244,7 @@ QString UbuntuI18n::dtr(const QString& domain, const QString& text)
  */
 QString UbuntuI18n::dtr(const QString& domain, const QString& singular, const QString& plural, int n)
 {
-    if (domain.isNull()) {
-        return QString::fromUtf8(C::dngettext(NULL, singular.toUtf8(), plural.toUtf8(), n));
-    } else {
-        return QString::fromUtf8(C::dngettext(domain.toUtf8(), singular.toUtf8(), plural.toUtf8(), n));
-    }
+    return translate({TranslationKey::Plural, domain.isNull(), domain, plural, singular, n});
 }
 
 /*!
@@ -224,11 +264,7 @@ QString UbuntuI18n::ctr(const QString& context, const QString& text)
  */
 QString UbuntuI18n::dctr(const QString& domain, const QString& context, const QString& text)
 {
-    if (domain.isNull()) {
-        return QString::fromUtf8(C::g_dpgettext2(NULL, context.toUtf8(), text.toUtf8()));
-    } else {
-        return QString::fromUtf8(C::g_dpgettext2(domain.toUtf8(), context.toUtf8(), text.toUtf8()));
-    }
+    return translate({TranslationKey::Context, domain.isNull(), domain, context, text, 0});
 }
 
 /*!
@@ -275,91 +311,17 @@ QString UbuntuI18n::tag(const QString& context, const QString& text)
  */
 QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
 {
-    static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
-
-    QDateTime relativeTo(QDateTime::currentDateTime());
-    const date_proximity_t prox = getDateProximity(relativeTo, datetime);
-
-    switch (prox)  {
-        case DATE_PROXIMITY_NOW:
-            /* TRANSLATORS: Time based "this is happening/happened now" */
-            return dtr(ubuntuUiToolkit, QStringLiteral("Now"));
-
-        case DATE_PROXIMITY_HOUR:
-        {
-            qint64 diff = datetime.toMSecsSinceEpoch() - relativeTo.toMSecsSinceEpoch();
-            qint64 minutes = qRound(float(diff) / 60000);
-            if (minutes < 0) {
-                return dtr(ubuntuUiToolkit, QStringLiteral("%1 minute ago"),
-                           QStringLiteral("%1 minutes ago"), qAbs(minutes)).arg(qAbs(minutes));
-            }
-            return dtr(ubuntuUiToolkit, QStringLiteral("%1 minute"),
-                       QStringLiteral("%1 minutes"), minutes).arg(minutes);
-        }
-
-        case DATE_PROXIMITY_TODAY:
-            /* en_US example: "1:00 PM" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("HH:mm")));
-
-        case DATE_PROXIMITY_YESTERDAY:
-            /* en_US example: "Yesterday  13:00" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'HH:mm")));
-
-        case DATE_PROXIMITY_TOMORROW:
-            /* en_US example: "Tomorrow  1:00 PM" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'HH:mm")));
-
-        case DATE_PROXIMITY_LAST_WEEK:
-        case DATE_PROXIMITY_NEXT_WEEK:
-            /* en_US example: "Fri  1:00 PM" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'HH:mm")));
-
-        case DATE_PROXIMITY_FAR_BACK:
-        case DATE_PROXIMITY_FAR_FORWARD:
-        default:
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'HH:mm")));
-    }
-    return datetime.toString(Qt::DefaultLocaleShortDate);
+    return m_relativeDateTimeFormatter.format(datetime);
+}
+
+/*!
+ * \internal
+ * Translates all \a datetimes relative to the same current time. Cheaper than
+ * calling relativeDateTime() for each of them.
+ */
+QStringList UbuntuI18n::relativeDateTimes(const QList<QDateTime>& datetimes)
+{
+    return m_relativeDateTimeFormatter.format(datetimes);
 }
 
 UT_NAMESPACE_END
@@ -19,9 +19,11 @@
 #ifndef I18N_P_H
 #define I18N_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
+#include <UbuntuToolkit/private/relativedatetimeformatter_p.h>
 
 class QQmlContext;
 class QQmlEngine;
@@ -60,6 +62,7 @@ public:
     Q_INVOKABLE QString tag(const QString& text);
     Q_INVOKABLE QString tag(const QString& context, const QString& text);
     Q_INVOKABLE QString relativeDateTime(const QDateTime& datetime);
+    QStringList relativeDateTimes(const QList<QDateTime>& datetimes);
 
     // getter
     QString domain() const;
@@ -74,9 +77,36 @@ Q_SIGNALS:
     void languageChanged();
 
 private:
+    struct TranslationKey {
+        enum Kind { Singular, Plural, Context };
+        Kind kind;
+        // use the current text domain instead of domain
+        bool currentDomain;
+        QString domain;
+        // the context for Context, the plural form for Plural
+        QString extra;
+        QString text;
+        int n;
+
+        bool operator==(const TranslationKey &other) const
+        {
+            return kind == other.kind && currentDomain == other.currentDomain && n == other.n
+                    && text == other.text && extra == other.extra && domain == other.domain;
+        }
+        friend uint qHash(const TranslationKey &key, uint seed = 0)
+        {
+            return qHash(key.text, seed) ^ qHash(key.extra, seed) ^ qHash(key.domain, seed)
+                    ^ uint(key.n) ^ (uint(key.kind) << 28) ^ (uint(key.currentDomain) << 31);
+        }
+    };
+    QString translate(const TranslationKey &key);
+    void clearTranslations();
+
     static UbuntuI18n *m_i18;
     QString m_domain;
     QString m_language;
+    QHash<TranslationKey, QString> m_translations;
+    RelativeDateTimeFormatter m_relativeDateTimeFormatter;
 };
 
 UT_NAMESPACE_END
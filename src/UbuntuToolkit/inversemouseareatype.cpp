@@ -232,7 +232,10 @@ InverseMouseAreaType::InverseMouseAreaType(QQuickItem *parent) :
     QQuickMouseArea(parent),
     m_ready(false),
     m_topmostItem(false),
-    m_sensingArea(QuickUtils::instance()->rootItem(this))
+    m_filteredEvent(false),
+    m_sensingSceneRectValid(false),
+    m_sensingArea(QuickUtils::instance()->rootItem(this)),
+    m_touchId(-1)
 {
     /*
      * QQuickMouseArea overrides enabledChanged() signal, therefore we must make sure
@@ -287,6 +290,7 @@ void InverseMouseAreaType::update()
     // update sensing area
     if (!m_sensingArea) {
         m_sensingArea = QuickUtils::instance()->rootItem(this);
+        invalidateSensingSceneRect();
     }
     updateEventFilter(isEnabled() && isVisible() && m_topmostItem);
     QQuickMouseArea::update();
@@ -319,169 +323,239 @@ void InverseMouseAreaType::componentComplete()
 }
 
 /*
- * Translate mouse, wheel and hover event positions to component's local coordinates.
+ * Returns the bounding rectangle of the sensing area in scene coordinates. The
+ * rectangle is cached until the geometry of the sensing area or any of its
+ * ascendants changes.
  */
-QEvent *InverseMouseAreaType::mapEventToArea(QObject *target, QEvent *event, QPoint &point)
+QRectF InverseMouseAreaType::sensingSceneRect()
 {
-    QQuickItem *targetItem = qobject_cast<QQuickItem*>(target);
+    if (m_sensingSceneRectValid) {
+        return m_sensingSceneRect;
+    }
+    m_sensingSceneRect = QRectF();
+    if (m_sensingArea) {
+        m_sensingSceneRect = m_sensingArea->mapRectToScene(
+                    QRectF(0, 0, m_sensingArea->width(), m_sensingArea->height()));
+        for (QQuickItem *item = m_sensingArea; item; item = item->parentItem()) {
+            m_sensingAreaConnections
+                << connect(item, &QQuickItem::xChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QQuickItem::yChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QQuickItem::widthChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QQuickItem::heightChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QQuickItem::scaleChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QQuickItem::rotationChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QQuickItem::parentChanged, this, &InverseMouseAreaType::invalidateSensingSceneRect)
+                << connect(item, &QObject::destroyed, this, &InverseMouseAreaType::invalidateSensingSceneRect);
+        }
+    }
+    m_sensingSceneRectValid = true;
+    return m_sensingSceneRect;
+}
+
+void InverseMouseAreaType::invalidateSensingSceneRect()
+{
+    m_sensingSceneRectValid = false;
+    Q_FOREACH(const QMetaObject::Connection &connection, m_sensingAreaConnections) {
+        disconnect(connection);
+    }
+    m_sensingAreaConnections.clear();
+}
+
+void InverseMouseAreaType::dispatchMouseEvent(QMouseEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+        mousePressEvent(event);
+        break;
+    case QEvent::MouseButtonRelease:
+        mouseReleaseEvent(event);
+        break;
+    case QEvent::MouseButtonDblClick:
+        mouseDoubleClickEvent(event);
+        break;
+    case QEvent::MouseMove:
+        mouseMoveEvent(event);
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Translate mouse event positions to component's local coordinates. The mapped
+ * event lives on the stack, so filtering does not allocate.
+ */
+bool InverseMouseAreaType::filterMouseEvent(QQuickItem *target, QMouseEvent *event, QPoint &point)
+{
+    if (target == this) {
+        dispatchMouseEvent(event);
+        return true;
+    }
+    QMouseEvent mev(event->type(),
+                    mapFromScene(event->windowPos()),
+                    event->windowPos(),
+                    event->screenPos(),
+                    event->button(), event->buttons(), event->modifiers());
+    dispatchMouseEvent(&mev);
+    event->setAccepted(mev.isAccepted());
+    point = mev.pos();
+    return true;
+}
+
+// convert touch events into mouse events and continue handling as such
+bool InverseMouseAreaType::filterTouchEvent(QQuickItem *target, QTouchEvent *event, QPoint &point)
+{
+    const QList<QTouchEvent::TouchPoint> &points = event->touchPoints();
+    const QTouchEvent::TouchPoint *touchPoint = Q_NULLPTR;
+    QEvent::Type type;
+    Qt::MouseButton button = Qt::LeftButton;
+    switch (event->type()) {
+    case QEvent::TouchBegin:
+        touchPoint = &points.first();
+        m_touchId = touchPoint->id();
+        type = QEvent::MouseButtonPress;
+        break;
+    case QEvent::TouchUpdate:
+        touchPoint = &points.first();
+        type = QEvent::MouseMove;
+        button = Qt::NoButton;
+        break;
+    default:
+        for (int i = 0; i < points.count(); i++) {
+            if (points.at(i).id() == m_touchId) {
+                touchPoint = &points.at(i);
+                break;
+            }
+        }
+        type = QEvent::MouseButtonRelease;
+        break;
+    }
+    if (!touchPoint) {
+        return false;
+    }
+
+    QPointF pos = target->mapToScene(touchPoint->pos());
+    QMouseEvent mev(type,
+                    mapFromScene(pos),
+                    touchPoint->scenePos(),
+                    touchPoint->screenPos(),
+                    button, button, Qt::NoModifier);
+    dispatchMouseEvent(&mev);
+    event->setAccepted(mev.isAccepted());
+    point = mev.pos();
+    return true;
+}
+
+bool InverseMouseAreaType::eventFilter(QObject *object, QEvent *event)
+{
+    if (object == this) {
+        return false;
+    }
+
+    // reject the presses outside of the sensing area before mapping them, those
+    // are never taken; moves are always filtered, as the area grabs them even
+    // when not pressed
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonDblClick:
+        if (!pressed() && !sensingSceneRect().contains(static_cast<QMouseEvent*>(event)->windowPos())) {
+            return false;
+        }
+        break;
+    case QEvent::TouchBegin: {
+        const QList<QTouchEvent::TouchPoint> &points = static_cast<QTouchEvent*>(event)->touchPoints();
+        if (points.isEmpty() || (!pressed() && !sensingSceneRect().contains(points.first().scenePos()))) {
+            return false;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    QQuickItem *targetItem = qobject_cast<QQuickItem*>(object);
     // target can be the QQuickView or QQuickWindow, then we need to get the root item from it
     if (!targetItem) {
-        QQuickView *view = qobject_cast<QQuickView*>(target);
+        QQuickView *view = qobject_cast<QQuickView*>(object);
         if (view) {
             targetItem = view->rootObject();
         } else {
-            QQuickWindow *window = qobject_cast<QQuickWindow*>(target);
+            QQuickWindow *window = qobject_cast<QQuickWindow*>(object);
             if (window) {
                 targetItem = window->contentItem();
             }
         }
     }
-    Q_ASSERT(target);
-    m_filteredEvent = true;
 
+    bool captured = false;
+    QPoint point;
+    m_filteredEvent = true;
     switch (event->type()) {
     case QEvent::MouseButtonPress:
     case QEvent::MouseButtonRelease:
     case QEvent::MouseButtonDblClick:
     case QEvent::MouseMove:
-        if (targetItem != this) {
-            // translate coordinates to local
-            QMouseEvent *ev = static_cast<QMouseEvent*>(event);
-            QMouseEvent *mev = new QMouseEvent(ev->type(),
-                                   mapFromScene(ev->windowPos()),
-                                   ev->windowPos(),
-                                   ev->screenPos(),
-                                   ev->button(), ev->buttons(), ev->modifiers());
-            point = mev->pos();
-            return mev;
-        }
+        captured = filterMouseEvent(targetItem, static_cast<QMouseEvent*>(event), point);
         break;
-    case QEvent::Wheel:
-        if (targetItem != this) {
-            QWheelEvent *ev = static_cast<QWheelEvent*>(event);
-            QWheelEvent *wev = new QWheelEvent(mapFromScene(ev->globalPos()), ev->globalPos(),
-                                               ev->delta(), ev->buttons(), ev->modifiers(), ev->orientation());
-            point = wev->pos();
-            return wev;
+    case QEvent::Wheel: {
+        QWheelEvent *ev = static_cast<QWheelEvent*>(event);
+        if (targetItem == this) {
+            wheelEvent(ev);
+        } else {
+            QWheelEvent wev(mapFromScene(ev->globalPos()), ev->globalPos(),
+                            ev->delta(), ev->buttons(), ev->modifiers(), ev->orientation());
+            wheelEvent(&wev);
+            event->setAccepted(wev.isAccepted());
+            point = wev.pos();
         }
+        captured = true;
         break;
+    }
     case QEvent::HoverEnter:
     case QEvent::HoverLeave:
     case QEvent::HoverMove: {
+        auto dispatchHoverEvent = [this](QHoverEvent *event) {
+            switch (event->type()) {
+            case QEvent::HoverEnter:
+                hoverEnterEvent(event);
+                break;
+            case QEvent::HoverLeave:
+                hoverLeaveEvent(event);
+                break;
+            default:
+                hoverMoveEvent(event);
+                break;
+            }
+        };
+        QHoverEvent *ev = static_cast<QHoverEvent*>(event);
         if (targetItem && targetItem != this) {
-            QHoverEvent *ev = static_cast<QHoverEvent*>(event);
-            QPointF spos = targetItem->mapToScene(ev->posF());
-            QPointF sopos = targetItem->mapToScene(ev->oldPosF());
-            QHoverEvent *hev = new QHoverEvent(ev->type(),
-                                               mapFromScene(spos),
-                                               mapFromScene(sopos),
-                                               ev->modifiers());
-            point = hev->pos();
-            return hev;
+            QHoverEvent hev(ev->type(),
+                            mapFromScene(targetItem->mapToScene(ev->posF())),
+                            mapFromScene(targetItem->mapToScene(ev->oldPosF())),
+                            ev->modifiers());
+            dispatchHoverEvent(&hev);
+            event->setAccepted(hev.isAccepted());
+            point = hev.pos();
+        } else {
+            dispatchHoverEvent(ev);
         }
-        } break;
-    // convert touch events into mouse events and continue handling as such
-    case QEvent::TouchBegin: {
-        QTouchEvent *tev = static_cast<QTouchEvent*>(event);
-        QList<QTouchEvent::TouchPoint> points = tev->touchPoints();
-        const QTouchEvent::TouchPoint &primaryPoint = points.first();
-        m_touchId = primaryPoint.id();
-        QPointF pos = targetItem->mapToScene(primaryPoint.pos());
-        QMouseEvent *mev = new QMouseEvent(QEvent::MouseButtonPress,
-                        mapFromScene(pos),
-                        primaryPoint.scenePos(),
-                        primaryPoint.screenPos(),
-                        Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
-        point = mev->pos();
-        return mev;
-        } break;
-    case QEvent::TouchUpdate: {
-        QTouchEvent *tev = static_cast<QTouchEvent*>(event);
-        QList<QTouchEvent::TouchPoint> points = tev->touchPoints();
-        const QTouchEvent::TouchPoint &primaryPoint = points.first();
-        QPointF pos = targetItem->mapToScene(primaryPoint.pos());
-        QMouseEvent *mev = new QMouseEvent(QEvent::MouseMove,
-                        mapFromScene(pos),
-                        primaryPoint.scenePos(),
-                        primaryPoint.screenPos(),
-                        Qt::NoButton, Qt::NoButton, Qt::NoModifier);
-        point = mev->pos();
-        return mev;
-        } break;
-    case QEvent::TouchEnd: {
-        QMouseEvent *mev = 0;
-        QTouchEvent *tev = static_cast<QTouchEvent*>(event);
-        QList<QTouchEvent::TouchPoint> points = tev->touchPoints();
-        for (int i = 0; i < points.count(); i++) {
-            const QTouchEvent::TouchPoint &point = points.at(i);
-            if (point.id() != m_touchId) {
-                continue;
-            }
-            QPointF pos = targetItem->mapToScene(point.pos());
-            mev = new QMouseEvent(QEvent::MouseButtonRelease,
-                            mapFromScene(pos),
-                            point.scenePos(),
-                            point.screenPos(),
-                            Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
-            break;
+        captured = true;
+        break;
+    }
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+        if (targetItem) {
+            captured = filterTouchEvent(targetItem, static_cast<QTouchEvent*>(event), point);
         }
-        point = mev->pos();
-        return mev;
-        } break;
+        break;
     default:
-        m_filteredEvent = false;
-        point = QPoint();
         break;
     }
-    return event;
-}
-
-bool InverseMouseAreaType::eventFilter(QObject *object, QEvent *event)
-{
-    if (object != this)
-    {
-        bool captured = true;
-        QPoint point;
-        QEvent *mappedEvent = mapEventToArea(object, event, point);
-
-        switch (mappedEvent->type()) {
-        case QEvent::MouseButtonPress:
-            mousePressEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::MouseButtonRelease:
-            mouseReleaseEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::MouseButtonDblClick:
-            mouseDoubleClickEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::MouseMove:
-            mouseMoveEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::Wheel:
-            wheelEvent(static_cast<QWheelEvent*>(mappedEvent));
-            break;
-        case QEvent::HoverEnter:
-            hoverEnterEvent(static_cast<QHoverEvent*>(mappedEvent));
-            break;
-        case QEvent::HoverLeave:
-            hoverLeaveEvent(static_cast<QHoverEvent*>(mappedEvent));
-            break;
-        case QEvent::HoverMove:
-            hoverMoveEvent(static_cast<QHoverEvent*>(mappedEvent));
-            break;
-        default:
-            captured = false;
-            break;
-        }
-        if (mappedEvent != event) {
-            event->setAccepted(mappedEvent->isAccepted());
-            delete mappedEvent;
-        }
-        m_filteredEvent = false;
-        if (captured && event->isAccepted() && contains(point)) {
-            // consume the event
-            return true;
-        }
+    m_filteredEvent = false;
+    if (captured && event->isAccepted() && contains(point)) {
+        // consume the event
+        return true;
     }
     return false;
 }
@@ -534,6 +608,7 @@ void InverseMouseAreaType::setSensingArea(QQuickItem *sensing)
         // clear previous filter
         updateEventFilter(false);
         m_sensingArea = sensing;
+        invalidateSensingSceneRect();
         updateEventFilter(m_topmostItem);
         Q_EMIT sensingAreaChanged();
     }
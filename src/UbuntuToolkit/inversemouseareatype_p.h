@@ -52,7 +52,10 @@ private: // getter/setter
     void setSensingArea(QQuickItem *sensing);
     bool topmostItem() const;
     void setTopmostItem(bool value);
-    QEvent * mapEventToArea(QObject *target, QEvent *event, QPoint &point);
+    bool filterMouseEvent(QQuickItem *target, QMouseEvent *event, QPoint &point);
+    bool filterTouchEvent(QQuickItem *target, QTouchEvent *event, QPoint &point);
+    void dispatchMouseEvent(QMouseEvent *event);
+    QRectF sensingSceneRect();
 
 Q_SIGNALS:
     void sensingAreaChanged();
@@ -61,13 +64,18 @@ Q_SIGNALS:
 private Q_SLOTS:
     void update();
     void resetFilterOnWindowUpdate(QQuickWindow *win);
-    
+    void invalidateSensingSceneRect();
+
 private:
     bool m_ready:1;
     bool m_topmostItem:1;
     bool m_filteredEvent:1;
+    bool m_sensingSceneRectValid:1;
     QPointer<QObject> m_filterHost;
     QPointer<QQuickItem> m_sensingArea;
+    // bounding rectangle of the sensing area in scene coordinates
+    QRectF m_sensingSceneRect;
+    QList<QMetaObject::Connection> m_sensingAreaConnections;
     int m_touchId;
 
     void updateEventFilter(bool enable);
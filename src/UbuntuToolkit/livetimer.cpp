@@ -53,6 +53,7 @@ LiveTimer::LiveTimer(QObject *parent)
     , m_frequency(Disabled)
     , m_effectiveFrequency(Disabled)
     , m_lastUpdate(0)
+    , m_suspended(false)
 {
 }
 
@@ -91,11 +92,7 @@ void LiveTimer::setFrequency(LiveTimer::Frequency frequency)
         m_frequency = frequency;
         Q_EMIT frequencyChanged();
 
-        if (m_frequency != Disabled && (m_frequency != Relative || m_relativeTime.isValid())) {
-            registerTimer();
-        } else {
-            unregisterTimer();
-        }
+        updateRegistration();
     }
 }
 
@@ -113,13 +110,70 @@ void LiveTimer::setRelativeTime(const QDateTime &relativeTime)
         Q_EMIT relativeTimeChanged();
 
         if (m_frequency == Relative) {
-            if (m_relativeTime.isValid()) {
-                registerTimer();
-            } else {
-                unregisterTimer();
-            }
+            updateRegistration();
+        }
+    }
+}
+
+/*! \qmlproperty bool LiveTimer::suspended
+    \since Ubuntu.Components 1.3
+
+    When set, the timer stops emitting the \l trigger signal, and does not cost anything
+    on the shared timer. Used to suspend the timers of items which are not on the screen,
+    i.e. by binding it to the visibility of the item. When the timer is resumed, the
+    \l trigger signal is emitted right away if the timer missed an update meanwhile.
+
+    \qml
+    import Ubuntu.Components 1.3
+
+    Label {
+        id: label
+        LiveTimer {
+            frequency: LiveTimer.Second
+            suspended: !label.visible
+            onTrigger: label.text = new Date().toString()
         }
     }
+    \endqml
+*/
+void LiveTimer::setSuspended(bool suspended)
+{
+    if (m_suspended == suspended) {
+        return;
+    }
+    QDateTime suspendedAt(m_suspendedAt);
+    m_suspended = suspended;
+    m_suspendedAt = suspended ? QDateTime::currentDateTime() : QDateTime();
+    Q_EMIT suspendedChanged();
+
+    updateRegistration();
+    Frequency frequency = m_effectiveFrequency;
+    if (suspended || frequency == Disabled || !suspendedAt.isValid()) {
+        return;
+    }
+
+    // catch up with the updates missed
+    QDateTime now(QDateTime::currentDateTime());
+    bool missed = suspendedAt.date() != now.date() ||
+            suspendedAt.time().hour() != now.time().hour();
+    if (!missed && frequency <= Minute) {
+        missed = suspendedAt.time().minute() != now.time().minute();
+    }
+    if (!missed && frequency == Second) {
+        missed = suspendedAt.time().second() != now.time().second();
+    }
+    if (missed) {
+        Q_EMIT trigger();
+    }
+}
+
+void LiveTimer::updateRegistration()
+{
+    if (!m_suspended && m_frequency != Disabled && (m_frequency != Relative || m_relativeTime.isValid())) {
+        registerTimer();
+    } else {
+        unregisterTimer();
+    }
 }
 
 void LiveTimer::registerTimer()
@@ -40,37 +40,69 @@ SharedLiveTimer::SharedLiveTimer(QObject* parent)
 void SharedLiveTimer::registerTimer(LiveTimer *timer)
 {
     if (m_liveTimers.contains(timer)) {
-        unregisterTimer(timer);
+        unschedule(timer);
     }
-    m_liveTimers.append(timer);
+    schedule(timer, QDateTime::currentDateTime());
+
+    LiveTimer::Frequency oldFreq = m_frequency;
     updateFrequency();
+    // the timer may need to wake up earlier to re-evaluate the relative timer
+    qint64 deadline = m_liveTimers.value(timer);
+    if (oldFreq == m_frequency && deadline >= 0
+            && (!m_timer.isActive() || deadline < m_nextUpdate.toMSecsSinceEpoch())) {
+        reInitTimer();
+    }
 }
 
 void SharedLiveTimer::unregisterTimer(LiveTimer *timer)
 {
     if (!m_liveTimers.contains(timer)) return;
 
-    m_liveTimers.removeAll(timer);
+    unschedule(timer);
     updateFrequency();
 }
 
+/*
+ * Puts the timer into the bucket of its effective frequency. Relative timers are
+ * also queued by the time their proximity, thus their frequency changes, so only
+ * those need to be re-evaluated on timeout.
+ */
+void SharedLiveTimer::schedule(LiveTimer *timer, const QDateTime &now)
+{
+    LiveTimer::Frequency freq = timer->frequency();
+    qint64 deadline = -1;
+    if (freq == LiveTimer::Relative) {
+        freq = frequencyForProximity(getDateProximity(now, timer->relativeTime()));
+        deadline = nextDateProximityChange(now, timer->relativeTime());
+        m_deadlines.insert(deadline, timer);
+    }
+    timer->setEffectiveFrequency(freq);
+    if (freq != LiveTimer::Disabled) {
+        m_wheel[freq].insert(timer);
+    }
+    m_liveTimers.insert(timer, deadline);
+}
+
+void SharedLiveTimer::unschedule(LiveTimer *timer)
+{
+    qint64 deadline = m_liveTimers.take(timer);
+    if (deadline >= 0) {
+        m_deadlines.remove(deadline, timer);
+    }
+    LiveTimer::Frequency freq = timer->effectiveFrequency();
+    if (freq != LiveTimer::Disabled) {
+        m_wheel[freq].remove(timer);
+    }
+}
+
 void SharedLiveTimer::updateFrequency()
 {
+    // the finest frequency which has timers
     LiveTimer::Frequency newFreq = LiveTimer::Disabled;
-    if (m_liveTimers.count() == 0) {
-        newFreq = LiveTimer::Disabled;
-    } else {
-        Q_FOREACH(LiveTimer* timer, m_liveTimers) {
-            LiveTimer::Frequency freq = timer->frequency();
-            if (freq == LiveTimer::Relative) {
-                date_proximity_t proximity = getDateProximity(QDateTime::currentDateTime(), timer->relativeTime());
-                freq = frequencyForProximity(proximity);
-            }
-            timer->setEffectiveFrequency(freq);
-
-            if (freq != LiveTimer::Disabled && (newFreq == LiveTimer::Disabled || freq < newFreq)) {
-                newFreq =  freq;
-            }
+    for (int freq = LiveTimer::Second; freq <= LiveTimer::Hour; freq++) {
+        if (!m_wheel[freq].isEmpty()) {
+            newFreq = (LiveTimer::Frequency)freq;
+            break;
         }
     }
     if (newFreq != m_frequency) {
@@ -101,18 +133,30 @@ void SharedLiveTimer::reInitTimer()
             break;
 
         default:
-            m_timer.stop();
-            return;
+            m_nextUpdate = QDateTime();
+            break;
+    }
+
+    // wake up earlier if a relative timer changes its frequency before
+    if (!m_deadlines.isEmpty()) {
+        qint64 deadline = m_deadlines.firstKey();
+        if (!m_nextUpdate.isValid() || deadline < m_nextUpdate.toMSecsSinceEpoch()) {
+            m_nextUpdate = QDateTime::fromMSecsSinceEpoch(deadline);
+        }
+    }
+    if (!m_nextUpdate.isValid()) {
+        m_timer.stop();
+        return;
     }
 
     qint64 diff = m_nextUpdate.toMSecsSinceEpoch() - now.toMSecsSinceEpoch();
-    m_timer.start(diff);
+    m_timer.start(qMax<qint64>(0, diff));
 }
 
 void SharedLiveTimer::timeout()
 {
     QDateTime now(QDateTime::currentDateTime());
-    qint64 currentMSecsSinceEpoch = now.currentMSecsSinceEpoch();
+    qint64 currentMSecsSinceEpoch = now.toMSecsSinceEpoch();
     qint64 earlyMs = m_nextUpdate.toMSecsSinceEpoch() - currentMSecsSinceEpoch;
     if (earlyMs > 0) { // timer shouldn't have happened yet.
         reInitTimer();
@@ -126,37 +170,49 @@ void SharedLiveTimer::timeout()
     bool isSecondUpdate = isMinuteUpdate ||
             m_lastUpdate.time().second() != now.time().second();
 
-    bool needsFrequencyUpdate = false;
-    QList<LiveTimer*> tmpTimers(m_liveTimers);
-    Q_FOREACH(LiveTimer* timer, tmpTimers) {
-
-        LiveTimer::Frequency effectiveFrequency = timer->effectiveFrequency();
-        if (effectiveFrequency == LiveTimer::Disabled) continue;
-
-        if (isHourUpdate) {
-            Q_EMIT timer->trigger();
-        } else if (isMinuteUpdate) {
-            if (effectiveFrequency >= LiveTimer::Second && effectiveFrequency <= LiveTimer::Minute) {
-                Q_EMIT timer->trigger();
-            }
-        } else if (isSecondUpdate) {
-            if (effectiveFrequency == LiveTimer::Second) {
-                Q_EMIT timer->trigger();
-            }
+    // re-evaluate only the relative timers whose proximity changed, and
+    // trigger them even if their new bucket is not due
+    QList<LiveTimer*> changedTimers;
+    while (!m_deadlines.isEmpty() && m_deadlines.firstKey() <= currentMSecsSinceEpoch) {
+        LiveTimer *timer = m_deadlines.first();
+        LiveTimer::Frequency oldFreq = timer->effectiveFrequency();
+        unschedule(timer);
+        schedule(timer, now);
+        if (oldFreq != timer->effectiveFrequency()) {
+            changedTimers.append(timer);
         }
+    }
 
-        // re-evaluate relative timer frequency
-        if (timer->frequency() == LiveTimer::Relative) {
-            date_proximity_t newProximity = getDateProximity(now, timer->relativeTime());
-            needsFrequencyUpdate |= effectiveFrequency != frequencyForProximity(newProximity);
+    QList<LiveTimer*> tmpTimers;
+    if (isSecondUpdate) {
+        tmpTimers += m_wheel[LiveTimer::Second].toList();
+    }
+    if (isMinuteUpdate) {
+        tmpTimers += m_wheel[LiveTimer::Minute].toList();
+    }
+    if (isHourUpdate) {
+        tmpTimers += m_wheel[LiveTimer::Hour].toList();
+    }
+    Q_FOREACH(LiveTimer* timer, changedTimers) {
+        LiveTimer::Frequency freq = timer->effectiveFrequency();
+        bool triggered = (freq == LiveTimer::Second && isSecondUpdate) ||
+                (freq == LiveTimer::Minute && isMinuteUpdate) ||
+                (freq == LiveTimer::Hour && isHourUpdate);
+        if (!triggered) {
+            tmpTimers.append(timer);
         }
     }
 
-    if (needsFrequencyUpdate) {
-        updateFrequency();
-    }
+    updateFrequency();
     reInitTimer();
     m_lastUpdate = now;
+
+    Q_FOREACH(LiveTimer* timer, tmpTimers) {
+        // a trigger handler may have unregistered the timer
+        if (m_liveTimers.contains(timer)) {
+            Q_EMIT timer->trigger();
+        }
+    }
 }
 
 void SharedLiveTimer::timedate1PropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &)
@@ -164,9 +220,20 @@ void SharedLiveTimer::timedate1PropertiesChanged(const QString &interface, const
     if (interface != dbusService) return;
     if (!changed.contains(QStringLiteral("Timezone"))) return;
 
-    QList<LiveTimer*> tmpTimers(m_liveTimers);
+    // the proximity of the relative timers depends on the local time
+    QDateTime now(QDateTime::currentDateTime());
+    QList<LiveTimer*> tmpTimers(m_liveTimers.keys());
     Q_FOREACH(LiveTimer* timer, tmpTimers) {
-        Q_EMIT timer->trigger();
+        if (m_liveTimers.value(timer) >= 0) {
+            unschedule(timer);
+            schedule(timer, now);
+        }
+    }
+    updateFrequency();
+    Q_FOREACH(LiveTimer* timer, tmpTimers) {
+        if (m_liveTimers.contains(timer)) {
+            Q_EMIT timer->trigger();
+        }
     }
     reInitTimer();
 }
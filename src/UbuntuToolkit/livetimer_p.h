@@ -30,6 +30,7 @@ class UBUNTUTOOLKIT_EXPORT LiveTimer : public QObject
     Q_ENUMS(Frequency)
     Q_PROPERTY(Frequency frequency READ frequency WRITE setFrequency NOTIFY frequencyChanged)
     Q_PROPERTY(QDateTime relativeTime READ relativeTime WRITE setRelativeTime NOTIFY relativeTimeChanged)
+    Q_PROPERTY(bool suspended READ suspended WRITE setSuspended NOTIFY suspendedChanged)
 public:
     explicit LiveTimer(QObject *parent = 0);
     ~LiveTimer();
@@ -48,15 +49,20 @@ public:
     QDateTime relativeTime() const { return m_relativeTime; }
     void setRelativeTime(const QDateTime& relativeTime);
 
+    bool suspended() const { return m_suspended; }
+    void setSuspended(bool suspended);
+
     Frequency effectiveFrequency() const { return m_effectiveFrequency; }
 
 Q_SIGNALS:
     void frequencyChanged();
     void relativeTimeChanged();
+    void suspendedChanged();
 
     void trigger();
 
 private:
+    void updateRegistration();
     void registerTimer();
     void unregisterTimer();
     void setEffectiveFrequency(Frequency frequency);
@@ -64,7 +70,9 @@ private:
     Frequency m_frequency;
     Frequency m_effectiveFrequency;
     QDateTime m_relativeTime;
+    QDateTime m_suspendedAt;
     quint64 m_lastUpdate;
+    bool m_suspended;
 
     friend class SharedLiveTimer;
 };
@@ -19,6 +19,9 @@
 
 #include <UbuntuToolkit/private/livetimer_p.h>
 
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
 #include <QtCore/QTimer>
 
 UT_NAMESPACE_BEGIN
@@ -46,10 +49,18 @@ Q_SIGNALS:
     void trigger();
 
 private:
+    void schedule(LiveTimer *timer, const QDateTime &now);
+    void unschedule(LiveTimer *timer);
     void updateFrequency();
     void reInitTimer();
 
-    QList<LiveTimer*> m_liveTimers;
+    // registered timers with the time their relative frequency must be
+    // re-evaluated at, -1 for timers with fixed frequency
+    QHash<LiveTimer*, qint64> m_liveTimers;
+    // the timers bucketed by effective frequency
+    QSet<LiveTimer*> m_wheel[LiveTimer::Relative];
+    // relative timers ordered by the time their effective frequency changes
+    QMultiMap<qint64, LiveTimer*> m_deadlines;
     QTimer m_timer;
     LiveTimer::Frequency m_frequency;
 
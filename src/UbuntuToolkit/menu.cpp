@@ -87,6 +87,229 @@ QObject* getFirstObject(MenuGroup* menuGroup) {
 
 }
 
+MenuDataList::MenuDataList()
+    : m_root(Q_NULLPTR)
+    , m_seed(0x9e3779b9u)
+{
+}
+
+MenuDataList::~MenuDataList()
+{
+    destroy(m_root);
+}
+
+void MenuDataList::destroy(Node *node)
+{
+    if (node) {
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+}
+
+int MenuDataList::count() const
+{
+    return m_root ? m_root->size : 0;
+}
+
+MenuDataList::Node *MenuDataList::nodeAt(int index) const
+{
+    Node *node = m_root;
+    while (node) {
+        int leftSize = node->left ? node->left->size : 0;
+        if (index < leftSize) {
+            node = node->left;
+        } else if (index == leftSize) {
+            return node;
+        } else {
+            index -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    return Q_NULLPTR;
+}
+
+QObject *MenuDataList::at(int index) const
+{
+    Node *node = nodeAt(index);
+    return node ? node->object : Q_NULLPTR;
+}
+
+int MenuDataList::rank(const Node *node)
+{
+    int result = node->left ? node->left->size : 0;
+    for (; node->parent; node = node->parent) {
+        if (node == node->parent->right) {
+            result += (node->parent->left ? node->parent->left->size : 0) + 1;
+        }
+    }
+    return result;
+}
+
+// the data may be added more than once, resolve to the first occurrence
+MenuDataList::Node *MenuDataList::firstNode(QObject *object) const
+{
+    Node *first = Q_NULLPTR;
+    int firstRank = -1;
+    for (auto it = m_nodes.constFind(object); it != m_nodes.constEnd() && it.key() == object; ++it) {
+        int nodeRank = rank(it.value());
+        if (!first || nodeRank < firstRank) {
+            first = it.value();
+            firstRank = nodeRank;
+        }
+    }
+    return first;
+}
+
+int MenuDataList::indexOf(QObject *object) const
+{
+    Node *node = firstNode(object);
+    return node ? rank(node) : -1;
+}
+
+void MenuDataList::update(Node *node)
+{
+    node->size = 1;
+    node->totalItems = node->items;
+    node->dataWithItems = node->items > 0 ? 1 : 0;
+    Node *children[2] = { node->left, node->right };
+    for (Node *child : children) {
+        if (child) {
+            node->size += child->size;
+            node->totalItems += child->totalItems;
+            node->dataWithItems += child->dataWithItems;
+            child->parent = node;
+        }
+    }
+}
+
+// splits the first count nodes into left and the rest into right
+void MenuDataList::split(Node *node, int count, Node *&left, Node *&right)
+{
+    if (!node) {
+        left = right = Q_NULLPTR;
+        return;
+    }
+    int leftSize = node->left ? node->left->size : 0;
+    if (leftSize < count) {
+        split(node->right, count - leftSize - 1, node->right, right);
+        left = node;
+    } else {
+        split(node->left, count, left, node->left);
+        right = node;
+    }
+    update(node);
+    node->parent = Q_NULLPTR;
+}
+
+MenuDataList::Node *MenuDataList::merge(Node *left, Node *right)
+{
+    if (!left || !right) {
+        return left ? left : right;
+    }
+    if (left->priority > right->priority) {
+        left->right = merge(left->right, right);
+        update(left);
+        return left;
+    }
+    right->left = merge(left, right->left);
+    update(right);
+    return right;
+}
+
+void MenuDataList::insert(int index, QObject *object)
+{
+    // xorshift, the tree only needs the priorities to be evenly spread
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    Node *node = new Node;
+    node->object = object;
+    node->left = node->right = node->parent = Q_NULLPTR;
+    node->priority = m_seed;
+    node->items = 0;
+    update(node);
+    m_nodes.insertMulti(object, node);
+
+    Node *left, *right;
+    split(m_root, qBound(0, index, count()), left, right);
+    m_root = merge(merge(left, node), right);
+    m_root->parent = Q_NULLPTR;
+}
+
+bool MenuDataList::removeOne(QObject *object)
+{
+    Node *node = firstNode(object);
+    if (!node) {
+        return false;
+    }
+    m_nodes.remove(object, node);
+
+    Node *left, *middle, *right;
+    split(m_root, rank(node), left, right);
+    split(right, 1, middle, right);
+    Q_ASSERT(middle == node);
+    delete middle;
+    m_root = merge(left, right);
+    if (m_root) {
+        m_root->parent = Q_NULLPTR;
+    }
+    return true;
+}
+
+void MenuDataList::clear()
+{
+    destroy(m_root);
+    m_root = Q_NULLPTR;
+    m_nodes.clear();
+}
+
+int MenuDataList::itemCount(QObject *object) const
+{
+    Node *node = firstNode(object);
+    return node ? node->items : 0;
+}
+
+int MenuDataList::itemCountAt(int index) const
+{
+    Node *node = nodeAt(index);
+    return node ? node->items : 0;
+}
+
+void MenuDataList::setItemCount(QObject *object, int count)
+{
+    Node *node = firstNode(object);
+    if (!node || node->items == count) {
+        return;
+    }
+    node->items = count;
+    for (; node; node = node->parent) {
+        update(node);
+    }
+}
+
+void MenuDataList::countItems(int index, int *items, int *dataWithItems) const
+{
+    *items = *dataWithItems = 0;
+    Node *node = m_root;
+    while (node && index > 0) {
+        int leftSize = node->left ? node->left->size : 0;
+        if (index <= leftSize) {
+            node = node->left;
+            continue;
+        }
+        if (node->left) {
+            *items += node->left->totalItems;
+            *dataWithItems += node->left->dataWithItems;
+        }
+        *items += node->items;
+        *dataWithItems += node->items > 0 ? 1 : 0;
+        index -= leftSize + 1;
+        node = node->right;
+    }
+}
+
 MenuPrivate::MenuPrivate(Menu *qq)
     : q_ptr(qq)
     , m_platformMenu(QGuiApplicationPrivate::platformTheme()->createPlatformMenu())
@@ -114,26 +337,17 @@ void MenuPrivate::insertObject(int index, QObject *o)
     }
 
     // If the menus contains lists or groups, we need to alter the insertion index to account for them.
+    // Each data having items is followed by a separator, except the last one before the index.
+    int position = qMin(index, m_data.count());
     int actualIndex = 0;
-    bool insertSeparator = false;
-    for (int i = 0; i < index && i < m_data.count(); i++) {
-        QObject* data = m_data[i];
-
-        int dataObjectCount = 0;
-        if (auto menuGroup = qobject_cast<MenuGroup*>(data)) {
-            dataObjectCount = getActionsFromMenuGroup(menuGroup).count();
-        } else if (auto list = qobject_cast<ActionList*>(data)) {
-            dataObjectCount = list->list().count();
-        } else {
-            dataObjectCount = 1;
-        }
-        actualIndex += dataObjectCount;
-        // insert a separator before the new item if there are previous items.
-        insertSeparator |= dataObjectCount > 0;
-
-        // account for item separators if it's not the last data item.
-        actualIndex += dataObjectCount > 0 && (i+1 < index && i+1 < m_data.count()) ? 1: 0;
+    int dataWithItems = 0;
+    m_data.countItems(position, &actualIndex, &dataWithItems);
+    actualIndex += dataWithItems;
+    if (m_data.itemCountAt(position - 1) > 0) {
+        actualIndex--;
     }
+    // insert a separator before the new item if there are previous items.
+    bool insertSeparator = dataWithItems > 0;
 
     // need to make sure the item after the insertion index has a separator
     if (index < m_data.count()) {
@@ -153,7 +367,7 @@ void MenuPrivate::insertObject(int index, QObject *o)
         }
     }
 
-    m_data.insert(m_data.count() > index ? index : m_data.count(), o);
+    m_data.insert(position, o);
 
     // if an object changes, we need to remove and re-add it.
     std::function<void()> refreshObject = [o, this]() {
@@ -183,6 +397,7 @@ void MenuPrivate::insertObject(int index, QObject *o)
         objects << o;
     }
 
+    m_data.setItemCount(o, objects.count());
     Q_FOREACH(QObject* platformObject, objects) {
         // add to platform
         auto platformWrapper = new PlatformItemWrapper(platformObject, q);
@@ -201,6 +416,7 @@ void MenuPrivate::insertObject(int index, QObject *o)
             m_dataPlatformObjectMap.remove(o, platformObject);
 
             if (m_platformItems.contains(platformObject)) {
+                m_data.setItemCount(o, m_data.itemCount(o) - 1);
                 PlatformItemWrapper* wrapper = m_platformItems.take(platformObject);
                 wrapper->remove();
                 delete wrapper;
@@ -292,7 +508,7 @@ int MenuPrivate::data_count(QQmlListProperty<QObject> *prop)
 QObject *MenuPrivate::data_at(QQmlListProperty<QObject> *prop, int index)
 {
     MenuPrivate *p = static_cast<MenuPrivate *>(prop->data);
-    return p->m_data.value(index, Q_NULLPTR);
+    return p->m_data.at(index);
 }
 
 void MenuPrivate::data_clear(QQmlListProperty<QObject> *prop)
@@ -456,7 +672,9 @@ PlatformItemWrapper::PlatformItemWrapper(QObject *target, Menu* menu)
     , m_menu(menu)
     , m_platformItem(menu->platformMenu() ? menu->platformMenu()->createMenuItem() : Q_NULLPTR)
     , m_platformItemSeparator(Q_NULLPTR)
+    , m_dirty(AllDirty)
     , m_inserted(false)
+    , m_syncPending(false)
 {
     if (Menu* menu = qobject_cast<Menu*>(m_target)) {
         if (m_platformItem) {
@@ -564,7 +782,7 @@ void PlatformItemWrapper::setSeparator()
     }
 }
 
-void PlatformItemWrapper::updateVisible()
+void PlatformItemWrapper::syncVisible()
 {
     if (Menu* menu = qobject_cast<Menu*>(m_target)) {
         if (m_platformItem) m_platformItem->setVisible(menu->visible());
@@ -574,7 +792,7 @@ void PlatformItemWrapper::updateVisible()
     }
 }
 
-void PlatformItemWrapper::updateEnabled()
+void PlatformItemWrapper::syncEnabled()
 {
     if (Menu* menu = qobject_cast<Menu*>(m_target)) {
         if (m_platformItem) m_platformItem->setEnabled(menu->isEnabled());
@@ -584,7 +802,7 @@ void PlatformItemWrapper::updateEnabled()
     }
 }
 
-void PlatformItemWrapper::updateText()
+void PlatformItemWrapper::syncText()
 {
     if (Menu* menu = qobject_cast<Menu*>(m_target)) {
         if (m_platformItem) m_platformItem->setText(menu->text());
@@ -594,7 +812,7 @@ void PlatformItemWrapper::updateText()
     }
 }
 
-void PlatformItemWrapper::updateIcon()
+void PlatformItemWrapper::syncIcon()
 {
     QIcon icon;
     if (Menu* menu = qobject_cast<Menu*>(m_target)) {
@@ -630,7 +848,7 @@ inline QKeySequence sequenceFromVariant(const QVariant& variant)
     return QKeySequence();
 }
 
-void PlatformItemWrapper::updateShortcut()
+void PlatformItemWrapper::syncShortcut()
 {
     if (!m_platformItem) return;
 
@@ -639,7 +857,7 @@ void PlatformItemWrapper::updateShortcut()
     }
 }
 
-void PlatformItemWrapper::updateCheck()
+void PlatformItemWrapper::syncCheck()
 {
     if (!m_platformItem) return;
 
@@ -650,16 +868,63 @@ void PlatformItemWrapper::updateCheck()
     }
 }
 
+void PlatformItemWrapper::updateVisible()
+{
+    markDirty(VisibleDirty);
+}
+
+void PlatformItemWrapper::updateEnabled()
+{
+    markDirty(EnabledDirty);
+}
+
+void PlatformItemWrapper::updateText()
+{
+    markDirty(TextDirty);
+}
+
+void PlatformItemWrapper::updateIcon()
+{
+    markDirty(IconDirty);
+}
+
+void PlatformItemWrapper::updateShortcut()
+{
+    markDirty(ShortcutDirty);
+}
+
+void PlatformItemWrapper::updateCheck()
+{
+    markDirty(CheckDirty);
+}
+
+// collects the changes of the target and pushes them once per event loop turn
+void PlatformItemWrapper::markDirty(int flags)
+{
+    m_dirty |= flags;
+    if (!m_syncPending) {
+        m_syncPending = true;
+        QMetaObject::invokeMethod(this, "syncPlatformItem", Qt::QueuedConnection);
+    }
+}
+
 void PlatformItemWrapper::syncPlatformItem()
 {
-    updateVisible();
-    updateEnabled();
-    updateText();
-    updateIcon();
-    updateShortcut();
-    updateCheck();
+    m_syncPending = false;
+    if (!m_dirty) {
+        return;
+    }
+    const int dirty = m_dirty;
+    m_dirty = 0;
+
+    if (dirty & VisibleDirty) syncVisible();
+    if (dirty & EnabledDirty) syncEnabled();
+    if (dirty & TextDirty) syncText();
+    if (dirty & IconDirty) syncIcon();
+    if (dirty & ShortcutDirty) syncShortcut();
+    if (dirty & CheckDirty) syncCheck();
 
-    if (m_menu->platformMenu() && m_platformItem) {
+    if (m_menu && m_menu->platformMenu() && m_platformItem) {
         m_menu->platformMenu()->syncMenuItem(m_platformItem);
     }
 }
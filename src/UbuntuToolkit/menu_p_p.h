@@ -30,6 +30,58 @@ class UCAction;
 class Menu;
 class PlatformItemWrapper;
 
+/*
+ * Ordered list of the menu data, kept in a randomized balanced tree so that
+ * positional inserts and removals, as well as the number of platform items
+ * preceding a position, cost O(log n).
+ */
+class MenuDataList
+{
+public:
+    MenuDataList();
+    ~MenuDataList();
+
+    int count() const;
+    QObject *at(int index) const;
+    int indexOf(QObject *object) const;
+    void insert(int index, QObject *object);
+    bool removeOne(QObject *object);
+    void clear();
+
+    int itemCount(QObject *object) const;
+    int itemCountAt(int index) const;
+    void setItemCount(QObject *object, int count);
+    // number of platform items and of the data having platform items before index
+    void countItems(int index, int *items, int *dataWithItems) const;
+
+private:
+    struct Node {
+        QObject *object;
+        Node *left;
+        Node *right;
+        Node *parent;
+        uint priority;
+        int size;
+        int items;
+        int totalItems;
+        int dataWithItems;
+    };
+
+    Node *nodeAt(int index) const;
+    Node *firstNode(QObject *object) const;
+    static int rank(const Node *node);
+    static void update(Node *node);
+    static void split(Node *node, int count, Node *&left, Node *&right);
+    static Node *merge(Node *left, Node *right);
+    static void destroy(Node *node);
+
+    Node *m_root;
+    QMultiHash<QObject*, Node*> m_nodes;
+    uint m_seed;
+
+    Q_DISABLE_COPY(MenuDataList)
+};
+
 class MenuPrivate
 {
     Q_DECLARE_PUBLIC(Menu)
@@ -56,7 +108,7 @@ public:
 
     QHash<QObject*, PlatformItemWrapper*> m_platformItems;
     QMultiHash<QObject*, QObject*> m_dataPlatformObjectMap;
-    QVector<QObject*> m_data;
+    MenuDataList m_data;
 };
 
 class PlatformItemWrapper : public QObject
@@ -80,14 +132,35 @@ public Q_SLOTS:
     void updateShortcut();
     void updateCheck();
 
-private:
+private Q_SLOTS:
     void syncPlatformItem();
 
+private:
+    enum DirtyFlag {
+        VisibleDirty = 0x01,
+        EnabledDirty = 0x02,
+        TextDirty = 0x04,
+        IconDirty = 0x08,
+        ShortcutDirty = 0x10,
+        CheckDirty = 0x20,
+        AllDirty = 0x3F
+    };
+
+    void markDirty(int flags);
+    void syncVisible();
+    void syncEnabled();
+    void syncText();
+    void syncIcon();
+    void syncShortcut();
+    void syncCheck();
+
     QObject* m_target;
     QPointer<Menu> m_menu;
     QPlatformMenuItem* m_platformItem;
     QPlatformMenuItem* m_platformItemSeparator;
-    bool m_inserted;
+    int m_dirty;
+    bool m_inserted:1;
+    bool m_syncPending:1;
 };
 
 UT_NAMESPACE_END
@@ -192,8 +192,10 @@ QColor UCThreeLabelsSlot::getSubtitleColor(QQuickItem *item, UCTheme *theme)
 {
     // FIXME: replace the code below with automatic color
     // change detection based on teh item's state
-    const char *valueSet = item->isEnabled() ? "normal" : "disabled";
-    return theme ? theme->getPaletteColor(valueSet, "backgroundSecondaryText") : QColor();
+    static const int normal = UCTheme::paletteProfile("normal");
+    static const int disabled = UCTheme::paletteProfile("disabled");
+    static const int backgroundSecondaryText = UCTheme::paletteColorRole("backgroundSecondaryText");
+    return theme ? theme->paletteColor(item->isEnabled() ? normal : disabled, backgroundSecondaryText) : QColor();
 }
 
 UCLabel *UCThreeLabelsSlot::subtitle()
@@ -222,8 +224,10 @@ QColor UCThreeLabelsSlot::getSummaryColor(QQuickItem *item, UCTheme *theme)
 {
     // FIXME: replace the code below with automatic color
     // change detection based on teh item's state
-    const char *valueSet = item->isEnabled() ? "normal" : "disabled";
-    return theme ? theme->getPaletteColor(valueSet, "backgroundTertiaryText") : QColor();
+    static const int normal = UCTheme::paletteProfile("normal");
+    static const int disabled = UCTheme::paletteProfile("disabled");
+    static const int backgroundTertiaryText = UCTheme::paletteColorRole("backgroundTertiaryText");
+    return theme ? theme->paletteColor(item->isEnabled() ? normal : disabled, backgroundTertiaryText) : QColor();
 }
 
 UCLabel *UCThreeLabelsSlot::summary()
@@ -18,8 +18,10 @@
 
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlContext>
+#include <UbuntuMetrics/private/tracing_p.h>
 
 #include "privates/ucpagewrapperincubator_p.h"
+#include "componentcache_p.h"
 
 UT_NAMESPACE_BEGIN
 
@@ -106,8 +108,9 @@ void UCPageWrapperPrivate::reset()
         q->setObject(nullptr);
     }
 
+    QObject::disconnect(m_componentConnection);
     if (m_component && m_ownsComponent) {
-        delete m_component;
+        ComponentCache::forEngine(m_component->engine())->release(m_component);
         m_component = nullptr;
     }
 
@@ -301,12 +304,12 @@ void UCPageWrapperPrivate::loadComponentState()
     } else if (m_reference.canConvert<QString>()) {
 
         //m_reference contains a URL to the Component we have to load, in this
-        //case we need to destroy the component ourselves lateron
+        //case we need to release the component to the cache lateron
         QQmlComponent::CompilationMode cMode = m_synchronous ? QQmlComponent::PreferSynchronous :
                                                                QQmlComponent::Asynchronous;
         QUrl componentUrl = QUrl(m_reference.toString());
         m_ownsComponent = true;
-        m_component = new QQmlComponent(qmlEngine(q), componentUrl, cMode);
+        m_component = ComponentCache::forEngine(qmlEngine(q))->acquire(componentUrl, cMode);
 
     } else if (m_reference.canConvert<QQuickItem *>()) {
         //the object is owned by JS
@@ -337,15 +340,16 @@ void UCPageWrapperPrivate::loadComponentState()
             nextStep();
         else {
             //async behaviour, advance to the next state once the component was loaded
-            QSharedPointer<QMetaObject::Connection> connHandle(new QMetaObject::Connection);
-            auto asyncCallback = [this, connHandle](){
+            auto asyncCallback = [this](){
                 if(m_component->status() != QQmlComponent::Loading) {
-                    QObject::disconnect(*connHandle);
+                    QObject::disconnect(m_componentConnection);
                     nextStep();
                 }
             };
 
-            *connHandle = QObject::connect(m_component, &QQmlComponent::statusChanged,asyncCallback);
+            //the component may be shared through the cache, so the connection
+            //must be dropped on reset rather than relying on its destruction
+            m_componentConnection = QObject::connect(m_component, &QQmlComponent::statusChanged, q, asyncCallback);
         }
     }
 }
@@ -382,15 +386,18 @@ void UCPageWrapperPrivate::createObjectState()
     m_itemContext = new QQmlContext(creationContext);
 
     if (m_synchronous) {
+        UMTracing::beginSpan("pageIncubation");
         QQuickItem *theItem = toItem(m_component->beginCreate(m_itemContext));
         if (theItem) {
             initItem(theItem);
             m_itemContext->setParent(theItem);
             m_itemContext = nullptr;
             m_component->completeCreate();
+            UMTracing::endSpan("pageIncubation");
             m_state = NotifyPageLoaded;
             nextStep();
         } else {
+            UMTracing::endSpan("pageIncubation");
             delete m_itemContext;
             m_itemContext = nullptr;
             m_state = Error;
@@ -413,6 +420,8 @@ void UCPageWrapperPrivate::createObjectState()
         };
         *connHandle = QObject::connect(m_incubator, &UCPageWrapperIncubator::initialStateRequested, asyncCallback);
 
+        // the span ends in finalizeObjectIfReady() once the incubation is over
+        UMTracing::beginSpan("pageIncubation");
         m_component->create(*m_incubator, m_itemContext);
     }
 }
@@ -420,6 +429,9 @@ void UCPageWrapperPrivate::createObjectState()
 void UCPageWrapperPrivate::finalizeObjectIfReady()
 {
     Q_Q(UCPageWrapper);
+    if (m_incubator->status() != QQmlIncubator::Loading) {
+        UMTracing::endSpan("pageIncubation");
+    }
     if(m_incubator->status() == QQmlIncubator::Ready) {
 
         QObject::disconnect(m_incubator, SIGNAL(enterOnStatusChanged()),
@@ -71,6 +71,7 @@ public:
     QQuickItem* m_pageHolder;
     UCPageWrapperIncubator* m_incubator;
     QQmlComponent *m_component;
+    QMetaObject::Connection m_componentConnection;
     QQmlContext *m_itemContext;
     State m_state;
     int m_column;
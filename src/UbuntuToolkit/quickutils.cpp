@@ -18,6 +18,8 @@
 
 #include <QtCore/QAbstractListModel>
 #include <QtCore/QAbstractProxyModel>
+#include <QtCore/QMutex>
+#include <QtCore/private/qmetaobject_p.h>
 #include <QtGui/QGuiApplication>
 #include <QtQml/QQmlContext>
 #include <QtQml/QQmlPropertyMap>
@@ -243,6 +245,57 @@ QString QuickUtils::className(QObject *item)
     return result.left(result.indexOf(QStringLiteral("_QML")));
 }
 
+/*
+ * Process wide cache of the QuickUtils::inherits() results, keyed by the meta
+ * object data and the interned class name. Meta objects of QML declared types
+ * are built at runtime and released together with the type data of their
+ * engine, so the results for those are dropped when any engine they were
+ * cached for is destroyed.
+ */
+class InheritsCache
+{
+public:
+    struct Entry {
+        const QMetaObject *superClass;
+        bool inherits;
+    };
+    typedef QPair<const void*, int> Key;
+
+    QMutex mutex;
+    QHash<QString, int> classIds;
+    QHash<Key, Entry> staticEntries;
+    QHash<Key, Entry> dynamicEntries;
+    QSet<QQmlEngine*> engines;
+
+    static bool isDynamic(const QMetaObject *mo)
+    {
+        return (QMetaObjectPrivate::get(mo)->flags & DynamicMetaObject)
+                || strstr(mo->className(), "_QML");
+    }
+    void clear()
+    {
+        classIds.clear();
+        staticEntries.clear();
+        dynamicEntries.clear();
+    }
+};
+Q_GLOBAL_STATIC(InheritsCache, inheritsCache)
+
+static bool metaObjectInherits(const QMetaObject *mo, const QString &fromClass)
+{
+    while (mo) {
+        // compare the class name up to the QML type suffix
+        const char *className = mo->className();
+        const char *suffix = strstr(className, "_QML");
+        const int length = suffix ? int(suffix - className) : int(qstrlen(className));
+        if (QLatin1String(className, length) == fromClass) {
+            return true;
+        }
+        mo = mo->superClass();
+    }
+    return false;
+}
+
 /*!
  * \internal
  * The function checks whether an item inherits a given class name.
@@ -253,19 +306,54 @@ bool QuickUtils::inherits(QObject *object, const QString &fromClass)
         return false;
     }
     const QMetaObject *mo = object->metaObject();
-    QString className;
-    while (mo) {
-        className = QString::fromLatin1(mo->className());
-        className = className.left(className.indexOf(QStringLiteral("_QML")));
-        if (className == fromClass) {
-            return true;
+    InheritsCache *cache = inheritsCache();
+    QMutexLocker lock(&cache->mutex);
+
+    auto classId = cache->classIds.constFind(fromClass);
+    if (classId == cache->classIds.constEnd()) {
+        classId = cache->classIds.insert(fromClass, cache->classIds.size());
+    }
+    // instances of QML types have their own copy of the meta object, but the
+    // data of it is shared between all of them
+    const InheritsCache::Key key(mo->d.data, *classId);
+    const bool dynamic = InheritsCache::isDynamic(mo);
+    QHash<InheritsCache::Key, InheritsCache::Entry> &entries = dynamic ? cache->dynamicEntries : cache->staticEntries;
+    auto entry = entries.constFind(key);
+    if (entry != entries.constEnd() && entry->superClass == mo->superClass()) {
+        return entry->inherits;
+    }
+
+    const bool result = metaObjectInherits(mo, fromClass);
+    if (dynamic) {
+        QQmlEngine *engine = qmlEngine(object);
+        if (!engine) {
+            // cannot tell when the meta object gets released
+            return result;
+        }
+        if (!cache->engines.contains(engine)) {
+            cache->engines.insert(engine);
+            QObject::connect(engine, &QObject::destroyed, [engine]() {
+                InheritsCache *cache = inheritsCache();
+                QMutexLocker lock(&cache->mutex);
+                cache->engines.remove(engine);
+                cache->dynamicEntries.clear();
+            });
         }
-        mo = mo->superClass();
     }
-    return false;
+    entries.insert(key, InheritsCache::Entry{mo->superClass(), result});
+    return result;
 }
 
-
+/*!
+ * \internal
+ * Drops the cached results of inherits().
+ */
+void QuickUtils::clearInheritsCache()
+{
+    InheritsCache *cache = inheritsCache();
+    QMutexLocker lock(&cache->mutex);
+    cache->clear();
+}
 
 /*!
  * \internal
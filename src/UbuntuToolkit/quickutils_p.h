@@ -59,6 +59,7 @@ public:
 
     Q_INVOKABLE static QString className(QObject *item);
     Q_REVISION(1) Q_INVOKABLE static bool inherits(QObject *object, const QString &fromClass);
+    static void clearInheritsCache();
     QObject* createQmlObject(const QUrl &url, QQmlEngine *engine);
     static bool showDeprecationWarnings();
     static bool descendantItemOf(QQuickItem *item, const QQuickItem *parent);
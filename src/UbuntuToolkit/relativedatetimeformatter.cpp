@@ -0,0 +1,357 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "relativedatetimeformatter_p.h"
+#include "i18n_p.h"
+#include "timeutils_p.h"
+
+UT_NAMESPACE_BEGIN
+
+/*!
+ * \internal
+ * \class DateTimeFormat
+ * Holds a date/time format string in the syntax of QDateTime::toString(),
+ * split into tokens once so that formatting does not have to re-parse the
+ * format for every timestamp. Formats containing specifiers which are not
+ * handled (time zone, milliseconds) are formatted by QDateTime::toString().
+ */
+DateTimeFormat::DateTimeFormat(const QString &format)
+    : m_format(format)
+{
+    parse();
+}
+
+void DateTimeFormat::parse()
+{
+    auto appendLiteral = [this](const QString &text) {
+        if (!m_tokens.isEmpty() && m_tokens.last().type == Literal) {
+            m_tokens.last().text += text;
+        } else {
+            m_tokens.append(Token{Literal, text});
+        }
+    };
+
+    const int length = m_format.length();
+    int i = 0;
+    while (i < length) {
+        const QChar c = m_format.at(i);
+        int repeat = 1;
+        while (i + repeat < length && m_format.at(i + repeat) == c) {
+            repeat++;
+        }
+
+        switch (c.unicode()) {
+        case '\'': {
+            if (repeat > 1) {
+                // '' outside of quotes is a single quote
+                appendLiteral(QStringLiteral("'"));
+                i += 2;
+                break;
+            }
+            // quoted text, '' inside quotes is a single quote
+            QString text;
+            i++;
+            while (i < length) {
+                if (m_format.at(i) == QLatin1Char('\'')) {
+                    if (i + 1 < length && m_format.at(i + 1) == QLatin1Char('\'')) {
+                        text += QLatin1Char('\'');
+                        i += 2;
+                        continue;
+                    }
+                    i++;
+                    break;
+                }
+                text += m_format.at(i++);
+            }
+            appendLiteral(text);
+            break;
+        }
+        case 'd':
+        case 'M': {
+            repeat = qMin(repeat, 4);
+            static const TokenType dayTokens[] = { Day, Day2, DayName, LongDayName };
+            static const TokenType monthTokens[] = { Month, Month2, MonthName, LongMonthName };
+            m_tokens.append(Token{c == QLatin1Char('d') ? dayTokens[repeat - 1] : monthTokens[repeat - 1], QString()});
+            i += repeat;
+            break;
+        }
+        case 'y':
+            if (repeat >= 4) {
+                m_tokens.append(Token{Year4, QString()});
+                i += 4;
+            } else if (repeat >= 2) {
+                m_tokens.append(Token{Year2, QString()});
+                i += 2;
+            } else {
+                appendLiteral(c);
+                i++;
+            }
+            break;
+        case 'h':
+        case 'H':
+        case 'm':
+        case 's': {
+            repeat = qMin(repeat, 2);
+            TokenType type;
+            switch (c.unicode()) {
+            case 'h': type = repeat == 2 ? Hour2 : Hour; break;
+            case 'H': type = repeat == 2 ? Hour24_2 : Hour24; break;
+            case 'm': type = repeat == 2 ? Minute2 : Minute; break;
+            default: type = repeat == 2 ? Second2 : Second; break;
+            }
+            m_tokens.append(Token{type, QString()});
+            i += repeat;
+            break;
+        }
+        case 'a':
+        case 'A': {
+            m_ampm = true;
+            m_tokens.append(Token{c == QLatin1Char('A') ? AmPmUpper : AmPm, QString()});
+            const QChar p = c == QLatin1Char('A') ? QLatin1Char('P') : QLatin1Char('p');
+            i += (i + 1 < length && m_format.at(i + 1) == p) ? 2 : 1;
+            break;
+        }
+        case 'z':
+        case 't':
+            m_fallback = true;
+            m_tokens.clear();
+            return;
+        default:
+            appendLiteral(c);
+            i++;
+            break;
+        }
+    }
+}
+
+/*!
+ * \internal
+ * Formats \e datetime using the day, month and AM/PM names of \e locale.
+ * Gives the same result as QDateTime::toString() with the same format.
+ */
+QString DateTimeFormat::toString(const QDateTime &datetime, const QLocale &locale) const
+{
+    if (m_fallback) {
+        return datetime.toString(m_format);
+    }
+
+    const QDate date = datetime.date();
+    const QTime time = datetime.time();
+    auto number = [](int value, int width) {
+        return QString::number(value).rightJustified(width, QLatin1Char('0'));
+    };
+
+    QString result;
+    result.reserve(m_format.length() + 16);
+    for (const Token &token : m_tokens) {
+        switch (token.type) {
+        case Literal: result += token.text; break;
+        case Day: result += QString::number(date.day()); break;
+        case Day2: result += number(date.day(), 2); break;
+        case DayName: result += locale.dayName(date.dayOfWeek(), QLocale::ShortFormat); break;
+        case LongDayName: result += locale.dayName(date.dayOfWeek(), QLocale::LongFormat); break;
+        case Month: result += QString::number(date.month()); break;
+        case Month2: result += number(date.month(), 2); break;
+        case MonthName: result += locale.monthName(date.month(), QLocale::ShortFormat); break;
+        case LongMonthName: result += locale.monthName(date.month(), QLocale::LongFormat); break;
+        case Year2: result += number(qAbs(date.year()) % 100, 2); break;
+        case Year4: result += QString::number(date.year()); break;
+        case Hour:
+        case Hour2: {
+            int hour = time.hour();
+            if (m_ampm) {
+                hour = hour % 12 == 0 ? 12 : hour % 12;
+            }
+            result += token.type == Hour2 ? number(hour, 2) : QString::number(hour);
+            break;
+        }
+        case Hour24: result += QString::number(time.hour()); break;
+        case Hour24_2: result += number(time.hour(), 2); break;
+        case Minute: result += QString::number(time.minute()); break;
+        case Minute2: result += number(time.minute(), 2); break;
+        case Second: result += QString::number(time.second()); break;
+        case Second2: result += number(time.second(), 2); break;
+        case AmPm:
+            result += (time.hour() < 12 ? locale.amText() : locale.pmText()).toLower();
+            break;
+        case AmPmUpper:
+            result += (time.hour() < 12 ? locale.amText() : locale.pmText()).toUpper();
+            break;
+        }
+    }
+    return result;
+}
+
+/*!
+ * \internal
+ * \class RelativeDateTimeFormatter
+ * Formats timestamps relative to the current time, as done by
+ * i18n.relativeDateTime(). The translated format strings are resolved once
+ * per language and text domain and kept pre-parsed; invalidate() must be
+ * called whenever any of those change.
+ */
+RelativeDateTimeFormatter::RelativeDateTimeFormatter(UbuntuI18n *i18n)
+    : m_i18n(i18n)
+{
+}
+
+void RelativeDateTimeFormatter::invalidate()
+{
+    m_resolved = false;
+    m_now.clear();
+    m_minutes.clear();
+    for (int i = 0; i < FormatCount; i++) {
+        m_formats[i] = DateTimeFormat();
+    }
+}
+
+void RelativeDateTimeFormatter::resolve()
+{
+    static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
+    const bool is12h = isLocale12h();
+
+    m_locale = QLocale::system();
+    /* TRANSLATORS: Time based "this is happening/happened now" */
+    m_now = m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("Now"));
+
+    /* en_US example: "1:00 PM" */
+    m_formats[DATE_PROXIMITY_TODAY] = DateTimeFormat(is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("HH:mm")));
+
+    /* en_US example: "Yesterday  13:00" */
+    m_formats[DATE_PROXIMITY_YESTERDAY] = DateTimeFormat(is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'HH:mm")));
+
+    /* en_US example: "Tomorrow  1:00 PM" */
+    m_formats[DATE_PROXIMITY_TOMORROW] = DateTimeFormat(is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'HH:mm")));
+
+    /* en_US example: "Fri  1:00 PM" */
+    m_formats[DATE_PROXIMITY_LAST_WEEK] = DateTimeFormat(is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'HH:mm")));
+    m_formats[DATE_PROXIMITY_NEXT_WEEK] = m_formats[DATE_PROXIMITY_LAST_WEEK];
+
+    m_formats[DATE_PROXIMITY_FAR_BACK] = DateTimeFormat(is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'HH:mm")));
+    m_formats[DATE_PROXIMITY_FAR_FORWARD] = m_formats[DATE_PROXIMITY_FAR_BACK];
+
+    m_resolved = true;
+}
+
+QString RelativeDateTimeFormatter::minutes(qint64 minutes)
+{
+    static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
+
+    auto it = m_minutes.constFind(minutes);
+    if (it != m_minutes.constEnd()) {
+        return *it;
+    }
+    QString text;
+    if (minutes < 0) {
+        text = m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("%1 minute ago"),
+                           QStringLiteral("%1 minutes ago"), qAbs(minutes)).arg(qAbs(minutes));
+    } else {
+        text = m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("%1 minute"),
+                           QStringLiteral("%1 minutes"), minutes).arg(minutes);
+    }
+    m_minutes.insert(minutes, text);
+    return text;
+}
+
+/*!
+ * \internal
+ * Formats \e datetime relative to \e relativeTo.
+ */
+QString RelativeDateTimeFormatter::format(const QDateTime &datetime, const QDateTime &relativeTo)
+{
+    if (!m_resolved) {
+        resolve();
+    }
+
+    const date_proximity_t prox = getDateProximity(relativeTo, datetime);
+    switch (prox) {
+        case DATE_PROXIMITY_NOW:
+            return m_now;
+        case DATE_PROXIMITY_HOUR: {
+            qint64 diff = datetime.toMSecsSinceEpoch() - relativeTo.toMSecsSinceEpoch();
+            return minutes(qRound(float(diff) / 60000));
+        }
+        default:
+            return m_formats[prox].toString(datetime, m_locale);
+    }
+}
+
+/*!
+ * \internal
+ * Formats \e datetime relative to the current time.
+ */
+QString RelativeDateTimeFormatter::format(const QDateTime &datetime)
+{
+    return format(datetime, QDateTime::currentDateTime());
+}
+
+/*!
+ * \internal
+ * Formats all \e datetimes relative to the same current time, which is
+ * read only once.
+ */
+QStringList RelativeDateTimeFormatter::format(const QList<QDateTime> &datetimes)
+{
+    const QDateTime relativeTo(QDateTime::currentDateTime());
+    QStringList result;
+    result.reserve(datetimes.size());
+    for (const QDateTime &datetime : datetimes) {
+        result.append(format(datetime, relativeTo));
+    }
+    return result;
+}
+
+UT_NAMESPACE_END
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RELATIVEDATETIMEFORMATTER_P_H
+#define RELATIVEDATETIMEFORMATTER_P_H
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QLocale>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+UT_NAMESPACE_BEGIN
+
+/*
+ * A QDateTime::toString() format string parsed once into tokens. Formats using
+ * specifiers not handled by the tokenizer fall back to QDateTime::toString().
+ */
+class UBUNTUTOOLKIT_EXPORT DateTimeFormat
+{
+public:
+    DateTimeFormat() {}
+    explicit DateTimeFormat(const QString &format);
+
+    QString format() const
+    {
+        return m_format;
+    }
+    QString toString(const QDateTime &datetime, const QLocale &locale) const;
+
+private:
+    enum TokenType {
+        Literal,
+        Day, Day2, DayName, LongDayName,
+        Month, Month2, MonthName, LongMonthName,
+        Year2, Year4,
+        Hour, Hour2, Hour24, Hour24_2,
+        Minute, Minute2,
+        Second, Second2,
+        AmPm, AmPmUpper
+    };
+    struct Token {
+        TokenType type;
+        QString text;
+    };
+
+    void parse();
+
+    QString m_format;
+    QVector<Token> m_tokens;
+    bool m_ampm = false;
+    bool m_fallback = false;
+};
+
+class UbuntuI18n;
+class UBUNTUTOOLKIT_EXPORT RelativeDateTimeFormatter
+{
+public:
+    explicit RelativeDateTimeFormatter(UbuntuI18n *i18n);
+
+    QString format(const QDateTime &datetime);
+    QString format(const QDateTime &datetime, const QDateTime &relativeTo);
+    QStringList format(const QList<QDateTime> &datetimes);
+    void invalidate();
+
+private:
+    void resolve();
+    QString minutes(qint64 minutes);
+
+    // indexed by date proximity
+    enum { FormatCount = 9 };
+
+    UbuntuI18n *m_i18n;
+    QLocale m_locale;
+    QString m_now;
+    QHash<qint64, QString> m_minutes;
+    DateTimeFormat m_formats[FormatCount];
+    bool m_resolved = false;
+};
+
+UT_NAMESPACE_END
+
+#endif // RELATIVEDATETIMEFORMATTER_P_H
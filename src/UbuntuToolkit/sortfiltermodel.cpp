@@ -100,6 +100,10 @@ UT_NAMESPACE_BEGIN
 
 QSortFilterProxyModelQML::QSortFilterProxyModelQML(QObject *parent)
     : QSortFilterProxyModel(parent)
+    , m_acceptedRowsValid(false)
+    , m_narrowing(false)
+    , m_recording(false)
+    , m_rolesValid(false)
 {
     // This is virtually always what you want in QML
     setDynamicSortFilter(true);
@@ -110,6 +114,126 @@ QSortFilterProxyModelQML::QSortFilterProxyModelQML(QObject *parent)
     connect(&m_sortBehavior, &SortBehavior::orderChanged, this, &QSortFilterProxyModelQML::sortChangedInternal);
     connect(&m_filterBehavior, &FilterBehavior::propertyChanged, this, &QSortFilterProxyModelQML::filterChangedInternal);
     connect(&m_filterBehavior, &FilterBehavior::patternChanged, this, &QSortFilterProxyModelQML::filterChangedInternal);
+
+    // the rows returned by get() are cached until the proxy changes
+    connect(this, &QAbstractItemModel::dataChanged, this, &QSortFilterProxyModelQML::invalidateRowCache);
+    connect(this, &QAbstractItemModel::rowsInserted, this, &QSortFilterProxyModelQML::invalidateRowCache);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &QSortFilterProxyModelQML::invalidateRowCache);
+    connect(this, &QAbstractItemModel::rowsMoved, this, &QSortFilterProxyModelQML::invalidateRowCache);
+    connect(this, &QAbstractItemModel::layoutChanged, this, &QSortFilterProxyModelQML::invalidateRowCache);
+    connect(this, &QAbstractItemModel::modelReset, this, &QSortFilterProxyModelQML::invalidateRowCache);
+}
+
+/*
+ * Patterns without any special characters other than the anchors are matched
+ * as plain strings, the rest is compiled into a QRegularExpression.
+ */
+QSortFilterProxyModelQML::FilterMatcher::FilterMatcher(const QRegExp &pattern)
+    : caseSensitivity(pattern.caseSensitivity())
+{
+    QString source = pattern.pattern();
+    if (source.isEmpty()) {
+        kind = MatchAll;
+        return;
+    }
+    switch (pattern.patternSyntax()) {
+    case QRegExp::FixedString:
+        kind = Contains;
+        literal = source;
+        return;
+    case QRegExp::RegExp:
+    case QRegExp::RegExp2:
+        break;
+    default:
+        kind = FilterRegExp;
+        return;
+    }
+
+    bool anchoredStart = source.startsWith(QLatin1Char('^'));
+    bool anchoredEnd = false;
+    bool isLiteral = true;
+    static const QString special = QStringLiteral("\\^$.|?*+()[]{}");
+    for (int i = anchoredStart ? 1 : 0; i < source.size() && isLiteral; i++) {
+        const QChar c = source.at(i);
+        if (c == QLatin1Char('\\')) {
+            // only escaped special characters are literals
+            if (i + 1 < source.size() && special.contains(source.at(i + 1))) {
+                literal.append(source.at(++i));
+            } else {
+                isLiteral = false;
+            }
+        } else if (c == QLatin1Char('$') && i == source.size() - 1) {
+            anchoredEnd = true;
+        } else if (special.contains(c)) {
+            isLiteral = false;
+        } else {
+            literal.append(c);
+        }
+    }
+
+    if (isLiteral) {
+        kind = anchoredStart ? (anchoredEnd ? Exact : StartsWith) : (anchoredEnd ? EndsWith : Contains);
+        if (kind == Contains && literal.isEmpty()) {
+            kind = MatchAll;
+        }
+        return;
+    }
+
+    literal.clear();
+    regularExpression = QRegularExpression(source, caseSensitivity == Qt::CaseInsensitive
+                                           ? QRegularExpression::CaseInsensitiveOption
+                                           : QRegularExpression::NoPatternOption);
+    if (regularExpression.isValid()) {
+        kind = RegularExpression;
+        // compile and JIT optimize right away rather than on the first matches
+        regularExpression.optimize();
+    } else {
+        kind = FilterRegExp;
+    }
+}
+
+bool QSortFilterProxyModelQML::FilterMatcher::matches(const QString &text) const
+{
+    switch (kind) {
+    case MatchAll:
+        return true;
+    case Contains:
+        return text.contains(literal, caseSensitivity);
+    case StartsWith:
+        return text.startsWith(literal, caseSensitivity);
+    case EndsWith:
+        return text.endsWith(literal, caseSensitivity);
+    case Exact:
+        return text.compare(literal, caseSensitivity) == 0;
+    case RegularExpression:
+        return regularExpression.match(text).hasMatch();
+    default:
+        return false;
+    }
+}
+
+// Returns true if all the texts matching this also match the other matcher,
+// like when a character gets typed at the end of a filter.
+bool QSortFilterProxyModelQML::FilterMatcher::narrows(const FilterMatcher &other) const
+{
+    if (other.kind < Contains || other.kind > Exact || kind < Contains || kind > Exact) {
+        return false;
+    }
+    if (caseSensitivity == Qt::CaseInsensitive && other.caseSensitivity == Qt::CaseSensitive) {
+        return false;
+    }
+    if (kind == Exact) {
+        return other.matches(literal);
+    }
+    if (other.kind == Contains) {
+        return literal.contains(other.literal, other.caseSensitivity);
+    }
+    if (other.kind == kind) {
+        return kind == StartsWith
+                ? literal.startsWith(other.literal, other.caseSensitivity)
+                : literal.endsWith(other.literal, other.caseSensitivity);
+    }
+    return false;
 }
 
 int
@@ -185,11 +309,41 @@ QSortFilterProxyModelQML::sortChangedInternal()
 void
 QSortFilterProxyModelQML::filterChangedInternal()
 {
-    setFilterRole(roleByName(m_filterBehavior.property()));
+    const int role = roleByName(m_filterBehavior.property());
+    FilterMatcher matcher(m_filterBehavior.pattern());
+    // only the rows accepted so far need to be checked if the new pattern
+    // is more specific than the previous one
+    m_narrowing = m_acceptedRowsValid && role == filterRole() && matcher.narrows(m_matcher);
+    m_matcher = matcher;
+
+    const int rows = sourceModel() ? sourceModel()->rowCount() : 0;
+    m_testedRows = QBitArray(rows);
+    if (!m_narrowing) {
+        m_acceptedRows = QBitArray(rows);
+    }
+    m_recording = true;
+    setFilterRole(role);
     setFilterRegExp(m_filterBehavior.pattern());
+    m_recording = false;
+    m_narrowing = false;
+    // the proxy only filters the rows it has a mapping for
+    m_acceptedRowsValid = m_matcher.kind != FilterMatcher::MatchAll
+            && rows > 0 && m_testedRows.count(true) == rows;
     Q_EMIT filterChanged();
 }
 
+void
+QSortFilterProxyModelQML::invalidateAcceptedRows()
+{
+    m_acceptedRowsValid = false;
+}
+
+void
+QSortFilterProxyModelQML::invalidateRowCache()
+{
+    m_rowCache.clear();
+}
+
 QHash<int, QByteArray> QSortFilterProxyModelQML::roleNames() const
 {
     return sourceModel() ? sourceModel()->roleNames() : QHash<int, QByteArray>();
@@ -213,6 +367,19 @@ QSortFilterProxyModelQML::setModel(QAbstractItemModel *itemModel)
         }
 
         setSourceModel(itemModel);
+        invalidateAcceptedRows();
+        m_rolesValid = false;
+        invalidateRowCache();
+        // the accepted rows are indexed by source row
+        connect(itemModel, &QAbstractItemModel::dataChanged, this, &QSortFilterProxyModelQML::invalidateAcceptedRows);
+        connect(itemModel, &QAbstractItemModel::rowsInserted, this, &QSortFilterProxyModelQML::invalidateAcceptedRows);
+        connect(itemModel, &QAbstractItemModel::rowsRemoved, this, &QSortFilterProxyModelQML::invalidateAcceptedRows);
+        connect(itemModel, &QAbstractItemModel::rowsMoved, this, &QSortFilterProxyModelQML::invalidateAcceptedRows);
+        connect(itemModel, &QAbstractItemModel::layoutChanged, this, &QSortFilterProxyModelQML::invalidateAcceptedRows);
+        connect(itemModel, &QAbstractItemModel::modelReset, this, [this]() {
+            invalidateAcceptedRows();
+            m_rolesValid = false;
+        });
         // Roles mapping to role names may change
         setSortRole(roleByName(m_sortBehavior.property()));
         setFilterRole(roleByName(m_filterBehavior.property()));
@@ -223,12 +390,32 @@ QSortFilterProxyModelQML::setModel(QAbstractItemModel *itemModel)
 QVariantMap
 QSortFilterProxyModelQML::get(int row)
 {
+    auto cached = m_rowCache.constFind(row);
+    if (cached != m_rowCache.constEnd()) {
+        return *cached;
+    }
+    if (!m_rolesValid) {
+        m_roles.clear();
+        const QHash<int, QByteArray> roles = roleNames();
+        QHashIterator<int, QByteArray> i(roles);
+        while (i.hasNext()) {
+            i.next();
+            m_roles.append(qMakePair(QString::fromUtf8(i.value()), i.key()));
+        }
+        m_rolesValid = true;
+    }
+
     QVariantMap res;
-    const QHash<int, QByteArray> roles = roleNames();
-    QHashIterator<int, QByteArray> i(roles);
-    while (i.hasNext()) {
-        i.next();
-        res.insert(QString::fromUtf8(i.value()), index(row, 0).data(i.key()));
+    const QModelIndex rowIndex = index(row, 0);
+    for (const QPair<QString, int> &role : m_roles) {
+        res.insert(role.first, rowIndex.data(role.second));
+    }
+    if (rowIndex.isValid()) {
+        // keep the cache bounded for views scrolling through large models
+        if (m_rowCache.size() >= 1024) {
+            m_rowCache.clear();
+        }
+        m_rowCache.insert(row, res);
     }
     return res;
 }
@@ -243,11 +430,25 @@ bool
 QSortFilterProxyModelQML::filterAcceptsRow(int sourceRow,
                                            const QModelIndex &sourceParent) const
 {
-    if (filterRegExp().isEmpty()) {
+    if (m_matcher.kind == FilterMatcher::MatchAll) {
         return true;
     }
 
-    bool result = QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    const bool record = m_recording && !sourceParent.isValid() && sourceRow < m_testedRows.size();
+    bool result;
+    if (record && m_narrowing && !m_acceptedRows.testBit(sourceRow)) {
+        // rejected by the previous, less specific pattern
+        result = false;
+    } else if (m_matcher.kind == FilterMatcher::FilterRegExp || filterKeyColumn() < 0) {
+        result = QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    } else {
+        const QModelIndex source = sourceModel()->index(sourceRow, filterKeyColumn(), sourceParent);
+        result = m_matcher.matches(source.data(filterRole()).toString());
+    }
+    if (record) {
+        m_testedRows.setBit(sourceRow);
+        m_acceptedRows.setBit(sourceRow, result);
+    }
     return result;
 }
 
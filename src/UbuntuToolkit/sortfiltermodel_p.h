@@ -21,7 +21,10 @@
 #ifndef SORTFILTERMODEL_P_H
 #define SORTFILTERMODEL_P_H
 
+#include <QtCore/QBitArray>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QSortFilterProxyModel>
+#include <QtCore/QVector>
 
 #include <UbuntuToolkit/private/sortbehavior_p.h>
 #include <UbuntuToolkit/private/filterbehavior_p.h>
@@ -63,6 +66,30 @@ Q_SIGNALS:
     void filterChanged();
 
 private:
+    // the filter pattern compiled into a literal match or a QRegularExpression
+    struct FilterMatcher {
+        enum Kind {
+            MatchAll,
+            Contains,
+            StartsWith,
+            EndsWith,
+            Exact,
+            RegularExpression,
+            // patterns QRegularExpression cannot handle, matched by QSortFilterProxyModel
+            FilterRegExp
+        };
+
+        FilterMatcher() {}
+        explicit FilterMatcher(const QRegExp &pattern);
+        bool matches(const QString &text) const;
+        bool narrows(const FilterMatcher &other) const;
+
+        Kind kind = MatchAll;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+        QString literal;
+        QRegularExpression regularExpression;
+    };
+
     SortBehavior m_sortBehavior;
     SortBehavior* sortBehavior();
     void sortChangedInternal();
@@ -70,6 +97,19 @@ private:
     FilterBehavior* filterBehavior();
     void filterChangedInternal();
     int roleByName(const QString& roleName) const;
+    void invalidateAcceptedRows();
+    void invalidateRowCache();
+
+    FilterMatcher m_matcher;
+    // source rows accepted by the last filter pass, to narrow down the next one
+    mutable QBitArray m_acceptedRows;
+    mutable QBitArray m_testedRows;
+    QVector<QPair<QString, int> > m_roles;
+    QHash<int, QVariantMap> m_rowCache;
+    bool m_acceptedRowsValid:1;
+    bool m_narrowing:1;
+    bool m_recording:1;
+    bool m_rolesValid:1;
 };
 
 UT_NAMESPACE_END
@@ -18,10 +18,12 @@
 
 #include "splitview_p_p.h"
 
+#include <QtCore/QVarLengthArray>
 #include <QtQml/QQmlInfo>
 #include <QtQuick/private/qquickanchors_p.h>
 #include <QtQuick/private/qquickitem_p.h>
 
+#include "ucmathutils_p.h"
 #include "ucunits_p.h"
 #include "ucpagetreenode_p.h"
 #include "privates/splitviewhandler_p.h"
@@ -272,6 +274,7 @@ void SplitViewPrivate::layout_Append(QQmlListProperty<SplitViewLayout> *list, Sp
     SplitView *view = static_cast<SplitView*>(list->object);
     SplitViewPrivate *d = SplitViewPrivate::get(view);
     d->columnLatouts.append(layout);
+    d->invalidateViews();
     // parent layout to view
     layout->setParent(view);
     // capture layout activation
@@ -301,6 +304,7 @@ void SplitViewPrivate::layout_Clear(QQmlListProperty<SplitViewLayout> *list)
     }
     d->columnLatouts.clear();
     d->activeLayout = nullptr;
+    d->invalidateViews();
     Q_EMIT view->layoutsChanged();
 }
 QQmlListProperty<SplitViewLayout> SplitViewPrivate::layouts()
@@ -342,6 +346,7 @@ void SplitViewPrivate::changeLayout()
     // Q: should we reset the sizes of the previous layout?
     // at least it feels  right to preserve the last state of the layout...
     activeLayout = newActive;
+    invalidateViews();
 
     Q_EMIT q_func()->activeLayoutChanged();
 
@@ -371,6 +376,75 @@ void SplitViewPrivate::updateLayout()
     }
 }
 
+// Returns the views configured by the active layout. The attached configuration
+// lookup is cached until the views or the layouts change.
+const QVector<SplitViewPrivate::ConfiguredView> &SplitViewPrivate::configuredViews()
+{
+    if (viewsDirty) {
+        viewCache.clear();
+        for (QQuickItem *child : q_func()->childItems()) {
+            ViewColumn *config = SplitViewAttachedPrivate::getConfig(child);
+            if (config) {
+                viewCache.append({child, config});
+            }
+        }
+        viewsDirty = false;
+    }
+    return viewCache;
+}
+
+/*
+ * Distributes the width between the columns. Columns not filling the width take
+ * their preferred width, the rest is shared evenly between the fill columns
+ * within their minimum and maximum limits. Fill columns hitting their limits are
+ * fixed at those limits and the difference is redistributed between the remaining
+ * ones, so the columns take the whole width whenever the limits allow it.
+ */
+void SplitViewPrivate::solveWidths(const QVector<ColumnConstraint> &columns, qreal width, QVector<qreal> *widths)
+{
+    const int count = columns.size();
+    widths->resize(count);
+    QVarLengthArray<int, 8> fill;
+    for (int i = 0; i < count; ++i) {
+        const ColumnConstraint &column = columns[i];
+        if (column.fillWidth) {
+            fill.append(i);
+        } else {
+            (*widths)[i] = column.preferredWidth;
+            width -= column.preferredWidth;
+        }
+    }
+
+    // freeze the columns violating their limits in the direction of the total
+    // violation and redistribute the rest, until the share fits all free columns
+    while (!fill.isEmpty()) {
+        const qreal share = width / fill.size();
+        qreal violation = 0.0;
+        for (int index : fill) {
+            violation += UCMathUtils::clamp(share, columns[index].minimumWidth, columns[index].maximumWidth) - share;
+        }
+        bool frozen = false;
+        for (int i = 0; i < fill.size();) {
+            const ColumnConstraint &column = columns[fill[i]];
+            const qreal clamped = UCMathUtils::clamp(share, column.minimumWidth, column.maximumWidth);
+            if (clamped != share && (violation == 0.0 || (violation > 0.0) == (clamped > share))) {
+                (*widths)[fill[i]] = clamped;
+                width -= clamped;
+                fill.remove(i);
+                frozen = true;
+            } else {
+                i++;
+            }
+        }
+        if (!frozen) {
+            for (int index : fill) {
+                (*widths)[index] = share;
+            }
+            break;
+        }
+    }
+}
+
 void SplitViewPrivate::recalculateWidths(RelayoutOperation operation)
 {
     if (!activeLayout || (!QQuickItemPrivate::get(q_func())->componentComplete && !dirty)) {
@@ -378,43 +452,33 @@ void SplitViewPrivate::recalculateWidths(RelayoutOperation operation)
     }
     Q_Q(SplitView);
 
+    const QVector<ConfiguredView> &views = configuredViews();
+    constraints.resize(views.size());
+    for (int i = 0; i < views.size(); ++i) {
+        ViewColumnPrivate *config = ViewColumnPrivate::get(views[i].config);
+        constraints[i] = {
+            config->minimumWidth,
+            config->maximumWidth,
+            config->preferredWidth,
+            config->fillWidth && !config->resized
+        };
+    }
+
     // remove the spacing from the width
-    qreal fillWidth = q->width() - q->spacing() * (SplitViewLayoutPrivate::get(activeLayout)->columnData.size() - 1);
-    // stack of columns with fillWidth true
-    QList<QQuickItem*> fillStack;
+    qreal width = q->width() - q->spacing() * (SplitViewLayoutPrivate::get(activeLayout)->columnData.size() - 1);
+    solveWidths(constraints, width, &widths);
 
-    for (QQuickItem *child : q->childItems()) {
-        ViewColumn *columnConfig = SplitViewAttachedPrivate::getConfig(child);
-        if (!columnConfig) {
+    for (int i = 0; i < views.size(); ++i) {
+        if (!(operation & (constraints[i].fillWidth ? CalculateFillWidth : SetPreferredSize))) {
             continue;
         }
-        ViewColumnPrivate *config = ViewColumnPrivate::get(columnConfig);
-
-        if (config->fillWidth && !config->resized) {
-            // add to the fillWidth stack
-            if (operation & CalculateFillWidth) {
-                fillStack << child;
-            }
-        } else {
-            if (operation & SetPreferredSize) {
-                child->setWidth(config->preferredWidth);
-            }
-            if (operation & CalculateFillWidth) {
-                fillWidth -= config->preferredWidth;
-            }
-        }
-    }
-
-    // split the width between the stacked fillWidth columns
-    if (fillStack.size() && (operation & CalculateFillWidth)) {
-        fillWidth /= fillStack.size();
-        for (QQuickItem *child : fillStack) {
-            // even though the column is fillWidth, it may have min and max specified;
-            // check if the size can be applied
-            ViewColumnPrivate *config = ViewColumnPrivate::get(SplitViewAttachedPrivate::getConfig(child));
-            config->setPreferredWidth(fillWidth, false);
+        if (constraints[i].fillWidth) {
             // update preferredWidth so it can be used in case of resize
-            child->setWidth(config->preferredWidth);
+            ViewColumnPrivate::get(views[i].config)->setPreferredWidth(widths[i], false);
+        }
+        QQuickItem *child = views[i].item;
+        if (child->width() != widths[i]) {
+            child->setWidth(widths[i]);
         }
     }
     dirty = false;
@@ -639,6 +703,7 @@ void SplitView::itemChange(ItemChange change, const ItemChangeData &data)
 
             Q_D(SplitView);
             SplitViewAttachedPrivate::get(attached)->configure(this, d->viewCount++);
+            d->invalidateViews();
 
             // attach the split handler to it
             SplitViewHandler *handler = new SplitViewHandler(data.item);
@@ -649,6 +714,7 @@ void SplitView::itemChange(ItemChange change, const ItemChangeData &data)
         if (data.item && !data.item->inherits("QQuickRepeater")) {
             Q_D(SplitView);
             d->viewCount--;
+            d->invalidateViews();
         }
         break;
     default: // ommit the rest
@@ -21,6 +21,7 @@
 
 #include <UbuntuToolkit/private/splitview_p.h>
 
+#include <QtCore/QVector>
 #include <QtCore/private/qobject_p.h>
 
 UT_NAMESPACE_BEGIN
@@ -64,6 +65,7 @@ public:
     }
 
     QQmlListProperty<UT_PREPEND_NAMESPACE(ViewColumn)> columns();
+    void invalidateView();
 
     QList<ViewColumn*> columnData;
     bool when{false};
@@ -102,7 +104,7 @@ public:
     int column{-1};
 };
 
-class SplitViewPrivate
+class UBUNTUTOOLKIT_EXPORT SplitViewPrivate
 {
     SplitView *const q_ptr{nullptr};
     Q_DECLARE_PUBLIC(SplitView)
@@ -114,6 +116,19 @@ public:
         RecalculateAll = 0xFF
     };
 
+    // width constraints of a column, as seen by the width solver
+    struct ColumnConstraint {
+        qreal minimumWidth;
+        qreal maximumWidth;
+        qreal preferredWidth;
+        bool fillWidth;
+    };
+    // a view and its configuration in the active layout
+    struct ConfiguredView {
+        QQuickItem *item;
+        ViewColumn *config;
+    };
+
     SplitViewPrivate(SplitView *qq);
     virtual ~SplitViewPrivate();
     void init();
@@ -129,6 +144,12 @@ public:
 
     void updateLayout();
     void recalculateWidths(RelayoutOperation operation);
+    static void solveWidths(const QVector<ColumnConstraint> &columns, qreal width, QVector<qreal> *widths);
+    const QVector<ConfiguredView> &configuredViews();
+    void invalidateViews()
+    {
+        viewsDirty = true;
+    }
     void setHandle(QQmlComponent *delegate);
 
     // private slots
@@ -139,8 +160,12 @@ public:
     SplitViewLayout* activeLayout{nullptr};
     QQmlComponent *handleDelegate{nullptr};
     QMetaObject::Connection *defaultSpacing{nullptr};
+    QVector<ConfiguredView> viewCache;
+    QVector<ColumnConstraint> constraints;
+    QVector<qreal> widths;
     int viewCount{0};
     bool dirty{false};
+    bool viewsDirty{true};
 
 private:
     static void layout_Append(QQmlListProperty<SplitViewLayout> *, SplitViewLayout*);
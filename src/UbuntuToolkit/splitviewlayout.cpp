@@ -194,6 +194,15 @@ SplitViewLayout::SplitViewLayout(QObject *parent)
 {
 }
 
+// drops the view configuration lookups cached by the SplitView owning the layout
+void SplitViewLayoutPrivate::invalidateView()
+{
+    SplitView *view = qobject_cast<SplitView*>(parent);
+    if (view) {
+        SplitViewPrivate::get(view)->invalidateViews();
+    }
+}
+
 void SplitViewLayoutPrivate::columns_Append(QQmlListProperty<ViewColumn> *list, ViewColumn* data)
 {
     SplitViewLayout *layout = static_cast<SplitViewLayout*>(list->object);
@@ -202,6 +211,7 @@ void SplitViewLayoutPrivate::columns_Append(QQmlListProperty<ViewColumn> *list,
     // make sure ViewColumn is parented to the layout definition
     data->setParent(layout);
     d->columnData.append(data);
+    d->invalidateView();
     Q_EMIT layout->columnsChanged();
 }
 int SplitViewLayoutPrivate::columns_Count(QQmlListProperty<ViewColumn> *list)
@@ -222,6 +232,7 @@ void SplitViewLayoutPrivate::columns_Clear(QQmlListProperty<ViewColumn> *list)
     SplitViewLayoutPrivate *d = SplitViewLayoutPrivate::get(layout);
     qDeleteAll(d->columnData);
     d->columnData.clear();
+    d->invalidateView();
     Q_EMIT layout->columnsChanged();
 }
 
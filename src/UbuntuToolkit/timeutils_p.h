@@ -120,6 +120,27 @@ inline date_proximity_t getDateProximity(const QDateTime& now, const QDateTime&
    }
 }
 
+/* Returns the time in milliseconds since epoch at which the proximity of time to
+   now changes next. Within an hour it changes when crossing the 30 seconds and one
+   hour bounds, otherwise the day based proximities can only change at midnight. */
+inline qint64 nextDateProximityChange(const QDateTime& now, const QDateTime& time)
+{
+   qint64 nowMs = now.toMSecsSinceEpoch();
+   qint64 timeMs = time.toMSecsSinceEpoch();
+   qint64 next = QDateTime(now.date().addDays(1), QTime(0, 0, 0, 0)).toMSecsSinceEpoch();
+
+   // |diff| < bound starts 1ms after (time - bound) and ends at (time + bound)
+   const qint64 bounds[] = {
+       timeMs - 3600000 + 1, timeMs - 30000 + 1, timeMs + 30000, timeMs + 3600000
+   };
+   for (int i = 0; i < 4; i++) {
+       if (bounds[i] > nowMs && bounds[i] < next) {
+           next = bounds[i];
+       }
+   }
+   return next;
+}
+
 inline LiveTimer::Frequency frequencyForProximity(date_proximity_t proximity) {
     switch(proximity) {
         case DATE_PROXIMITY_NOW:
@@ -16,6 +16,12 @@
 
 #include "tree_p.h"
 
+#include <algorithm>
+
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QVector>
 #include <QtCore/private/qobject_p.h>
 #include <QtQml/QQmlEngine>
 
@@ -24,14 +30,66 @@ UT_NAMESPACE_BEGIN
 class TreePrivate : public QObjectPrivate
 {
 public:
-    // list<object> of nodes
-    QList<QObject*> m_nodes;
-    // list<int> of parent nodes
-    QList<QObject*> m_parents;
-    // list<int> of stems
-    QList<int> m_stems;
+    struct Node {
+        QObject *node;
+        QObject *parent;
+        int stem;
+    };
+
+    QList<QObject*> removeFrom(int from, int stem);
+
+    // nodes in the order they were added
+    QVector<Node> m_nodes;
+    // position of each node in m_nodes
+    QHash<QObject*, int> m_positions;
+    // ascending positions of the nodes of each stem
+    QMap<int, QVector<int> > m_stems;
 };
 
+// Removes the nodes at or after position from in the specified stem and higher
+// stems, and compacts the remaining ones. Only the nodes after the first removed
+// one are touched, which are the last added ones when pages are pushed and popped.
+QList<QObject *> TreePrivate::removeFrom(int from, int stem)
+{
+    QList<QObject *> removedNodes;
+
+    int first = m_nodes.size();
+    for (auto it = m_stems.lowerBound(stem); it != m_stems.end(); ++it) {
+        auto position = std::lower_bound(it->constBegin(), it->constEnd(), from);
+        if (position != it->constEnd()) {
+            first = qMin(first, *position);
+        }
+    }
+    if (first == m_nodes.size()) {
+        return removedNodes;
+    }
+
+    // the positions from first on get rewritten
+    for (auto it = m_stems.begin(); it != m_stems.end(); ++it) {
+        while (!it->isEmpty() && it->last() >= first) {
+            it->removeLast();
+        }
+    }
+    int size = first;
+    for (int i = first; i < m_nodes.size(); i++) {
+        const Node node = m_nodes.at(i);
+        if (node.stem >= stem) {
+            removedNodes.push_back(node.node);
+            m_positions.remove(node.node);
+        } else {
+            m_nodes[size] = node;
+            m_positions[node.node] = size;
+            m_stems[node.stem].push_back(size);
+            size++;
+        }
+    }
+    m_nodes.resize(size);
+    for (auto it = m_stems.begin(); it != m_stems.end();) {
+        it = it->isEmpty() ? m_stems.erase(it) : it + 1;
+    }
+    return removedNodes;
+}
+
 Tree::Tree(QObject *parent) :
     QObject((*new TreePrivate), parent)
 {
@@ -42,7 +100,7 @@ Tree::Tree(QObject *parent) :
 // Returns -1 the node was not found.
 int Tree::index(QObject *node) const
 {
-    return d_func()->m_nodes.indexOf(node);
+    return d_func()->m_positions.value(node, -1);
 }
 
 // Add newNode to the tree in the specified stem, with the specified parent node.
@@ -74,9 +132,9 @@ bool Tree::add(const int stem, QObject *parentNode, QObject *newNode)
         }
     }
 
-    d->m_nodes.push_back(newNode);
-    d->m_stems.push_back(stem);
-    d->m_parents.push_back(parentNode);
+    d->m_positions.insert(newNode, d->m_nodes.size());
+    d->m_stems[stem].push_back(d->m_nodes.size());
+    d->m_nodes.push_back(TreePrivate::Node{newNode, parentNode, stem});
     return true;
 }
 
@@ -86,25 +144,7 @@ bool Tree::add(const int stem, QObject *parentNode, QObject *newNode)
 QList<QObject *> Tree::prune(const int stem)
 {
     Q_D(Tree);
-    QList<QObject *> newNodes;
-    QList<QObject *> newParents;
-    QList<QObject *> removedNodes;
-    QList<int> newStems;
-
-    for (int i = 0; i < d->m_nodes.length(); i++) {
-        if (d->m_stems[i] < stem) {
-            newNodes.push_back(d->m_nodes.at(i));
-            newStems.push_back(d->m_stems.at(i));
-            newParents.push_back(d->m_parents.at(i));
-        } else  {
-            removedNodes.push_back(d->m_nodes.at(i));
-        }
-    }
-
-    d->m_nodes = newNodes;
-    d->m_parents = newParents;
-    d->m_stems = newStems;
-    return removedNodes;
+    return d->removeFrom(0, stem);
 }
 
 // Chops all nodes with an index higher than the given node which
@@ -142,35 +182,10 @@ QList<QObject *> Tree::chop(const QVariant &jsNode, const QVariant &jsInclusive)
         size = nodeIndex + 1;
     }
 
-    // Nodes with index(node) >= nodeIndex && stem >= stems[nodeIndex];
-    QList<QObject *> badNodes; // to fill below
-
-    // Nodes with index(node) >= nodeIndex (any stem).
-    // Potential bad nodes to be removed.
-    QList<QObject *> uglyNodes = d->m_nodes.mid(size);
-    QList<QObject *> uglyParents = d->m_parents.mid(size);
-    QList<int> uglyStems = d->m_stems.mid(size); // to check below
-
-    int stem = d->m_stems[nodeIndex];
-    // Good nodes, with index(node) < nodeIndex && stem < stems[nodeIndex]:
-    d->m_nodes = d->m_nodes.mid(0, size);
-    d->m_stems = d->m_stems.mid(0, size);
-    d->m_parents = d->m_parents.mid(0, size);
-
-    // Add nodes with index(node) > nodeIndex && stem < stems[nodeIndex] back:
-    for (int i = 0; i < uglyNodes.length(); i++) {
-        if (uglyStems.at(i) < stem) {
-            // Because the stem of the parentNode <= stem of the node,
-            //  the node that is added back has the parentNode in nodes.
-            d->m_nodes.push_back(uglyNodes.at(i));
-            d->m_stems.push_back(uglyStems.at(i));
-            d->m_parents.push_back(uglyParents.at(i));
-        } else {
-            badNodes.push_back(uglyNodes.at(i));
-        }
-    }
-    return badNodes;
-
+    // Remove the nodes with index(node) >= size && stem >= stems[nodeIndex].
+    // Because the stem of the parentNode <= stem of the node, the parents of
+    // the nodes that are kept stay in the tree.
+    return d->removeFrom(size, d->m_nodes.at(nodeIndex).stem);
 }
 
 // Returns the n'th node when traversing one or more stems from the
@@ -201,18 +216,39 @@ QObject *Tree::top(const QVariant &jsStem, const QVariant &jsExactMatch, const Q
     if (jsN.isValid() && jsN.canConvert<int>())
         n = jsN.value<int>();
 
-    int st;
+    if (d->m_nodes.isEmpty()) {
+        return nullptr;
+    }
+    if (n < 0) {
+        return d->m_nodes.last().node;
+    }
+    if (exactMatch) {
+        const QVector<int> positions = d->m_stems.value(stem);
+        return n < positions.size() ? d->m_nodes.at(positions.at(positions.size() - 1 - n)).node : nullptr;
+    }
+
+    // walk the matching stems backwards, always taking the latest added node
+    QVarLengthArray<QPair<const QVector<int>*, int>, 4> stems;
+    for (auto it = d->m_stems.lowerBound(stem); it != d->m_stems.end(); ++it) {
+        stems.append(qMakePair(&it.value(), it->size() - 1));
+    }
     int count = n;
-    for (int i = d->m_nodes.size() - 1; i >= 0; i--) {
-        st = d->m_stems[i];
-        if ((exactMatch && st == stem) || (!exactMatch && st >= stem)) {
-            count--;
+    while (true) {
+        int latest = -1;
+        for (int i = 0; i < stems.size(); i++) {
+            if (stems[i].second >= 0 && (latest < 0
+                    || stems[i].first->at(stems[i].second) > stems[latest].first->at(stems[latest].second))) {
+                latest = i;
+            }
+        }
+        if (latest < 0) {
+            return nullptr;
         }
-        if (count < 0) {
-            return d->m_nodes.at(i);
+        if (count-- == 0) {
+            return d->m_nodes.at(stems[latest].first->at(stems[latest].second)).node;
         }
+        stems[latest].second--;
     }
-    return nullptr;
 }
 
 // Return the parent node of the specified node in the tree
@@ -225,7 +261,7 @@ QObject *Tree::parent(QObject *node) const
         || i == 0 ) { //Root node has no parent node.
         return nullptr;
     }
-    return d->m_parents.at(i);
+    return d->m_nodes.at(i).parent;
 }
 
 UT_NAMESPACE_END
@@ -23,6 +23,7 @@
 
 #include <stdexcept>
 
+#include <QtCore/QMutex>
 #include <QtQml/QQmlContext>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlExtensionPlugin>
@@ -31,6 +32,7 @@
 #include <QtGui/QGuiApplication>
 #include <QtGui/QScreen>
 #include <UbuntuMetrics/applicationmonitor.h>
+#include <UbuntuMetrics/private/tracing_p.h>
 
 #include "actionlist_p.h"
 #include "colorutils_p.h"
@@ -106,6 +108,43 @@ UT_NAMESPACE_BEGIN
 static const QString notInstantiatable = QStringLiteral("Not instantiatable");
 static const char engineProperty[] = "__ubuntu_toolkit_plugin_data";
 
+/*
+ * Image provider creating the actual provider when the first image is requested.
+ * Image requests may come from the image reader thread, hence the lock.
+ */
+template<class Provider>
+class DeferredImageProvider : public QQuickImageProvider
+{
+public:
+    DeferredImageProvider()
+        : QQuickImageProvider(QQuickImageProvider::Image)
+    {
+    }
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_provider) {
+            m_provider.reset(new Provider);
+        }
+        lock.unlock();
+        return m_provider->requestImage(id, size, requestedSize);
+    }
+
+private:
+    QMutex m_mutex;
+    QScopedPointer<Provider> m_provider;
+};
+
+template<class Provider>
+static QQuickImageProvider *createImageProvider(bool deferred)
+{
+    if (deferred) {
+        return new DeferredImageProvider<Provider>;
+    }
+    return new Provider;
+}
+
 /******************************************************************************
  * UbuntuToolkitModule
  */
@@ -147,13 +186,18 @@ void UbuntuToolkitModule::setWindowContextProperty(QWindow* focusWindow)
 
 void UbuntuToolkitModule::initializeContextProperties(QQmlEngine *engine)
 {
+    UMTracing::beginSpan("units");
     UCUnits::instance(engine);
+    UMTracing::endSpan("units");
     QuickUtils::instance(engine);
     UbuntuI18n::instance(engine);
     UCApplication::instance(engine);
     UCFontUtils::instance(engine);
+    UMTracing::beginSpan("theme");
     UCTheme::defaultTheme(engine);
+    UMTracing::endSpan("theme");
 
+    UMTracingSpan span("contextProperties");
     QQmlContext* context = engine->rootContext();
 
     // register root object watcher that sets a global property with the root object
@@ -252,11 +296,26 @@ QUrl UbuntuToolkitModule::baseUrl(QQmlEngine *engine)
     return !data ? QUrl() : data->m_baseUrl;
 }
 
+/*
+ * Deferred initialization is turned on by setting UC_DEFERRED_INITIALIZATION in
+ * the environment. The image providers are then only created when the first image
+ * is requested, and the application monitor is only instantiated when metrics
+ * logging or the overlay are requested. The context properties are still set up
+ * right away, as QML bindings resolve them at compilation time.
+ */
+bool UbuntuToolkitModule::deferredInitialization()
+{
+    return qEnvironmentVariableIsSet("UC_DEFERRED_INITIALIZATION");
+}
+
 void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &pluginBaseUrl)
 {
+    UMTracingSpan span("initializeModule");
     UbuntuToolkitModule *module = create(engine, pluginBaseUrl);
+    const bool deferred = deferredInitialization();
 
     // Register private types.
+    UMTracing::beginSpan("registerPrivateTypes");
     const char *privateUri = "Ubuntu.Components.Private";
     qmlRegisterType<UCFrame>(privateUri, 1, 3, "Frame");
     qmlRegisterType<UCPageWrapper>(privateUri, 1, 3, "PageWrapper");
@@ -265,16 +324,21 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
 
     //FIXME: move to a more generic location, i.e StyledItem or QuickUtils
     qmlRegisterSimpleSingletonType<UCScrollbarUtils>(privateUri, 1, 3, "PrivateScrollbarUtils");
+    UMTracing::endSpan("registerPrivateTypes");
 
     // allocate all context property objects prior we register them
     initializeContextProperties(engine);
 
     HapticsProxy::instance(engine);
 
-    engine->addImageProvider(QLatin1String("scaling"), new UCScalingImageProvider);
+    UMTracing::beginSpan("imageProviders");
+    engine->addImageProvider(
+        QLatin1String("scaling"), createImageProvider<UCScalingImageProvider>(deferred));
 
     // register icon provider
-    engine->addImageProvider(QLatin1String("theme"), new UnityThemeIconProvider);
+    engine->addImageProvider(
+        QLatin1String("theme"), createImageProvider<UnityThemeIconProvider>(deferred));
+    UMTracing::endSpan("imageProviders");
 
     // Necessary for Screen.orientation (from import QtQuick.Window 2.0) to work
     QGuiApplication::primaryScreen()->setOrientationUpdateMask( Qt::ScreenOrientations(
@@ -286,6 +350,21 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
     module->registerWindowContextProperty();
 
     // Application monitoring.
+    if (!deferred
+        || qEnvironmentVariableIsSet("UC_METRICS_LOGGING_FILTER")
+        || qEnvironmentVariableIsSet("UC_METRICS_LOGGING")
+        || qEnvironmentVariableIsSet("UC_METRICS_OVERLAY")) {
+        UMTracingSpan span("applicationMonitor");
+        initializeApplicationMonitor();
+    }
+
+    // register performance monitor
+    engine->rootContext()->setContextProperty(
+        QStringLiteral("performanceMonitor"), new UCPerformanceMonitor(engine));
+}
+
+void UbuntuToolkitModule::initializeApplicationMonitor()
+{
     UMApplicationMonitor* applicationMonitor = UMApplicationMonitor::instance();
     const QString metricsLoggingFilter =
         QString::fromLocal8Bit(qgetenv("UC_METRICS_LOGGING_FILTER"));
@@ -332,14 +411,11 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
     if (qEnvironmentVariableIsSet("UC_METRICS_OVERLAY")) {
         applicationMonitor->setOverlay(true);
     }
-
-    // register performance monitor
-    engine->rootContext()->setContextProperty(
-        QStringLiteral("performanceMonitor"), new UCPerformanceMonitor(engine));
 }
 
 void UbuntuToolkitModule::defineModule()
 {
+    UMTracingSpan span("registerTypes");
     const char *uri = "Ubuntu.Components";
     // register 0.1 for backward compatibility
     registerTypesToVersion(uri, 0, 1);
@@ -57,6 +57,7 @@ public:
     static void initializeModule(QQmlEngine *engine, const QUrl &pluginBaseUrl);
     static void defineModule();
     static void undefineModule();
+    static bool deferredInitialization();
 
     // use this API only in tests!
     static void initializeContextProperties(QQmlEngine*);
@@ -66,6 +67,7 @@ private:
     void registerWindowContextProperty();
     Q_SLOT void setWindowContextProperty(QWindow* focusWindow);
     static void registerTypesToVersion(const char *uri, int major, int minor);
+    static void initializeApplicationMonitor();
 
     QUrl m_baseUrl;
 };
@@ -52,28 +52,7 @@ bool shortcutContextMatcher(QObject* object, Qt::ShortcutContext context)
         }
         bool activatable = window && window == QGuiApplication::focusWindow();
 
-        if (activatable) {
-            // is the last action owner item in an active context?
-            QQuickItem *pl = action->lastOwningItem();
-            activatable = false;
-            while (pl) {
-                UCActionContextAttached *attached = static_cast<UCActionContextAttached*>(
-                            qmlAttachedPropertiesObject<UCActionContext>(pl, false));
-                if (attached) {
-                    activatable = attached->context()->active();
-                    if (!activatable) {
-                        ACT_TRACE(action << "Inactive context found" << attached->context());
-                        break;
-                    }
-                }
-                pl = pl->parentItem();
-            }
-            if (!activatable) {
-                // check if the action is in an active context
-                UCActionContext *context = qobject_cast<UCActionContext*>(action->parent());
-                activatable = context && context->active();
-            }
-        }
+        activatable = activatable && action->isInActiveContext();
         if (activatable) {
             ACT_TRACE("SELECTED ACTION" << action);
         }
@@ -276,6 +255,7 @@ void UCAction::setMnemonicFromText(const QString &text)
 
 UCAction::UCAction(QObject *parent)
     : QObject(parent)
+    , m_contextChainGeneration(0)
     , m_exclusiveGroup(Q_NULLPTR)
     , m_itemHint(Q_NULLPTR)
     , m_parameterType(None)
@@ -656,4 +636,67 @@ void UCAction::removeOwningItem(QQuickItem *item)
     ACT_TRACE("REMOVE ACTION OWNER" << item->objectName() << "FROM" << this);
 }
 
+/*
+ * The contexts attached to the ancestors of the last owning item are resolved
+ * once and reused as long as the ancestor chain of the item is the same and no
+ * context got attached or destroyed meanwhile. Validating the chain only walks
+ * the item parents, whereas resolving it needs an attached property lookup on
+ * each level. The activity of the contexts is always read live.
+ */
+bool UCAction::isContextChainValid(QQuickItem *owner) const
+{
+    if (m_contextChainGeneration != UCActionContext::attachmentGeneration()) {
+        return false;
+    }
+    int level = 0;
+    for (QQuickItem *pl = owner; pl; pl = pl->parentItem(), level++) {
+        if (level >= m_contextChainItems.size() || m_contextChainItems.at(level) != pl) {
+            return false;
+        }
+    }
+    return level == m_contextChainItems.size();
+}
+
+void UCAction::resolveContextChain(QQuickItem *owner)
+{
+    m_contextChainItems.clear();
+    m_contextChain.clear();
+    for (QQuickItem *pl = owner; pl; pl = pl->parentItem()) {
+        m_contextChainItems.append(pl);
+        UCActionContextAttached *attached = static_cast<UCActionContextAttached*>(
+                    qmlAttachedPropertiesObject<UCActionContext>(pl, false));
+        if (attached && attached->context()) {
+            m_contextChain.append(attached->context());
+        }
+    }
+    m_contextChainGeneration = UCActionContext::attachmentGeneration();
+}
+
+/*
+ * Returns true if the last owning item of the action is in an active context,
+ * or the action is declared in an active context.
+ */
+bool UCAction::isInActiveContext()
+{
+    // is the last action owner item in an active context?
+    QQuickItem *owner = lastOwningItem();
+    if (!isContextChainValid(owner)) {
+        resolveContextChain(owner);
+    }
+    bool activatable = false;
+    Q_FOREACH(UCActionContext *context, m_contextChain) {
+        activatable = context->active();
+        if (!activatable) {
+            ACT_TRACE(this << "Inactive context found" << context);
+            break;
+        }
+    }
+    if (!activatable) {
+        // check if the action is in an active context
+        UCActionContext *context = qobject_cast<UCActionContext*>(parent());
+        activatable = context && context->active();
+    }
+    return activatable;
+}
+
 UT_NAMESPACE_END
@@ -55,6 +55,7 @@ inline void invokeTrigger(T *object, const QVariant &value)
 }
 
 class ExclusiveGroup;
+class UCActionContext;
 class UBUNTUTOOLKIT_EXPORT UCAction : public QObject
 {
     Q_OBJECT
@@ -108,6 +109,7 @@ public:
     }
     void addOwningItem(QQuickItem *item);
     void removeOwningItem(QQuickItem *item);
+    bool isInActiveContext();
 
     void setName(const QString &name);
     QString text();
@@ -156,6 +158,10 @@ public Q_SLOTS:
 
 private:
     QPODVector<QQuickItem*, 4> m_owningItems;
+    // ancestors of the last owning item and the contexts attached to them
+    QVector<QQuickItem*> m_contextChainItems;
+    QVector<UCActionContext*> m_contextChain;
+    uint m_contextChainGeneration;
     ExclusiveGroup *m_exclusiveGroup;
     QString m_name;
     QString m_text;
@@ -184,6 +190,8 @@ private:
     bool isValidType(QVariant::Type valueType);
     void generateName();
     void setMnemonicFromText(const QString &text);
+    bool isContextChainValid(QQuickItem *owner) const;
+    void resolveContextChain(QQuickItem *owner);
     bool event(QEvent *event) override;
     void onKeyboardAttached();
 };
@@ -27,6 +27,9 @@ Q_LOGGING_CATEGORY(ucActionContext, "ubuntu.components.ActionContext", QtMsgType
 
 UT_NAMESPACE_BEGIN
 
+// changes whenever a context gets attached to or detached from an item
+static uint contextAttachmentGeneration = 0;
+
 UCActionContextAttached::UCActionContextAttached(QObject *owner)
     : QObject(owner)
     , m_owner(qobject_cast<QQuickItem*>(owner))
@@ -113,6 +116,7 @@ UCActionContext::UCActionContext(QObject *parent)
 UCActionContext::~UCActionContext()
 {
     ActionProxy::removeContext(this);
+    contextAttachmentGeneration++;
 }
 
 UCActionContextAttached *UCActionContext::qmlAttachedProperties(QObject *owner)
@@ -128,6 +132,16 @@ void UCActionContext::classBegin()
     UCActionContextAttached *attached = static_cast<UCActionContextAttached*>(
             qmlAttachedPropertiesObject<UCActionContext>(parent(), true));
     attached->m_context = this;
+    contextAttachmentGeneration++;
+}
+
+/*
+ * Used by the actions to detect when the contexts resolved for their owning
+ * items need to be looked up again.
+ */
+uint UCActionContext::attachmentGeneration()
+{
+    return contextAttachmentGeneration;
 }
 
 void UCActionContext::componentComplete()
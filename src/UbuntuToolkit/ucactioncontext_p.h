@@ -43,6 +43,7 @@ public:
     ~UCActionContext();
 
     static UCActionContextAttached *qmlAttachedProperties(QObject *owner);
+    static uint attachmentGeneration();
 
     void classBegin() override;
     void componentComplete() override;
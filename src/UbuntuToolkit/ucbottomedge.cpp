@@ -18,10 +18,13 @@
 
 #include "ucbottomedge_p_p.h"
 
+#include <algorithm>
+
 #include <QtCore/QtMath>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QScreen>
 #include <QtGui/QStyleHints>
+#include <QtQuick/QQuickWindow>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlProperty>
 #include <QtQuick/private/qquickanimation_p.h>
@@ -48,13 +51,18 @@ UCBottomEdgePrivate::UCBottomEdgePrivate()
     , hint(new UCBottomEdgeHint)
     , bottomPanel(Q_NULLPTR)
     , previousDistance(0.0)
+    , pendingDistance(0.0)
     , dragProgress(0.)
+    , predictionProgress(0.0)
+    , preloadVelocity(0.0)
     , status(UCBottomEdge::Hidden)
     , operationStatus(Idle)
     , dragDirection(UCBottomEdge::Undefined)
     , defaultRegionsReset(false)
     , mousePressed(false)
     , preloadContent(false)
+    , regionIndexDirty(true)
+    , progressionPending(false)
 {
 }
 
@@ -141,6 +149,7 @@ void UCBottomEdgePrivate::appendRegion(UCBottomEdgeRegion *region)
 
     // append region definition
     regions.append(region);
+    invalidateRegionIndex();
 
     LOG << "region added:" << region;
 }
@@ -157,6 +166,7 @@ void UCBottomEdgePrivate::clearRegions(bool destroy)
     regions.clear();
     defaultRegionsReset = false;
     regions.append(defaultRegion);
+    invalidateRegionIndex();
 
     LOG << "regions cleared, default restored";
 }
@@ -200,6 +210,152 @@ void UCBottomEdgePrivate::validateRegion(UCBottomEdgeRegion *region, int regions
     }
 }
 
+// Builds the interval index of the regions. The boundaries of the enabled
+// regions split the drag range into spans, each owned by the first declared
+// region containing it, the same way a linear scan of the regions would pick.
+void UCBottomEdgePrivate::buildRegionIndex()
+{
+    regionBounds.clear();
+    Q_FOREACH(UCBottomEdgeRegion *region, regions) {
+        UCBottomEdgeRegionPrivate *d = UCBottomEdgeRegionPrivate::get(region);
+        if (d->enabled && d->from < d->to) {
+            regionBounds << d->from << d->to;
+        }
+    }
+    std::sort(regionBounds.begin(), regionBounds.end());
+    regionBounds.erase(std::unique(regionBounds.begin(), regionBounds.end()), regionBounds.end());
+
+    auto firstContaining = [this](qreal dragRatio) -> UCBottomEdgeRegion* {
+        Q_FOREACH(UCBottomEdgeRegion *region, regions) {
+            if (region->contains(dragRatio)) {
+                return region;
+            }
+        }
+        return Q_NULLPTR;
+    };
+    const int count = regionBounds.size();
+    regionAtBound.resize(count);
+    regionAboveBound.resize(count);
+    for (int i = 0; i < count; ++i) {
+        regionAtBound[i] = firstContaining(regionBounds[i]);
+        // a region containing the middle of a span contains the whole span
+        regionAboveBound[i] = (i + 1 < count)
+                ? firstContaining((regionBounds[i] + regionBounds[i + 1]) / 2)
+                : Q_NULLPTR;
+    }
+    regionIndexDirty = false;
+}
+
+// returns the region active at the given drag ratio, null if there is none
+UCBottomEdgeRegion *UCBottomEdgePrivate::regionAt(qreal dragRatio)
+{
+    if (regionIndexDirty) {
+        buildRegionIndex();
+    }
+    int i = std::upper_bound(regionBounds.constBegin(), regionBounds.constEnd(), dragRatio)
+            - regionBounds.constBegin() - 1;
+    if (i < 0) {
+        return Q_NULLPTR;
+    }
+    return (regionBounds[i] == dragRatio) ? regionAtBound[i] : regionAboveBound[i];
+}
+
+// returns the first region other than current the drag reaches above dragRatio
+UCBottomEdgeRegion *UCBottomEdgePrivate::regionAbove(qreal dragRatio, UCBottomEdgeRegion *current)
+{
+    if (regionIndexDirty) {
+        buildRegionIndex();
+    }
+    int i = std::upper_bound(regionBounds.constBegin(), regionBounds.constEnd(), dragRatio)
+            - regionBounds.constBegin();
+    for (; i < regionBounds.size(); ++i) {
+        UCBottomEdgeRegion *region = regionAtBound[i];
+        if (region && region != current) {
+            return region;
+        }
+        region = regionAboveBound[i];
+        if (region && region != current) {
+            return region;
+        }
+    }
+    return Q_NULLPTR;
+}
+
+// called when a drag gesture starts
+void UCBottomEdgePrivate::beginDrag()
+{
+    // regions may have been altered without notifying us
+    invalidateRegionIndex();
+    discardPredictedRegion();
+    predictionTimer.invalidate();
+}
+
+// Queues the drag distance to be applied once per frame: several moves can be
+// delivered within a frame, each of them would re-evaluate the bindings on
+// dragProgress and activeRegion otherwise.
+void UCBottomEdgePrivate::scheduleProgressionStates(qreal distance)
+{
+    Q_Q(UCBottomEdge);
+    pendingDistance = distance;
+    progressionPending = true;
+    QQuickWindow *window = q->window();
+    if (window && window->isExposed() && frameConnection) {
+        window->update();
+    } else {
+        flushProgressionStates();
+    }
+}
+
+// applies the last queued drag distance, called before the frame is synchronized
+void UCBottomEdgePrivate::flushProgressionStates()
+{
+    if (!progressionPending) {
+        return;
+    }
+    progressionPending = false;
+    updateProgressionStates(pendingDistance);
+    predictRegion();
+}
+
+// Preloads the content of the next region when the drag goes upwards fast
+// enough, so it is ready by the time the region is entered.
+void UCBottomEdgePrivate::predictRegion()
+{
+    if (preloadVelocity <= 0.0 || preloadContent || isLocked()) {
+        return;
+    }
+    if (!predictionTimer.isValid()) {
+        predictionTimer.start();
+        predictionProgress = dragProgress;
+        return;
+    }
+    const qint64 elapsed = predictionTimer.elapsed();
+    if (elapsed <= 0) {
+        return;
+    }
+    const qreal velocity = (dragProgress - predictionProgress) * 1000 / elapsed;
+    predictionTimer.restart();
+    predictionProgress = dragProgress;
+    if (velocity < preloadVelocity) {
+        return;
+    }
+    UCBottomEdgeRegion *next = regionAbove(dragProgress, activeRegion);
+    if (!next || next == defaultRegion || next == predictedRegion) {
+        return;
+    }
+    discardPredictedRegion();
+    predictedRegion = next;
+    UCBottomEdgeRegionPrivate::get(next)->preloadRegionContent();
+}
+
+void UCBottomEdgePrivate::discardPredictedRegion()
+{
+    if (predictedRegion) {
+        UCBottomEdgeRegionPrivate::get(predictedRegion)->discardPreloadedContent();
+    }
+    predictedRegion = Q_NULLPTR;
+}
+
 // update status, drag direction and activeRegion during drag
 void UCBottomEdgePrivate::updateProgressionStates(qreal distance)
 {
@@ -218,14 +374,8 @@ void UCBottomEdgePrivate::updateProgressionStates(qreal distance)
         setStatus(UCBottomEdge::Revealed);
     }
 
-    // go through the regions and spot the active region
-    UCBottomEdgeRegion *newActive = Q_NULLPTR;
-    Q_FOREACH(UCBottomEdgeRegion *region, regions) {
-        if (region->contains(dragProgress)) {
-            newActive = region;
-            break;
-        }
-    }
+    // spot the active region
+    UCBottomEdgeRegion *newActive = regionAt(dragProgress);
     // if no active region is found, use the default one
     if (!newActive) {
         LOG << "no active region found, fall back to the default";
@@ -289,6 +439,8 @@ void UCBottomEdgePrivate::setDragDirection(UCBottomEdge::DragDirection direction
 // proceed with drag completion action
 void UCBottomEdgePrivate::onDragEnded()
 {
+    // apply the moves queued since the last frame
+    flushProgressionStates();
     // collapse if we drag downwards, or not in any active region and we did not pass 30% of the BottomEdge height
     LOG << "direction:" << dragDirection << ", activeRegion?" << activeRegion << ", dragProgress:" << dragProgress;
     if (dragDirection == UCBottomEdge::Downwards || (activeRegion && !activeRegion->canCommit(dragProgress))) {
@@ -311,6 +463,7 @@ void UCBottomEdgePrivate::commit(qreal to)
         return;
     }
     Q_Q(UCBottomEdge);
+    discardPredictedRegion();
     setOperationStatus(qFuzzyCompare(to, 1.0) ? CommitToTop : CommitToRegion);
     if (operationStatus == CommitToTop) {
         LOG << "emit commitStarted()";
@@ -358,6 +511,7 @@ void UCBottomEdge::unlockOperation(bool running)
     case UCBottomEdgePrivate::Collapsing:
         // no active region when collapsed!
         d->setActiveRegion(nullptr);
+        d->discardPredictedRegion();
         d->setStatus(UCBottomEdge::Hidden);
         Q_EMIT collapseCompleted();
         break;
@@ -485,6 +639,10 @@ void UCBottomEdgePrivate::itemChildRemoved(QQuickItem *item, QQuickItem *child)
 void UCBottomEdgePrivate::setOperationStatus(OperationStatus s)
 {
     operationStatus = s;
+    if (operationStatus > Idle) {
+        // the operation drives dragProgress from now on
+        progressionPending = false;
+    }
     switch (s) {
     case Idle: LOG << "OP" << "Idle"; break;
     case CommitToTop: LOG << "OP" << "CommitToTop"; break;
@@ -715,12 +873,14 @@ void UCBottomEdge::initializeComponent()
 
     // follow drag progress
     connect(d->hint->swipeArea(), &UCSwipeArea::distanceChanged, [=](qreal distance) {
-        d->updateProgressionStates(distance);
+        d->scheduleProgressionStates(distance);
     });
 
-    // follow swipe end
+    // follow swipe start and end
     connect(d->hint->swipeArea(), &UCSwipeArea::draggingChanged, [=](bool dragging) {
-        if (!dragging) {
+        if (dragging) {
+            d->beginDrag();
+        } else {
             d->onDragEnded();
         }
     });
@@ -769,6 +929,18 @@ void UCBottomEdgePrivate::completeComponentInitialization()
 
 void UCBottomEdge::itemChange(ItemChange change, const ItemChangeData &data)
 {
+    if (change == ItemSceneChange) {
+        Q_D(UCBottomEdge);
+        // apply the queued drag moves once per frame, after the animations
+        // got advanced and before the scene is synchronized
+        disconnect(d->frameConnection);
+        d->frameConnection = QMetaObject::Connection();
+        if (data.window) {
+            d->frameConnection = connect(data.window, &QQuickWindow::afterAnimating, this, [d] {
+                d->flushProgressionStates();
+            });
+        }
+    }
     if (change == ItemParentHasChanged) {
         Q_D(UCBottomEdge);
         // disconnect from old parent
@@ -810,6 +982,9 @@ bool UCBottomEdge::eventFilter(QObject *target, QEvent *event)
     {
         QMouseEvent *mouse = static_cast<QMouseEvent*>(event);
         d->mousePressed = d->hint->contains(mouse->localPos());
+        if (d->mousePressed) {
+            d->beginDrag();
+        }
         LOG << "drag with mouse";
         break;
     }
@@ -825,7 +1000,7 @@ bool UCBottomEdge::eventFilter(QObject *target, QEvent *event)
             QMouseEvent *mouse = static_cast<QMouseEvent*>(event);
             qreal mouseItemY = mapFromScene(mouse->windowPos()).y();
             qreal distance = qFabs(height() - mouseItemY);
-            d->updateProgressionStates(distance);
+            d->scheduleProgressionStates(distance);
         }
         break;
     }
@@ -21,6 +21,9 @@
 
 #include <UbuntuToolkit/private/ucbottomedge_p.h>
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVector>
+
 #include <UbuntuToolkit/private/ucstyleditembase_p_p.h>
 #include <UbuntuToolkit/private/ucaction_p.h>
 
@@ -51,10 +54,26 @@ public:
     void appendRegion(UCBottomEdgeRegion *range);
     void clearRegions(bool destroy);
     void validateRegion(UCBottomEdgeRegion *region, int regionsSize = -1);
+    void invalidateRegionIndex()
+    {
+        regionIndexDirty = true;
+    }
+    void buildRegionIndex();
+    UCBottomEdgeRegion *regionAt(qreal dragRatio);
+    UCBottomEdgeRegion *regionAbove(qreal dragRatio, UCBottomEdgeRegion *current);
 
     // page header manipulation
     void patchContentItemHeader();
+    void beginDrag();
+    void scheduleProgressionStates(qreal distance);
+    void flushProgressionStates();
     void updateProgressionStates(qreal distance);
+    void setPreloadVelocity(qreal velocity)
+    {
+        preloadVelocity = velocity;
+    }
+    void predictRegion();
+    void discardPredictedRegion();
     bool setActiveRegion(UCBottomEdgeRegion *range);
     void detectDirection(qreal currentDistance);
     void setDragDirection(UCBottomEdge::DragDirection direction);
@@ -76,6 +95,14 @@ public:
     void resetCurrentContent(QQuickItem *newItem);
     // members
     QList<UCBottomEdgeRegion*> regions;
+    // non-overlapping interval index of the regions: the sorted boundaries,
+    // the region owning each boundary and the one owning the span above it
+    QVector<qreal> regionBounds;
+    QVector<UCBottomEdgeRegion*> regionAtBound;
+    QVector<UCBottomEdgeRegion*> regionAboveBound;
+    QPointer<UCBottomEdgeRegion> predictedRegion;
+    QMetaObject::Connection frameConnection;
+    QElapsedTimer predictionTimer;
     QPointer<QQuickItem> currentContentItem;
     UCBottomEdgeRegion *defaultRegion;
     UCBottomEdgeRegion *activeRegion;
@@ -83,7 +110,12 @@ public:
     UCBottomEdgeStyle *bottomPanel;
 
     qreal previousDistance;
+    qreal pendingDistance;
     qreal dragProgress;
+    qreal predictionProgress;
+    // drag speed in bottom edge heights per second above which the content of
+    // the next region is preloaded, 0 disables the prediction
+    qreal preloadVelocity;
     UCBottomEdge::Status status;
 
     enum OperationStatus {
@@ -98,6 +130,8 @@ public:
     bool defaultRegionsReset:1;
     bool mousePressed:1;
     bool preloadContent:1;
+    bool regionIndexDirty:1;
+    bool progressionPending:1;
 
     // status management
     void setOperationStatus(OperationStatus s);
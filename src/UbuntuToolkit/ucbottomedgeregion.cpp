@@ -34,6 +34,7 @@ UCBottomEdgeRegionPrivate::UCBottomEdgeRegionPrivate()
     , to(-1.0)
     , enabled(true)
     , active(false)
+    , preloading(false)
 {
 }
 
@@ -136,6 +137,7 @@ void UCBottomEdgeRegionPrivate::attachToBottomEdge(UCBottomEdge *bottomEdge)
         to = 1.0;
         Q_EMIT q->toChanged();
     }
+    UCBottomEdgePrivate::get(bottomEdge)->invalidateRegionIndex();
 
     // if preload is set, load content
     if (bottomEdge->preloadContent()) {
@@ -170,6 +172,14 @@ void UCBottomEdgeRegion::enter()
             LOG << "SET REGION CONTENT" << objectName();
             UCBottomEdgePrivate::get(d->bottomEdge)->setCurrentContent();
         }
+    } else if (d->preloading) {
+        // content predicted by the drag, use it if already loaded, otherwise
+        // it is set when the loading completes
+        d->preloading = false;
+        if (d->contentItem) {
+            LOG << "SET PREDICTED REGION CONTENT" << objectName();
+            UCBottomEdgePrivate::get(d->bottomEdge)->setCurrentContent();
+        }
     } else {
         // initiate loading, component has priority
         d->loadRegionContent();
@@ -219,6 +229,29 @@ void UCBottomEdgeRegionPrivate::loadRegionContent()
     }
 }
 
+// starts loading the content of an inactive region ahead of entering it
+void UCBottomEdgeRegionPrivate::preloadRegionContent()
+{
+    if (active || preloading || contentItem || bottomEdge->preloadContent()) {
+        return;
+    }
+    LOG << "PRELOAD REGION CONTENT" << q_func()->objectName();
+    preloading = true;
+    loadRegionContent();
+}
+
+// drops the preloaded content if the region was not entered
+void UCBottomEdgeRegionPrivate::discardPreloadedContent()
+{
+    if (!preloading) {
+        return;
+    }
+    preloading = false;
+    if (!active && !bottomEdge->preloadContent()) {
+        discardRegionContent();
+    }
+}
+
 void UCBottomEdgeRegionPrivate::loadContent(LoadingType type)
 {
     // we must delete the previous content before we (re)initiate loading
@@ -256,7 +289,7 @@ void UCBottomEdgeRegionPrivate::onLoaderStatusChanged(AsyncLoader::LoadingStatus
         // if we are no longer active, no need to continue, and discard content
         // this may occur when the component was still in Compiling state while
         // the region was exited, therefore reset() could not cancel the operation.
-        if (!active && !bottomEdge->preloadContent()) {
+        if (!active && !preloading && !bottomEdge->preloadContent()) {
             LOG << "DELETE REGION CONTENT" << q_func()->objectName();
             object->deleteLater();
             return;
@@ -299,6 +332,7 @@ void UCBottomEdgeRegion::setEnabled(bool enabled)
     }
     d->enabled = enabled;
     if (d->bottomEdge) {
+        UCBottomEdgePrivate::get(d->bottomEdge)->invalidateRegionIndex();
         UCBottomEdgePrivate::get(d->bottomEdge)->validateRegion(this);
         // load content if preload is set
         if (d->bottomEdge->preloadContent()) {
@@ -331,6 +365,7 @@ void UCBottomEdgeRegion::setFrom(qreal from)
     }
     d->from = from;
     if (d->bottomEdge) {
+        UCBottomEdgePrivate::get(d->bottomEdge)->invalidateRegionIndex();
         UCBottomEdgePrivate::get(d->bottomEdge)->validateRegion(this);
     }
     Q_EMIT fromChanged();
@@ -357,6 +392,7 @@ void UCBottomEdgeRegion::setTo(qreal to)
     }
     d->to = to;
     if (d->bottomEdge) {
+        UCBottomEdgePrivate::get(d->bottomEdge)->invalidateRegionIndex();
         UCBottomEdgePrivate::get(d->bottomEdge)->validateRegion(this);
     }
     Q_EMIT toChanged();
@@ -47,6 +47,8 @@ public:
     void attachToBottomEdge(UCBottomEdge *bottomEdge);
     virtual void loadRegionContent();
     virtual void discardRegionContent();
+    void preloadRegionContent();
+    void discardPreloadedContent();
     void loadContent(LoadingType type);
 
     void onLoaderStatusChanged(AsyncLoader::LoadingStatus,QObject*);
@@ -60,6 +62,7 @@ public:
     qreal to;
     bool enabled:1;
     bool active:1;
+    bool preloading:1;
 };
 
 class DefaultRegionPrivate;
@@ -117,8 +117,10 @@ QColor UCLabelPrivate::getDefaultColor(QQuickItem *item, UCTheme *theme)
 {
     // FIXME: replace the code below with automatic color
     // change detection based on the item's state
-    const char *valueSet = item->isEnabled() ? "normal" : "disabled";
-    return theme ? theme->getPaletteColor(valueSet, "backgroundText") : QColor();
+    static const int normal = UCTheme::paletteProfile("normal");
+    static const int disabled = UCTheme::paletteProfile("disabled");
+    static const int backgroundText = UCTheme::paletteColorRole("backgroundText");
+    return theme ? theme->paletteColor(item->isEnabled() ? normal : disabled, backgroundText) : QColor();
 }
 
 void UCLabel::classBegin()
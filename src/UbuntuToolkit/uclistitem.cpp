@@ -22,6 +22,7 @@
 #include <QtGui/QStyleHints>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlInfo>
+#include <QtQml/private/qqmlcontext_p.h>
 #include <QtQuick/private/qquickanimation_p.h>
 #include <QtQuick/private/qquickbehavior_p.h>
 #include <QtQuick/private/qquickflickable_p.h>
@@ -342,7 +343,7 @@ bool UCListItemPrivate::loadStyleItem(bool animated)
         return false;
     }
 
-    if (!UCStyledItemBasePrivate::loadStyleItem(animated)) {
+    if (!adoptRecycledStyleItem() && !UCStyledItemBasePrivate::loadStyleItem(animated)) {
         return false;
     }
 
@@ -359,6 +360,102 @@ bool UCListItemPrivate::loadStyleItem(bool animated)
     return true;
 }
 
+// theme styles of a view recycling its delegates are created in the context of
+// the view, so their context survives the delegate context being destroyed
+QQmlContext *UCListItemPrivate::styleCreationContext(QQmlComponent *component)
+{
+    UCViewItemsAttachedPrivate *viewItems = UCViewItemsAttachedPrivate::get(parentAttached);
+    QQmlContext *context = (viewItems && !styleComponent) ? viewItems->recycledStyleContext() : Q_NULLPTR;
+    return context ? context : UCStyledItemBasePrivate::styleCreationContext(component);
+}
+
+// binds the style context to the given ListItem and re-evaluates the bindings of
+// the style, as changing the context object does not update them
+void UCListItemPrivate::bindStyleContext(UCListItem *listItem)
+{
+    styleItemContext->setContextObject(listItem);
+    styleItemContext->setContextProperty(QStringLiteral("styledItem"), listItem);
+    QQmlContextData::get(styleItemContext)->refreshExpressions();
+}
+
+// hands the style item over to the ViewItems when the delegate model releases the
+// ListItem, so an other ListItem of the view can reuse it instead of creating a
+// new one; returns true if the style item got recycled
+bool UCListItemPrivate::recycleStyleItem()
+{
+    Q_Q(UCListItem);
+    UCViewItemsAttachedPrivate *viewItems = UCViewItemsAttachedPrivate::get(parentAttached);
+    if (!viewItems || !viewItems->canRecycleStyle() || !styleItem || styleComponent || !styleItemContext
+            || styleItemContext->parentContext() != viewItems->recycledStyleContext()) {
+        return false;
+    }
+    // the delegate model destroys the context of the delegates it releases, a
+    // ListItem only reparented keeps it, and with that its style
+    QQmlContext *context = qmlContext(q);
+    if (context && context->isValid()) {
+        return false;
+    }
+    UCTheme *theme = q->getTheme();
+    UCListItemStyle *style = qobject_cast<UCListItemStyle*>(styleItem);
+    if (!theme || !style) {
+        return false;
+    }
+
+    UCViewItemsAttachedPrivate::RecycledStyle recycled;
+    recycled.style = style;
+    recycled.context = styleItemContext;
+    recycled.theme = theme;
+    recycled.themeName = theme->name();
+    recycled.document = styleDocument;
+    recycled.version = styleVersion;
+
+    // bind the style to an inert ListItem while parked, so its bindings do not
+    // reach this ListItem once destroyed
+    style->rebindListItem(Q_NULLPTR);
+    bindStyleContext(viewItems->stylePlaceholder());
+
+    connectStyleSizeChanges(false);
+    QQuickItemPrivate::get(styleItem)->anchors()->resetFill();
+    styleItem->setParentItem(Q_NULLPTR);
+    styleItem = Q_NULLPTR;
+    styleItemContext.clear();
+    viewItems->pushRecycledStyle(recycled);
+    Q_EMIT q->styleInstanceChanged();
+    return true;
+}
+
+// takes a style item recycled by an other ListItem of the same view, rebinding
+// it to this ListItem; returns false if there was no style to reuse
+bool UCListItemPrivate::adoptRecycledStyleItem()
+{
+    UCViewItemsAttachedPrivate *viewItems = UCViewItemsAttachedPrivate::get(parentAttached);
+    if (!viewItems || styleItem || styleComponent || !componentComplete) {
+        return false;
+    }
+    Q_Q(UCListItem);
+    UCViewItemsAttachedPrivate::RecycledStyle recycled =
+            viewItems->takeRecycledStyle(q->getTheme(), styleDocument, styleVersion);
+    if (!recycled.style) {
+        return false;
+    }
+
+    // panels must not animate while the style gets rebound
+    UCListItemStyle *style = recycled.style.data();
+    style->setAnimatePanels(false);
+    styleItemContext = recycled.context;
+    style->rebindListItem(q);
+    bindStyleContext(q);
+
+    styleItem = style;
+    QQml_setParent_noEvent(styleItem, q);
+    styleItem->setParentItem(q);
+    QQuickItemPrivate::get(styleItem)->anchors()->setFill(q);
+    _q_styleResized();
+    connectStyleSizeChanges(true);
+    Q_EMIT q->styleInstanceChanged();
+    return true;
+}
+
 // called when units size changes
 void UCListItemPrivate::_q_updateSize()
 {
@@ -1107,7 +1204,9 @@ void UCListItem::itemChange(ItemChange change, const ItemChangeData &data)
         } else {
             // mark as not ready, so no action should be performed which depends on readyness
             d->ready = false;
-            // about to be deleted or reparented, disable attached
+            // about to be deleted or reparented, leave the style to the view if
+            // it recycles its delegates and released this one, and disable attached
+            d->recycleStyleItem();
             d->parentAttached = 0;
         }
 
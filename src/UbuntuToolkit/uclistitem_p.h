@@ -188,6 +188,7 @@ class UBUNTUTOOLKIT_EXPORT UCViewItemsAttached : public QObject
     // https://bugs.launchpad.net/ubuntu/+source/qtdeclarative-opensource-src/+bug/1389721
     Q_PROPERTY(QList<int> expandedIndices READ expandedIndices WRITE setExpandedIndices NOTIFY expandedIndicesChanged)
     Q_PROPERTY(int expansionFlags READ expansionFlags WRITE setExpansionFlags NOTIFY expansionFlagsChanged)
+    Q_PROPERTY(bool recycleDelegates READ recycleDelegates WRITE setRecycleDelegates NOTIFY recycleDelegatesChanged)
 public:
     enum ExpansionFlag {
         Exclusive = 0x01,
@@ -218,6 +219,8 @@ public:
     void setExpandedIndices(QList<int> indices);
     int expansionFlags() const;
     void setExpansionFlags(int flags);
+    bool recycleDelegates() const;
+    void setRecycleDelegates(bool recycle);
 
 private Q_SLOTS:
     void unbindItem();
@@ -234,6 +237,7 @@ Q_SIGNALS:
     void expandedIndicesChanged(const QList<int> &indices);
     void expansionFlagsChanged();
     void effectiveCurrentIndexChanged();
+    void recycleDelegatesChanged();
 private:
     Q_DECLARE_PRIVATE(UCViewItemsAttached)
 };
@@ -30,6 +30,7 @@
 #define IMPLICIT_LISTITEM_HEIGHT_GU     7
 #define DIVIDER_THICKNESS_DP            1
 #define DEFAULT_SWIPE_THRESHOLD_GU      1.5
+#define MAX_RECYCLED_STYLES             16
 
 class QQuickFlickable;
 
@@ -80,6 +81,9 @@ public:
     bool shouldShowContextMenu(QMouseEvent *event);
     void _q_popoverClosed();
     void showContextMenu();
+    bool recycleStyleItem();
+    bool adoptRecycledStyleItem();
+    void bindStyleContext(UCListItem *listItem);
 
     QPointer<QQuickItem> countOwner;
     QPointer<QQuickFlickable> flickable;
@@ -116,6 +120,7 @@ public:
     void setContentMoving(bool moved);
     void preStyleChanged() override;
     bool loadStyleItem(bool animated = true) override;
+    QQmlContext *styleCreationContext(QQmlComponent *component) override;
     bool dragging();
     bool dragMode();
     void setDragMode(bool draggable);
@@ -138,10 +143,22 @@ UCListItemStyle *UCListItemPrivate::listItemStyle() const
 class PropertyChange;
 class ListItemDragArea;
 class ListViewProxy;
+class UCTheme;
 class UCViewItemsAttachedPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(UCViewItemsAttached)
 public:
+    // style item parked by a ListItem leaving the view, together with the
+    // context it was created in and the data identifying the style document
+    struct RecycledStyle {
+        QPointer<UCListItemStyle> style;
+        QPointer<QQmlContext> context;
+        QPointer<UCTheme> theme;
+        QString themeName;
+        QString document;
+        quint16 version;
+    };
+
     UCViewItemsAttachedPrivate();
     ~UCViewItemsAttachedPrivate();
     void init();
@@ -167,16 +184,27 @@ public:
     void collapseAll();
     void toggleExpansionFlags(bool enable);
 
+    // delegate recycling
+    bool canRecycleStyle();
+    QQmlContext *recycledStyleContext();
+    void pushRecycledStyle(const RecycledStyle &recycled);
+    RecycledStyle takeRecycledStyle(UCTheme *theme, const QString &document, quint16 version);
+    void clearRecycledStyles();
+    UCListItem *stylePlaceholder();
+
     QSet<int> selectedList;
     QMap<int, QPointer<UCListItem> > expansionList;
     QList< QPointer<QQuickFlickable> > flickables;
     QPointer<UCListItem> boundItem;
+    QPointer<UCListItem> placeholder;
+    QList<RecycledStyle> recycledStyles;
     ListViewProxy *listView;
     ListItemDragArea *dragArea;
     UCViewItemsAttached::ExpansionFlags expansionFlags;
     bool selectable:1;
     bool draggable:1;
     bool ready:1;
+    bool recycleDelegates:1;
 };
 
 UT_NAMESPACE_END
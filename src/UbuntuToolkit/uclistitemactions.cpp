@@ -16,7 +16,10 @@
 
 #include "uclistitemactions_p_p.h"
 
+#include <QtQml/QQmlContext>
+#include <QtQml/QQmlEngine>
 #include <QtQml/QQmlInfo>
+#include <QtQml/private/qqmlglobal_p.h>
 
 #include "i18n_p.h"
 #include "quickutils_p.h"
@@ -30,6 +33,7 @@ UT_NAMESPACE_BEGIN
 UCListItemActionsPrivate::UCListItemActionsPrivate()
     : QObjectPrivate()
     , delegate(0)
+    , container(0)
 {
 }
 UCListItemActionsPrivate::~UCListItemActionsPrivate()
@@ -295,4 +299,147 @@ QQmlListProperty<QObject> UCListItemActions::data()
     return QQmlListProperty<QObject>(this, d->data);
 }
 
+/*!
+ * \qmlproperty ListItem ListItemActions::container
+ * \readonly
+ * \since Ubuntu.Components 1.3
+ * The property holds the ListItem the actions are currently shown in, or null
+ * when none of the ListItems using the actions is swiped. The panel visualizing
+ * the actions is created once and shared by all the ListItems using the same
+ * ListItemActions, and it follows the swiped ListItem through this property.
+ * The property is only maintained by styles sharing the panel, and stays null
+ * with the Ubuntu.Components 1.2 style.
+ */
+UCListItem *UCListItemActions::container() const
+{
+    Q_D(const UCListItemActions);
+    return d->container;
+}
+
+void UCListItemActionsPrivate::setContainer(UCListItem *listItem)
+{
+    if (container == listItem) {
+        return;
+    }
+    Q_Q(UCListItemActions);
+    QObject::disconnect(containerDestroyed);
+    container = listItem;
+    if (container) {
+        // the ListItem may go away while the panel is still shown in it
+        containerDestroyed = QObject::connect(container, &QObject::destroyed, q, [this]() {
+            setContainer(Q_NULLPTR);
+        });
+    }
+    Q_FOREACH(const Panel *panel, QList<const Panel*>() << &leadingPanel << &trailingPanel) {
+        if (panel->context) {
+            panel->context->setContextProperty(QStringLiteral("container"), container);
+        }
+    }
+    Q_EMIT q->containerChanged();
+}
+
+// clears the container once none of the panels is shown in a ListItem
+void UCListItemActionsPrivate::updateContainer()
+{
+    if ((!leadingPanel.item || !leadingPanel.item->parentItem())
+            && (!trailingPanel.item || !trailingPanel.item->parentItem())) {
+        setContainer(Q_NULLPTR);
+    }
+}
+
+// the shared panel is busy while the item it is mounted in is still loaded in
+// a ListItem, i.e. while that ListItem is swiped or snapping out
+bool UCListItemActionsPrivate::isPanelBusy(bool leading)
+{
+    const Panel &panel = leading ? leadingPanel : trailingPanel;
+    QQuickItem *mount = panel.item ? panel.item->parentItem() : Q_NULLPTR;
+    return mount && mount->parentItem();
+}
+
+// moves the panel visualizing the actions into the mount item of the ListItem;
+// the shared panel is used unless it is busy in an other ListItem, in which case
+// a panel owned by the mount item is created, so the other ListItem keeps its own
+QQuickItem *UCListItemActionsPrivate::mountPanel(QQmlComponent *component, bool leading, UCListItem *listItem, QQuickItem *mount)
+{
+    if (isPanelBusy(leading)) {
+        QQmlContext *context = Q_NULLPTR;
+        QQuickItem *fallback = createPanel(component, leading, listItem, mount, &context);
+        if (fallback) {
+            fallback->setParentItem(mount);
+        }
+        return fallback;
+    }
+    QQuickItem *shared = panel(component, leading);
+    if (shared) {
+        shared->setParentItem(mount);
+        setContainer(listItem);
+    }
+    return shared;
+}
+
+// creates a panel from the style's panel component, in a context of its own
+// which only provides the actions, the side and the ListItem to the panel
+QQuickItem *UCListItemActionsPrivate::createPanel(QQmlComponent *component, bool leading, UCListItem *listItem,
+                                                  QObject *owner, QQmlContext **panelContext)
+{
+    Q_Q(UCListItemActions);
+    QQmlContext *parentContext = qmlContext(q);
+    if (!parentContext) {
+        QQmlEngine *engine = qmlEngine(component);
+        if (!engine) {
+            return Q_NULLPTR;
+        }
+        parentContext = engine->rootContext();
+    }
+    QQmlContext *context = new QQmlContext(parentContext);
+    context->setContextProperty(QStringLiteral("itemActions"), q);
+    context->setContextProperty(QStringLiteral("leading"), leading);
+    context->setContextProperty(QStringLiteral("container"), listItem);
+    QObject *object = component->beginCreate(context);
+    if (!object) {
+        delete context;
+        return Q_NULLPTR;
+    }
+    // link context to the panel to delete them together
+    QQml_setParent_noEvent(context, object);
+    QQml_setParent_noEvent(object, owner);
+    component->completeCreate();
+    QQuickItem *item = qobject_cast<QQuickItem*>(object);
+    if (!item) {
+        delete object;
+        return Q_NULLPTR;
+    }
+    *panelContext = context;
+    return item;
+}
+
+// returns the panel shared by all the ListItems using the actions on the given
+// side, created from the style's panel component on first use
+QQuickItem *UCListItemActionsPrivate::panel(QQmlComponent *component, bool leading)
+{
+    Q_Q(UCListItemActions);
+    Panel &panel = leading ? leadingPanel : trailingPanel;
+    if (panel.item && panel.styleUrl == component->url()) {
+        return panel.item;
+    }
+    if (panel.item) {
+        // the style has changed, drop the panel created by the previous one
+        panel.item->setParentItem(Q_NULLPTR);
+        panel.item->deleteLater();
+        panel.item.clear();
+    }
+
+    QQmlContext *context = Q_NULLPTR;
+    panel.item = createPanel(component, leading, container, q, &context);
+    if (!panel.item) {
+        return Q_NULLPTR;
+    }
+    panel.context = context;
+    panel.styleUrl = component->url();
+    QObject::connect(panel.item.data(), &QQuickItem::parentChanged, q, [this]() {
+        updateContainer();
+    });
+    return panel.item;
+}
+
 UT_NAMESPACE_END
@@ -33,6 +33,11 @@ class UBUNTUTOOLKIT_EXPORT UCListItemActions : public QObject
     Q_PROPERTY(QQmlComponent *delegate READ delegate WRITE setDelegate NOTIFY delegateChanged)
     Q_PROPERTY(QQmlListProperty<UT_PREPEND_NAMESPACE(UCAction)> actions READ actions CONSTANT)
     Q_PROPERTY(QQmlListProperty<QObject> data READ data)
+#ifndef Q_QDOC
+    Q_PROPERTY(UT_PREPEND_NAMESPACE(UCListItem) *container READ container NOTIFY containerChanged)
+#else
+    Q_PROPERTY(UCListItem *container READ container NOTIFY containerChanged)
+#endif
     Q_CLASSINFO("DefaultProperty", "data")
 public:
     explicit UCListItemActions(QObject *parent = 0);
@@ -42,9 +47,11 @@ public:
     void setDelegate(QQmlComponent *delegate);
     QQmlListProperty<UCAction> actions();
     QQmlListProperty<QObject> data();
+    UCListItem *container() const;
 
 Q_SIGNALS:
     void delegateChanged();
+    void containerChanged();
 
 private:
     Q_DECLARE_PRIVATE(UCListItemActions)
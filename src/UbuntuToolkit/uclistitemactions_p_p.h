@@ -19,6 +19,8 @@
 
 #include <UbuntuToolkit/private/uclistitemactions_p.h>
 
+#include <QtCore/QPointer>
+#include <QtCore/QUrl>
 #include <QtCore/private/qobject_p.h>
 #include <QtQml/QQmlListProperty>
 
@@ -35,9 +37,28 @@ public:
         return actions ? actions->d_func() : 0;
     }
 
+    // panel visualizing the actions, shared by the ListItems using them
+    struct Panel {
+        QPointer<QQuickItem> item;
+        QPointer<QQmlContext> context;
+        QUrl styleUrl;
+    };
+
+    QQuickItem *mountPanel(QQmlComponent *component, bool leading, UCListItem *listItem, QQuickItem *mount);
+    QQuickItem *createPanel(QQmlComponent *component, bool leading, UCListItem *listItem,
+                            QObject *owner, QQmlContext **panelContext);
+    QQuickItem *panel(QQmlComponent *component, bool leading);
+    bool isPanelBusy(bool leading);
+    void setContainer(UCListItem *listItem);
+    void updateContainer();
+
     QQmlComponent *delegate;
     QList<UCAction*> actions;
     QList<QObject*> data;
+    Panel leadingPanel;
+    Panel trailingPanel;
+    UCListItem *container;
+    QMetaObject::Connection containerDestroyed;
 
     static int actions_count(QQmlListProperty<UCAction> *p);
     static void actions_append(QQmlListProperty<UCAction> *p, UCAction *v);
@@ -23,6 +23,7 @@
 #include <QtQuick/private/qquickflickable_p.h>
 
 #include "uclistitem_p_p.h"
+#include "uclistitemactions_p_p.h"
 #include "i18n_p.h"
 
 UT_NAMESPACE_BEGIN
@@ -103,7 +104,8 @@ void UCListItemStyle::componentComplete()
  */
 int UCListItemStyle::index()
 {
-    return UCListItemPrivate::get(m_listItem)->index();
+    // recycled styles are not bound to any ListItem while parked
+    return m_listItem ? UCListItemPrivate::get(m_listItem)->index() : -1;
 }
 
 /*!
@@ -125,6 +127,53 @@ void UCListItemStyle::updateFlickable(QQuickFlickable *flickable)
     Q_EMIT flickableChanged();
 }
 
+// re-targets the style to an other ListItem when recycled by the ViewItems
+void UCListItemStyle::rebindListItem(UCListItem *listItem)
+{
+    if (m_listItem == listItem) {
+        return;
+    }
+    if (m_snapAnimation) {
+        m_snapAnimation->stop();
+        if (m_listItem) {
+            disconnect(m_snapAnimation, SIGNAL(runningChanged(bool)),
+                       m_listItem, SLOT(_q_contentMoving()));
+        }
+    }
+    if (m_dropAnimation) {
+        m_dropAnimation->stop();
+    }
+    m_listItem = listItem;
+    if (m_listItem && m_snapAnimation) {
+        connect(m_snapAnimation, SIGNAL(runningChanged(bool)),
+                m_listItem, SLOT(_q_contentMoving()));
+    }
+    updateFlickable(m_listItem ? UCListItemPrivate::get(m_listItem)->flickable.data() : Q_NULLPTR);
+    Q_EMIT listItemIndexChanged();
+}
+
+/*!
+ * \qmlmethod Item ListItemStyle::mountActionsPanel(ListItemActions actions, Component component, bool leading, Item mount)
+ * \since Ubuntu.Components.Styles 1.3
+ * Returns the panel visualizing the \a actions on the leading or trailing side,
+ * moved into the \a mount item and bound to the ListItem styled. The panel is
+ * created from the \a component on first use and it is shared by all the
+ * ListItems using the same ListItemActions. While the shared panel is still
+ * shown in an other ListItem, e.g. one snapping out, the \a mount gets a panel
+ * of its own, destroyed together with it. The \c itemActions, \c leading and
+ * \c container context properties are provided to the panel, the latter
+ * holding the ListItem the panel is shown in, so the \a component should reach
+ * the ListItem only through it.
+ */
+QQuickItem *UCListItemStyle::mountActionsPanel(UCListItemActions *actions, QQmlComponent *component, bool leading, QQuickItem *mount)
+{
+    UCListItemActionsPrivate *d = UCListItemActionsPrivate::get(actions);
+    if (!d || !component || !mount) {
+        return Q_NULLPTR;
+    }
+    return d->mountPanel(component, leading, m_listItem, mount);
+}
+
 /*!
  * \qmlmethod ListItemStyle::swipeEvent(SwipeEvent event)
  * The function is called by the ListItem when a swipe action is performed, i.e.
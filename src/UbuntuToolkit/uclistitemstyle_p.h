@@ -69,6 +69,7 @@ public:
 };
 
 class UCListItem;
+class UCListItemActions;
 class UBUNTUTOOLKIT_EXPORT UCListItemStyle : public QQuickItem
 {
     Q_OBJECT
@@ -88,6 +89,10 @@ public:
     int index();
     QQuickFlickable *flickable();
     void updateFlickable(QQuickFlickable *flickable);
+    void rebindListItem(UCListItem *listItem);
+
+    Q_REVISION(1) Q_INVOKABLE QQuickItem *mountActionsPanel(UT_PREPEND_NAMESPACE(UCListItemActions) *actions,
+                                                            QQmlComponent *component, bool leading, QQuickItem *mount);
 
 Q_SIGNALS:
     void snapAnimationChanged();
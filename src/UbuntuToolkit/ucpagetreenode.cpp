@@ -32,7 +32,8 @@ UCPageTreeNodePrivate::UCPageTreeNodePrivate()
       m_toolbar(nullptr),
       m_flags(0),
       m_isLeaf(false),
-      m_active(false)
+      m_active(false),
+      m_treeParentNodeValid(false)
 
 {}
 
@@ -132,11 +133,21 @@ void UCPageTreeNodePrivate::updatePageTree()
    \internal
    \brief UCPageTreeNodePrivate::getParentPageTreeNode
    Returns the parent node in the page tree, or null if the item is the root node or invalid.
+   Once the component is complete the result is cached until the item, or one of the items
+   between it and the parent node gets reparented, or the parent node changes its isLeaf.
  */
 UCPageTreeNode *UCPageTreeNodePrivate::getParentPageTreeNode()
 {
     Q_Q(UCPageTreeNode);
+    if (m_treeParentNodeValid) {
+        return m_treeParentNode;
+    }
     UCPageTreeNode *node = nullptr;
+    // QML builds the item tree bottom-up, so do not cache until the tree is complete
+    const bool cache = componentComplete;
+    auto invalidate = [this] () {
+        invalidateTreeParentNode();
+    };
 
     //search the current tree for the next parent item that
     //is a UCPageTreeNode
@@ -151,14 +162,38 @@ UCPageTreeNode *UCPageTreeNodePrivate::getParentPageTreeNode()
                 // current node is part of the tree with currPageTreeNode as its parent.
                 node = currPageTreeNode;
             }
+            if (cache) {
+                m_treeParentWatches << QObject::connect(currPageTreeNode, &UCPageTreeNode::isLeafChanged, q, invalidate);
+            }
             break;
         }
+        if (cache) {
+            m_treeParentWatches << QObject::connect(currItem, &QQuickItem::parentChanged, q, invalidate);
+        }
         currItem = currItem->parentItem();
     }
 
+    if (cache) {
+        m_treeParentNode = node;
+        m_treeParentNodeValid = true;
+    }
     return node;
 }
 
+/*!
+   \internal
+   Drops the cached parent node and stops watching the items it was found through.
+ */
+void UCPageTreeNodePrivate::invalidateTreeParentNode()
+{
+    m_treeParentNodeValid = false;
+    m_treeParentNode.clear();
+    Q_FOREACH(const QMetaObject::Connection &connection, m_treeParentWatches) {
+        QObject::disconnect(connection);
+    }
+    m_treeParentWatches.clear();
+}
+
 /*!
  * \internal
  * \brief UCPageTreeNodePrivate::_q_activeBinding
@@ -388,6 +423,7 @@ void UCPageTreeNode::itemChange(QQuickItem::ItemChange change, const QQuickItem:
     //Likely it changes together with the Items parent
     UCStyledItemBase::itemChange(change, value);
     if (change == QQuickItem::ItemParentHasChanged) {
+        d->invalidateTreeParentNode();
         d->updatePageTree();
     }
 }
@@ -491,6 +527,8 @@ UCPageTreeNode *UCPageTreeNode::parentNode() const
 void UCPageTreeNode::componentComplete()
 {
     UCStyledItemBase::componentComplete();
+    // the parent node may have been looked up while the tree was being built
+    d_func()->invalidateTreeParentNode();
     d_func()->updatePageTree();
 }
 
@@ -17,6 +17,8 @@
 #ifndef UCPAGETREENODE_P_P_H
 #define UCPAGETREENODE_P_P_H
 
+#include <QtCore/QPointer>
+
 #include <UbuntuToolkit/private/ucpagetreenode_p.h>
 
 #include <UbuntuToolkit/private/ucstyleditembase_p_p.h>
@@ -33,6 +35,7 @@ public:
     void init ();
     void updatePageTree ();
     UCPageTreeNode *getParentPageTreeNode ();
+    void invalidateTreeParentNode ();
 
     enum PropertyFlags {
         FirstFlag            = 0x01,
@@ -61,6 +64,10 @@ private:
 
 public:
     UCPageTreeNode *m_parentNode;
+    // the parent node found in the item tree, valid until the item or an
+    // ancestor up to that node gets reparented
+    QPointer<UCPageTreeNode> m_treeParentNode;
+    QList<QMetaObject::Connection> m_treeParentWatches;
     QQuickItem* m_activeLeafNode;
     QQuickItem* m_pageStack;
     QObject* m_propagated;
@@ -68,6 +75,7 @@ public:
     qint8 m_flags;
     bool m_isLeaf:1;
     bool m_active:1;
+    bool m_treeParentNodeValid:1;
 };
 
 UT_NAMESPACE_END
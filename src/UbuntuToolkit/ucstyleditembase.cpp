@@ -20,6 +20,7 @@
 
 #include <QtQml/QQmlEngine>
 #include <QtQuick/private/qquickanchors_p.h>
+#include <UbuntuMetrics/private/tracing_p.h>
 
 #include "ucstylehints_p.h"
 #include "uctheme_p.h"
@@ -356,6 +357,15 @@ void UCStyledItemBasePrivate::preStyleChanged()
     }
 }
 
+// returns the parent of the context the style item is loaded with, which is the
+// creation context of the style component or the context of the styled item
+QQmlContext *UCStyledItemBasePrivate::styleCreationContext(QQmlComponent *component)
+{
+    Q_Q(UCStyledItemBase);
+    QQmlContext *creationContext = component->creationContext();
+    return creationContext ? creationContext : qmlContext(q);
+}
+
 // loads the style animated or not, depending on the loading time
 // returns true on successful style loading
 bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
@@ -364,6 +374,7 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
         // the style loading is delayed
         return false;
     }
+    UMTracingSpan span("loadStyleItem");
     Q_Q(UCStyledItemBase);
     // either styleComponent or styleName is valid
     QQmlComponent *component = styleComponent;
@@ -375,11 +386,7 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
         return false;
     }
     // create context
-    // use creation context as parent to create the context we load the style item with
-    QQmlContext *creationContext = component->creationContext();
-    if (!creationContext) {
-        creationContext = qmlContext(q);
-    }
+    QQmlContext *creationContext = styleCreationContext(component);
     if (creationContext && !creationContext->isValid()) {
         // we are having the changes in the component being under deletion
         return false;
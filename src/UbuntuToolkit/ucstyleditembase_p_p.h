@@ -61,6 +61,7 @@ public:
     virtual void preStyleChanged();
     virtual void postStyleChanged() {}
     virtual bool loadStyleItem(bool animated = true);
+    virtual QQmlContext *styleCreationContext(QQmlComponent *component);
     virtual void completeComponentInitialization();
 
     // from UCImportVersionChecker
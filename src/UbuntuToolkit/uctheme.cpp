@@ -35,6 +35,7 @@
 #define foreach Q_FOREACH
 #include <QtQml/private/qqmlbinding_p.h>
 #undef foreach
+#include <UbuntuMetrics/private/tracing_p.h>
 
 #include "i18n_p.h"
 #include "listener_p.h"
@@ -237,6 +238,10 @@ QString parentThemeName(const UCTheme::ThemeRecord& themePath)
  * Theme::PaletteConfig
  */
 
+// the value sets of the palette which can be configured
+static const char *valueSetNames[] = { "normal", "selected" };
+static const int valueSetCount = sizeof(valueSetNames) / sizeof(valueSetNames[0]);
+
 // builds configuration list and applies the configuration on the palette
 void UCTheme::PaletteConfig::configurePalette(QObject *themePalette)
 {
@@ -313,29 +318,26 @@ void UCTheme::PaletteConfig::buildConfig()
     if (!palette) {
         return;
     }
-    const char* valueSetString[2] = { "normal", "selected" };
-    const QString valueSetQString[2] = { QStringLiteral("normal"), QStringLiteral("selected") };
     QQmlContext *configContext = qmlContext(palette);
 
-    for (int i = 0; i < 2; i++) {
-        QObject *configObject = palette->property(valueSetString[i]).value<QObject*>();
+    for (int i = 0; i < valueSetCount; i++) {
+        QObject *configObject = palette->property(valueSetNames[i]).value<QObject*>();
         const QMetaObject *mo = configObject->metaObject();
 
         for (int ii = mo->propertyOffset(); ii < mo->propertyCount(); ii++) {
             const QMetaProperty prop = mo->property(ii);
-            QString propertyName = QStringLiteral("%1.%2")
-                .arg(valueSetQString[i]).arg(QString::fromLatin1(prop.name()));
-            QQmlProperty configProperty(palette, propertyName, configContext);
+            QString propertyName = QString::fromLatin1(prop.name());
+            QQmlProperty configProperty(configObject, propertyName, configContext);
 
             // first we need to check whether the property has a binding or not
             QQmlAbstractBinding *binding = QQmlPropertyPrivate::binding(configProperty);
             if (binding) {
-                configList << Data(propertyName, configProperty, binding);
+                configList << Data(i, propertyName, configProperty, binding);
             } else {
                 QVariant value = configProperty.read();
                 QColor color = value.value<QColor>();
                 if (color.isValid()) {
-                    configList << Data(propertyName, configProperty);
+                    configList << Data(i, propertyName, configProperty);
                 }
             }
         }
@@ -346,9 +348,16 @@ void UCTheme::PaletteConfig::buildConfig()
 void UCTheme::PaletteConfig::apply(QObject *themePalette)
 {
     QQmlContext *context = qmlContext(themePalette);
+    // resolve the value sets once instead of parsing a dotted name per property
+    QObject *valueSets[valueSetCount];
+    for (int i = 0; i < valueSetCount; i++) {
+        valueSets[i] = themePalette->property(valueSetNames[i]).value<QObject*>();
+    }
     for (int i = 0; i < configList.count(); i++) {
         Data &config = configList[i];
-        config.paletteProperty = QQmlProperty(themePalette, config.propertyName, context);
+        QObject *valueSet = valueSets[config.valueSet];
+        config.paletteProperty = valueSet
+                ? QQmlProperty(valueSet, config.propertyName, context) : QQmlProperty();
 
         // backup
         config.paletteBinding = QQmlPropertyPrivate::binding(config.paletteProperty);
@@ -399,11 +408,24 @@ UCTheme::UCTheme(QObject *parent)
     : QObject(parent)
     , m_parentTheme(Q_NULLPTR)
     , m_palette(Q_NULLPTR)
+    , m_paletteColorStride(0)
+    , m_paletteColorsDirty(true)
+    , m_themedItemsUpdatePending(false)
     , m_completed(false)
 {
     init();
 }
 
+UCTheme::~UCTheme()
+{
+    Q_FOREACH(UCThemingExtension *extension, m_themedItems) {
+        extension->themeIndex = -1;
+    }
+    if (m_parentTheme) {
+        m_parentTheme->m_childThemes.removeOne(this);
+    }
+}
+
 UCTheme *UCTheme::defaultTheme(QQmlEngine *engine)
 {
     if (!engine || !engine->rootContext()) {
@@ -499,7 +521,11 @@ void UCTheme::setParentTheme(UCTheme *parentTheme)
         return;
     }
     Q_ASSERT(parentTheme);
+    if (m_parentTheme) {
+        m_parentTheme->m_childThemes.removeOne(this);
+    }
     m_parentTheme = parentTheme;
+    m_parentTheme->m_childThemes.append(this);
     Q_EMIT parentThemeChanged();
 }
 
@@ -703,21 +729,68 @@ void UCTheme::createDefaultTheme(QQmlEngine* engine)
                      listener, &ContextPropertyChangeListener::updateContextProperty);
 }
 
-void UCTheme::attachItem(QQuickItem *item, bool attach)
+/*
+ * The themed items are kept in a vector, each item knowing its position in it,
+ * so both registering and unregistering is constant time.
+ */
+void UCTheme::attachItem(UCThemingExtension *extension, bool attach)
 {
     if (attach) {
-        m_attachedItems.append(item);
-    } else {
-        m_attachedItems.removeOne(item);
+        Q_ASSERT(extension->themeIndex < 0);
+        extension->themeIndex = m_themedItems.size();
+        m_themedItems.append(extension);
+    } else if (extension->themeIndex >= 0) {
+        Q_ASSERT(m_themedItems.at(extension->themeIndex) == extension);
+        // move the last item into the released slot
+        UCThemingExtension *last = m_themedItems.takeLast();
+        if (last != extension) {
+            m_themedItems[extension->themeIndex] = last;
+            last->themeIndex = extension->themeIndex;
+        }
+        extension->themeIndex = -1;
     }
 }
 
+/*
+ * Theme changes are delivered to the themed items in one pass, so several
+ * changes made within the same frame update the items only once.
+ */
 void UCTheme::updateThemedItems()
 {
-    for (int i = 0; i < m_attachedItems.count(); i++) {
-        UCThemingExtension *extension = qobject_cast<UCThemingExtension*>(m_attachedItems[i]);
-        if (extension) {
-            extension->itemThemeReloaded(this);
+    if (m_themedItemsUpdatePending) {
+        return;
+    }
+    m_themedItemsUpdatePending = true;
+    QMetaObject::invokeMethod(this, "_q_updateThemedItems", Qt::QueuedConnection);
+}
+
+/*
+ * Updates the registered themed items, each of them once. The themes set on
+ * items which have this theme as parent are only notified about the parent
+ * theme change.
+ */
+void UCTheme::_q_updateThemedItems()
+{
+    m_themedItemsUpdatePending = false;
+
+    // items may get deleted or change their theme while their style is reloaded
+    QVector<QPointer<QQuickItem> > items;
+    items.reserve(m_themedItems.size());
+    Q_FOREACH(UCThemingExtension *extension, m_themedItems) {
+        items.append(extension->themedItem);
+    }
+    Q_FOREACH(const QPointer<QQuickItem> &item, items) {
+        UCThemingExtension *extension = qobject_cast<UCThemingExtension*>(item.data());
+        if (extension && extension->theme == this) {
+            extension->preThemeChanged();
+            extension->postThemeChanged();
+        }
+    }
+
+    const QVector<QPointer<UCTheme> > childThemes = m_childThemes;
+    Q_FOREACH(const QPointer<UCTheme> &childTheme, childThemes) {
+        if (childTheme && childTheme->m_parentTheme == this) {
+            Q_EMIT childTheme->parentThemeChanged();
         }
     }
 }
@@ -790,6 +863,7 @@ void UCTheme::loadPalette(QQmlEngine *engine, bool notify)
     if (!engine) {
         return;
     }
+    UMTracingSpan span("loadPalette");
     if (m_palette) {
         // restore bindings to the config palette before we delete
         m_config.restorePalette();
@@ -817,14 +891,123 @@ void UCTheme::loadPalette(QQmlEngine *engine, bool notify)
 // returns the palette color value of a color profile
 QColor UCTheme::getPaletteColor(const char *profile, const char *color)
 {
-    QColor result;
-    if (palette()) {
-        QObject *paletteProfile = m_palette->property(profile).value<QObject*>();
-        if (paletteProfile) {
-            result = paletteProfile->property(color).value<QColor>();
+    return paletteColor(paletteProfile(profile), paletteColorRole(color));
+}
+
+/******************************************************************************
+ * Palette color table
+ *
+ * The colors of the palette are read into a flat table through a single walk
+ * of the palette's meta-objects, so themed items do not need string based
+ * property lookups and QVariant conversions for each color they fetch. The
+ * profile ("normal", "disabled", ...) and color role ("background", ...) names
+ * are interned into indexes shared by all themes, which callers can cache.
+ * The table is rebuilt on first use after any palette value changes.
+ */
+static int internPaletteName(QHash<QByteArray, int> &names, const char *name)
+{
+    auto it = names.constFind(QByteArray::fromRawData(name, qstrlen(name)));
+    if (it != names.constEnd()) {
+        return *it;
+    }
+    const int index = names.size();
+    names.insert(QByteArray(name), index);
+    return index;
+}
+
+typedef QHash<QByteArray, int> PaletteNames;
+Q_GLOBAL_STATIC(PaletteNames, paletteProfileNames)
+Q_GLOBAL_STATIC(PaletteNames, paletteColorRoleNames)
+
+int UCTheme::paletteProfile(const char *profile)
+{
+    return internPaletteName(*paletteProfileNames(), profile);
+}
+
+int UCTheme::paletteColorRole(const char *color)
+{
+    return internPaletteName(*paletteColorRoleNames(), color);
+}
+
+// returns the color of the palette for the profile and color role indexes
+QColor UCTheme::paletteColor(int profile, int colorRole)
+{
+    if (m_paletteColorsDirty || m_paletteColorsPalette != palette()) {
+        buildPaletteColors();
+    }
+    if (profile < 0 || colorRole < 0 || colorRole >= m_paletteColorStride) {
+        return QColor();
+    }
+    const int index = profile * m_paletteColorStride + colorRole;
+    return index < m_paletteColors.size() ? m_paletteColors.at(index) : QColor();
+}
+
+void UCTheme::_q_paletteValueChanged()
+{
+    m_paletteColorsDirty = true;
+}
+
+void UCTheme::trackPaletteObject(QObject *object)
+{
+    static const int slotIndex = staticMetaObject.indexOfSlot("_q_paletteValueChanged()");
+    const QMetaObject *mo = object->metaObject();
+    for (int i = QObject::staticMetaObject.propertyCount(); i < mo->propertyCount(); i++) {
+        const QMetaProperty property = mo->property(i);
+        if (property.hasNotifySignal()) {
+            QMetaObject::connect(object, property.notifySignalIndex(), this, slotIndex, Qt::DirectConnection);
+        }
+    }
+    m_paletteColorSources.append(object);
+}
+
+void UCTheme::buildPaletteColors()
+{
+    static const int slotIndex = staticMetaObject.indexOfSlot("_q_paletteValueChanged()");
+    Q_FOREACH(const QPointer<QObject> &source, m_paletteColorSources) {
+        if (source) {
+            QMetaObject::disconnect(source, -1, this, slotIndex);
+        }
+    }
+    m_paletteColorSources.clear();
+    m_paletteColors.clear();
+    m_paletteColorsPalette = m_palette;
+    m_paletteColorsDirty = false;
+    if (!m_palette) {
+        return;
+    }
+
+    // intern all the names first, so the stride of the table is known
+    QVector<QPair<int, QObject*> > profiles;
+    trackPaletteObject(m_palette);
+    const QMetaObject *mo = m_palette->metaObject();
+    for (int i = QObject::staticMetaObject.propertyCount(); i < mo->propertyCount(); i++) {
+        const QMetaProperty property = mo->property(i);
+        QObject *values = property.read(m_palette).value<QObject*>();
+        if (!values) {
+            continue;
+        }
+        profiles.append(qMakePair(paletteProfile(property.name()), values));
+        trackPaletteObject(values);
+        const QMetaObject *valuesMo = values->metaObject();
+        for (int ii = QObject::staticMetaObject.propertyCount(); ii < valuesMo->propertyCount(); ii++) {
+            paletteColorRole(valuesMo->property(ii).name());
+        }
+    }
+
+    m_paletteColorStride = paletteColorRoleNames()->size();
+    m_paletteColors.resize(paletteProfileNames()->size() * m_paletteColorStride);
+    for (int i = 0; i < profiles.size(); i++) {
+        QObject *values = profiles[i].second;
+        QColor *row = m_paletteColors.data() + profiles[i].first * m_paletteColorStride;
+        const QMetaObject *valuesMo = values->metaObject();
+        for (int ii = QObject::staticMetaObject.propertyCount(); ii < valuesMo->propertyCount(); ii++) {
+            const QMetaProperty property = valuesMo->property(ii);
+            QVariant value = property.read(values);
+            if (value.canConvert<QColor>()) {
+                row[paletteColorRole(property.name())] = value.value<QColor>();
+            }
         }
     }
-    return result;
 }
 
 UT_NAMESPACE_END
@@ -24,13 +24,14 @@
 #include <QtCore/QPointer>
 #include <QtCore/QString>
 #include <QtCore/QUrl>
+#include <QtCore/QVector>
+#include <QtGui/QColor>
 #include <QtQml/QQmlComponent>
 #include <QtQml/QQmlParserStatus>
 #include <QtQml/QQmlProperty>
 #if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
 #include <QtQml/private/qqmlabstractbinding_p.h>
 #endif
-#include <QtQml/private/qpodvector_p.h>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 #include <UbuntuToolkit/private/ucdefaulttheme_p.h>
@@ -43,6 +44,7 @@ class QQuickItem;
 UT_NAMESPACE_BEGIN
 
 class UCStyledItemBase;
+class UCThemingExtension;
 class UBUNTUTOOLKIT_EXPORT UCTheme : public QObject, public QQmlParserStatus
 {
     Q_OBJECT
@@ -72,6 +74,7 @@ public:
     };
 
     explicit UCTheme(QObject *parent = 0);
+    ~UCTheme();
     static UCTheme *defaultTheme(QQmlEngine *engine);
 
     // getter/setters
@@ -86,10 +89,14 @@ public:
 
     // internal, used by the deprecated Theme.createStyledComponent()
     QQmlComponent* createStyleComponent(const QString& styleName, QObject* parent, quint16 version = 0);
-    void attachItem(QQuickItem *item, bool attach);
+    void attachItem(UCThemingExtension *extension, bool attach);
 
     // helper functions
     QColor getPaletteColor(const char *profile, const char *color);
+    // palette color table, profiles and colors identified by interned names
+    static int paletteProfile(const char *profile);
+    static int paletteColorRole(const char *color);
+    QColor paletteColor(int profile, int colorRole);
 
 Q_SIGNALS:
     void parentThemeChanged();
@@ -107,6 +114,8 @@ protected:
 private Q_SLOTS:
     void resetPalette();
     void _q_defaultThemeChanged();
+    void _q_paletteValueChanged();
+    void _q_updateThemedItems();
 
 private:
     static void createDefaultTheme(QQmlEngine* engine);
@@ -117,6 +126,8 @@ private:
     QUrl styleUrl(const QString& styleName, quint16 version, bool *isFallback = NULL);
     void loadPalette(QQmlEngine *engine, bool notify = true);
     void updateThemedItems();
+    void buildPaletteColors();
+    void trackPaletteObject(QObject *object);
 
     class PaletteConfig
     {
@@ -142,13 +153,15 @@ private:
         void apply(QObject *palette);
 
         struct Data {
-            Data(const QString &name, const QQmlProperty &prop)
-                : propertyName(name), configProperty(prop), configBinding(0), paletteBinding(0)
+            Data(int valueSet, const QString &name, const QQmlProperty &prop)
+                : valueSet(valueSet), propertyName(name), configProperty(prop), configBinding(0), paletteBinding(0)
             {}
-            Data(const QString &name, const QQmlProperty &prop, QQmlAbstractBinding *binding)
-                : propertyName(name), configProperty(prop), configBinding(binding), paletteBinding(0)
+            Data(int valueSet, const QString &name, const QQmlProperty &prop, QQmlAbstractBinding *binding)
+                : valueSet(valueSet), propertyName(name), configProperty(prop), configBinding(binding), paletteBinding(0)
             {}
 
+            // index into the value sets, propertyName is relative to it
+            int valueSet;
             QString propertyName;
             QQmlProperty configProperty;
             QQmlProperty paletteProperty;
@@ -173,7 +186,16 @@ private:
     QPointer<QObject> m_palette; // the palette might be from the default style if the theme doesn't define palette
     QList<ThemeRecord> m_themePaths;
     UCDefaultTheme m_defaultTheme;
-    QPODVector<QQuickItem*, 4> m_attachedItems;
+    QVector<UCThemingExtension*> m_themedItems;
+    // themes having this theme as parent
+    QVector<QPointer<UCTheme> > m_childThemes;
+    // colors of the palette indexed by [profile * m_paletteColorStride + colorRole]
+    QVector<QColor> m_paletteColors;
+    QVector<QPointer<QObject> > m_paletteColorSources;
+    QPointer<QObject> m_paletteColorsPalette;
+    int m_paletteColorStride;
+    bool m_paletteColorsDirty:1;
+    bool m_themedItemsUpdatePending:1;
     bool m_completed:1;
 
     friend class UCDeprecatedTheme;
@@ -51,21 +51,6 @@ void notifyThemeChange(QQuickItem *item, UCTheme *oldTheme, UCTheme *newTheme)
     }
 }
 
-void notifyThemeReloaded(QQuickItem *item, UCTheme *theme)
-{
-    Q_FOREACH(QQuickItem *child, item->childItems()) {
-        UCThemingExtension *extension = qobject_cast<UCThemingExtension*>(child);
-        if (extension) {
-            extension->itemThemeReloaded(theme);
-        }
-        // StyledItem will handle the broadcast itself depending on whether the theme change was appropriate or not
-        // and will complete the ascendantStyled/theme itself
-        if (!extension) {
-            notifyThemeReloaded(child, theme);
-        }
-    }
-}
-
 /*************************************************************************
  * Attached to every Item in the system
  */
@@ -174,6 +159,7 @@ UCThemingExtension::UCThemingExtension(QQuickItem *extendedItem)
     : theme(Q_NULLPTR)
     , themedItem(extendedItem)
     , themeType(Inherited)
+    , themeIndex(-1)
 {
     themedItem->setUserData(xdata, new UCItemAttached(themedItem));
 }
@@ -181,7 +167,7 @@ UCThemingExtension::UCThemingExtension(QQuickItem *extendedItem)
 UCThemingExtension::~UCThemingExtension()
 {
     if (theme) {
-        theme->attachItem(themedItem, false);
+        theme->attachItem(this, false);
     }
 }
 
@@ -215,30 +201,6 @@ void UCThemingExtension::itemThemeChanged(UCTheme*, UCTheme *newTheme)
     }
 }
 
-void UCThemingExtension::itemThemeReloaded(UCTheme *theme)
-{
-    switch (themeType) {
-    case Inherited: {
-        preThemeChanged();
-        postThemeChanged();
-        return;
-    }
-    case Custom: {
-        if (theme == this->theme) {
-            preThemeChanged();
-            postThemeChanged();
-            // forward to children
-            notifyThemeReloaded(themedItem, theme);
-        } else {
-            // emit theme's parentThemeChanged()
-            Q_EMIT this->theme->parentThemeChanged();
-        }
-        return;
-    }
-    default: break;
-    }
-}
-
 UCTheme *UCThemingExtension::getTheme()
 {
     if (!theme) {
@@ -250,7 +212,7 @@ UCTheme *UCThemingExtension::getTheme()
             qCritical().noquote() << msg;
             return Q_NULLPTR;
         }
-        theme->attachItem(themedItem, true);
+        theme->attachItem(this, true);
     }
     return theme;
 }
@@ -268,14 +230,14 @@ void UCThemingExtension::setTheme(UCTheme *newTheme, ThemeType type)
 
     // disconnect from the previous set
     if (theme) {
-        theme->attachItem(themedItem, false);
+        theme->attachItem(this, false);
     }
 
     theme = newTheme;
 
     // connect to the new set
     if (theme) {
-        theme->attachItem(themedItem, true);
+        theme->attachItem(this, true);
         // set the parent of the theme if custom
         setParentTheme();
     }
@@ -46,7 +46,6 @@ public:
     virtual void preThemeChanged() = 0;
     virtual void postThemeChanged() = 0;
     virtual void itemThemeChanged(UCTheme *, UCTheme*);
-    virtual void itemThemeReloaded(UCTheme *);
 
     UCTheme *getTheme();
     void setTheme(UCTheme *newTheme, ThemeType type = Custom);
@@ -59,8 +58,12 @@ private:
     QPointer<UCTheme> theme;
     QQuickItem *themedItem;
     ThemeType themeType;
+    // position in the theme's registry, -1 if not registered
+    int themeIndex;
 
     void setParentTheme();
+
+    friend class UCTheme;
 };
 
 UT_NAMESPACE_END
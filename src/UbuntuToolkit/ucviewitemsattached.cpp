@@ -15,9 +15,11 @@
  */
 
 #include <QtCore/QAbstractItemModel>
+#include <QtQml/QQmlContext>
 #include <QtQml/QQmlInfo>
 #include <QtQml/private/qqmlcomponentattached_p.h>
 #include <QtQml/private/qqmldelegatemodel_p.h>
+#include <QtQml/private/qqmlglobal_p.h>
 #include <QtQml/private/qqmlobjectmodel_p.h>
 #include <QtQuick/private/qquickflickable_p.h>
 
@@ -111,6 +113,7 @@ UCViewItemsAttachedPrivate::UCViewItemsAttachedPrivate()
     , selectable(false)
     , draggable(false)
     , ready(false)
+    , recycleDelegates(false)
 {
 }
 
@@ -191,6 +194,13 @@ UCViewItemsAttached::UCViewItemsAttached(QObject *owner)
 
 UCViewItemsAttached::~UCViewItemsAttached()
 {
+    Q_D(UCViewItemsAttached);
+    // destroy the recycled styles before the placeholder they are bound to
+    Q_FOREACH(const UCViewItemsAttachedPrivate::RecycledStyle &recycled, d->recycledStyles) {
+        delete recycled.style.data();
+    }
+    d->recycledStyles.clear();
+    delete d->placeholder.data();
 }
 
 UCViewItemsAttached *UCViewItemsAttached::qmlAttachedProperties(QObject *owner)
@@ -696,4 +706,95 @@ void UCViewItemsAttachedPrivate::toggleExpansionFlags(bool enable)
     }
 }
 
+/*!
+ * \qmlattachedproperty bool ViewItems::recycleDelegates
+ * \since Ubuntu.Components 1.3
+ * When set, the style of the ListItems scrolled out of the ListView is kept
+ * and reused by the ListItems scrolled in, instead of being destroyed and
+ * created again. The recycled style is reset and bound to the new ListItem,
+ * which keeps its own swipe, selection and expansion state. Recycling affects
+ * only ListItems styled through the theme whose style got loaded while recycling
+ * was on, and is worth turning on for long lists scrolled in selection or drag
+ * mode, where each ListItem loads its style. Defaults to false.
+ */
+bool UCViewItemsAttached::recycleDelegates() const
+{
+    Q_D(const UCViewItemsAttached);
+    return d->recycleDelegates;
+}
+void UCViewItemsAttached::setRecycleDelegates(bool recycle)
+{
+    Q_D(UCViewItemsAttached);
+    if (d->recycleDelegates == recycle) {
+        return;
+    }
+    d->recycleDelegates = recycle;
+    if (!recycle) {
+        d->clearRecycledStyles();
+    }
+    Q_EMIT recycleDelegatesChanged();
+}
+
+// returns true if a ListItem leaving the view can park its style
+bool UCViewItemsAttachedPrivate::canRecycleStyle()
+{
+    return recycleDelegates && listView && recycledStyles.size() < MAX_RECYCLED_STYLES;
+}
+
+// the context theme styles are created in while recycling is on; it is the
+// context of the view, which outlives the delegates
+QQmlContext *UCViewItemsAttachedPrivate::recycledStyleContext()
+{
+    Q_Q(UCViewItemsAttached);
+    QQmlContext *context = recycleDelegates && listView ? qmlContext(q->parent()) : Q_NULLPTR;
+    return (context && context->isValid()) ? context : Q_NULLPTR;
+}
+
+void UCViewItemsAttachedPrivate::pushRecycledStyle(const RecycledStyle &recycled)
+{
+    Q_Q(UCViewItemsAttached);
+    QQml_setParent_noEvent(recycled.style.data(), q);
+    recycledStyles.append(recycled);
+}
+
+// returns the last parked style matching the theme and style document, or an
+// empty record if there is none
+UCViewItemsAttachedPrivate::RecycledStyle UCViewItemsAttachedPrivate::takeRecycledStyle(UCTheme *theme, const QString &document, quint16 version)
+{
+    for (int i = recycledStyles.size() - 1; theme && i >= 0; i--) {
+        const RecycledStyle &recycled = recycledStyles[i];
+        if (!recycled.style || !recycled.context || !recycled.theme) {
+            recycledStyles.removeAt(i);
+            continue;
+        }
+        if (recycled.theme == theme && recycled.themeName == theme->name()
+                && recycled.document == document && recycled.version == version) {
+            return recycledStyles.takeAt(i);
+        }
+    }
+    return RecycledStyle();
+}
+
+void UCViewItemsAttachedPrivate::clearRecycledStyles()
+{
+    Q_FOREACH(const RecycledStyle &recycled, recycledStyles) {
+        if (recycled.style) {
+            // delay deletion to avoid property cache messing
+            recycled.style->deleteLater();
+        }
+    }
+    recycledStyles.clear();
+}
+
+// the ListItem the parked styles are bound to; it is never shown
+UCListItem *UCViewItemsAttachedPrivate::stylePlaceholder()
+{
+    if (!placeholder) {
+        Q_Q(UCViewItemsAttached);
+        placeholder = new UCListItem;
+        QQml_setParent_noEvent(placeholder.data(), q);
+    }
+    return placeholder;
+}
+
 UT_NAMESPACE_END
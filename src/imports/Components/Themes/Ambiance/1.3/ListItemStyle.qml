@@ -46,19 +46,24 @@ Styles.ListItemStyle {
     LayoutMirroring.childrenInherit: true
 
     // leading/trailing panels
+    // A panel is created once per ListItemActions and side, and shared by all
+    // the ListItems using the same ListItemActions. It is bound to the ListItem
+    // it is shown in through the container context property, and reaches the
+    // style of that ListItem through the host property, therefore it must not
+    // refer to the ids of this document.
     Component {
         id: panelComponent
         Rectangle {
             id: panel
             objectName: "ListItemPanel" + (leading ? "Leading" : "Trailing")
+            // the style of the ListItem the panel is shown in
+            readonly property Item host: container ? container.__styleInstance : null
             // add 0.5 GUs to the panel size so we get 2GU default margin on the first action
             readonly property real panelWidth: actionsRow.width + units.gu(0.5)
 
-            color: leading ? leadingPanelColor : trailingPanelColor
+            color: host ? (leading ? host.leadingPanelColor : host.trailingPanelColor) : "transparent"
             anchors.fill: parent
 
-            readonly property ListItemActions itemActions: leading ? styledItem.leadingActions : styledItem.trailingActions
-
             Row {
                 id: actionsRow
                 anchors {
@@ -86,13 +91,14 @@ Styles.ListItemStyle {
                             bottom: parent ? parent.bottom : undefined
                         }
                         function trigger() {
-                            internals.selectedAction = modelData;
-                            listItemStyle.rebound();
+                            if (panel.host) {
+                                panel.host.triggerAction(modelData);
+                            }
                         }
 
                         Rectangle {
                             anchors.fill: parent
-                            color: theme.palette.highlighted.background
+                            color: container ? container.theme.palette.highlighted.background : "transparent"
                             visible: pressed
                         }
 
@@ -101,7 +107,7 @@ Styles.ListItemStyle {
                             height: parent.height
                             sourceComponent: itemActions.delegate ? itemActions.delegate : defaultDelegate
                             property Action action: modelData
-                            property int index: listItemIndex
+                            property int index: panel.host ? panel.host.listItemIndex : -1
                             property bool pressed: actionButton.pressed
                             onItemChanged: {
                                 // use action's objectName to identify the visualized action
@@ -124,15 +130,28 @@ Styles.ListItemStyle {
                         height: width
                         name: action.iconName
                         source: action.iconSource
-                        color: leading
-                               ? (action.enabled ? leadingForegroundColor : leadingDisabledForegroundColor)
-                               : (action.enabled ? trailingForegroundColor : trailingDisabledForegroundColor)
+                        color: !panel.host ? "transparent" : leading
+                               ? (action.enabled ? panel.host.leadingForegroundColor : panel.host.leadingDisabledForegroundColor)
+                               : (action.enabled ? panel.host.trailingForegroundColor : panel.host.trailingDisabledForegroundColor)
                         anchors.centerIn: parent
                     }
                 }
             }
         }
     }
+    // holds the shared panel while the ListItem is swiped
+    Component {
+        id: panelMount
+        Item {
+            id: mount
+            property Item panel
+            readonly property real panelWidth: panel ? panel.panelWidth : 0
+            Component.onCompleted: panel = listItemStyle.mountActionsPanel(
+                                       leading ? styledItem.leadingActions : styledItem.trailingActions,
+                                       panelComponent, leading, mount)
+        }
+    }
+
     // the selection/multiselection panel
     Component {
         id: selectionDelegate
@@ -240,7 +259,7 @@ Styles.ListItemStyle {
         }
         width: styledItem.width
         sourceComponent: styledItem.swiped && styledItem.leadingActions && styledItem.leadingActions.actions.length > 0 ?
-                             panelComponent : null
+                             panelMount : null
         // context properties used in delegates
         readonly property bool leading: true
         readonly property bool loaded: status == Loader.Ready
@@ -289,7 +308,7 @@ Styles.ListItemStyle {
         }
         width: styledItem.width
         sourceComponent: styledItem.swiped && styledItem.trailingActions && styledItem.trailingActions.actions.length > 0 ?
-                             panelComponent : null
+                             panelMount : null
         // context properties used in delegates
         readonly property bool leading: false
         readonly property bool loaded: status == Loader.Ready
@@ -424,6 +443,11 @@ Styles.ListItemStyle {
     function rebound() {
         snapAnimation.snapTo(0);
     }
+    // called by the action panels when an action is selected
+    function triggerAction(action) {
+        internals.selectedAction = action;
+        rebound();
+    }
 
     // expansion
     Component.onCompleted: internals.completed = true
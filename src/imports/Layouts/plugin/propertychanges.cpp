@@ -99,6 +99,18 @@ void PropertyAction::setTargetBinding(QQmlAbstractBinding *binding, bool deletab
     deleteToBinding = deletable;
 }
 
+/*
+ * Captures the current binding and value of the property as the state to revert to.
+ * Used when a change list is re-applied, as the original state may have changed
+ * since the list was created.
+ */
+void PropertyAction::saveState()
+{
+    if (!deleteFromBinding) {
+        fromBinding = QQmlPropertyPrivate::binding(property);
+    }
+    fromValue = property.read();
+}
 
 /*
  * Apply property action by setting the target binding (toBinding) or by setting the
@@ -248,6 +260,7 @@ PropertyChange::PropertyChange(QQuickItem *target, const QString &property, cons
 
 void PropertyChange::saveState()
 {
+    action.saveState();
 }
 
 void PropertyChange::apply()
@@ -342,6 +355,7 @@ ItemStackBackup::ItemStackBackup(QQuickItem *item)
 
 void ItemStackBackup::saveState()
 {
+    prevItem = 0;
     QQuickItem *rewindParent = target->parentItem();
     if (!rewindParent) {
         return;
@@ -413,6 +427,9 @@ void AnchorBackup::saveState()
 {
     // no need to call superclass' saveState() as we don't touch the anchor property
     // only its properties
+    for (int i = 0; i < actions.count(); i++) {
+        actions[i].saveState();
+    }
 }
 
 void AnchorBackup::apply()
@@ -448,6 +465,18 @@ ChangeList::~ChangeList()
     clear();
 }
 
+/*
+ * Re-captures the original state of all changes. Must be called before a change
+ * list which has been reverted is applied again.
+ */
+void ChangeList::saveState()
+{
+    QList<PropertyChange*> list = unifiedChanges();
+    for (int i = 0; i < list.count(); i++) {
+        list[i]->saveState();
+    }
+}
+
 void ChangeList::apply()
 {
     QList<PropertyChange*> list = unifiedChanges();
@@ -475,6 +504,23 @@ void ChangeList::clear()
     }
 }
 
+bool ChangeList::isEmpty() const
+{
+    for (int priority = PropertyChange::High; priority < PropertyChange::MaxPriority; priority++) {
+        if (!changes[priority].isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ChangeList::swap(ChangeList &other)
+{
+    for (int priority = PropertyChange::High; priority < PropertyChange::MaxPriority; priority++) {
+        changes[priority].swap(other.changes[priority]);
+    }
+}
+
 ChangeList &ChangeList::addChange(PropertyChange *change)
 {
     if (change && (change->priority() < PropertyChange::MaxPriority)) {
@@ -41,6 +41,7 @@ public:
 
     void setValue(const QVariant &value);
     void setTargetBinding(QQmlAbstractBinding *binding, bool deletable);
+    void saveState();
     void apply();
     void reset();
     void revert(bool reset = false);
@@ -200,13 +201,17 @@ protected:
 class ULConditionalLayoutAttached;
 class ChangeList
 {
+    Q_DISABLE_COPY(ChangeList)
 public:
     ChangeList(){}
     ~ChangeList();
 
+    void saveState();
     void apply();
     void revert();
     void clear();
+    bool isEmpty() const;
+    void swap(ChangeList &other);
 
     ChangeList &addChange(PropertyChange *change);
     ChangeList &addParentChange(QQuickItem *item, QQuickItem *newParent, bool topmostItem);
@@ -31,8 +31,13 @@ ULLayoutsPrivate::ULLayoutsPrivate(ULLayouts *qq)
     , currentLayoutItem(0)
     , previousLayoutItem(0)
     , contentItem(new QQuickItem)
+    , activeLayout(0)
+    , incubatedLayout(0)
+    , instanceContext(0)
     , currentLayoutIndex(-1)
     , ready(false)
+    , cacheLayouts(false)
+    , preloadLayouts(false)
 {
     // hidden container for the components that are not laid out
     // any component not subject of layout is reparented into this component
@@ -40,6 +45,12 @@ ULLayoutsPrivate::ULLayoutsPrivate(ULLayouts *qq)
     contentItem->setParentItem(qq);
 }
 
+ULLayoutsPrivate::~ULLayoutsPrivate()
+{
+    // the cached layout items are deleted together with the Layouts
+    qDeleteAll(preloaders);
+}
+
 
 /******************************************************************************
  * QQmlListProperty functions
@@ -68,6 +79,7 @@ ULConditionalLayout *ULLayoutsPrivate::at_layout(QQmlListProperty<ULConditionalL
 void ULLayoutsPrivate::clear_layouts(QQmlListProperty<ULConditionalLayout> *list)
 {
     ULLayouts *_this = static_cast<ULLayouts*>(list->object);
+    _this->d_ptr->clearLayoutCache();
     _this->d_ptr->layouts.clear();
 }
 
@@ -77,12 +89,15 @@ void ULLayoutsPrivate::clear_layouts(QQmlListProperty<ULConditionalLayout> *list
  * QQmlIncubator stuff
  */
 void ULLayoutsPrivate::setInitialState(QObject *object)
+{
+    initLayoutItem(object);
+}
+
+void ULLayoutsPrivate::initLayoutItem(QObject *object)
 {
     Q_Q(ULLayouts);
-    // object context's parent is the creation context; link it to the object so we
-    // delete them together
-    qmlContext(object)->parentContext()->setParent(object);
-    // set parent
+    // set parent; the creation context is shared by all the instances and
+    // stays owned by the Layouts
     object->setParent(q);
     QQuickItem *item = static_cast<QQuickItem*>(object);
     // set disabled and invisible, and set its parent as last action
@@ -103,29 +118,189 @@ void ULLayoutsPrivate::statusChanged(Status status)
         // reset the layout
         currentLayoutItem = qobject_cast<QQuickItem*>(object());
         Q_ASSERT(currentLayoutItem);
+        activeLayout = incubatedLayout;
+        incubatedLayout = 0;
 
-        //reparent components to be laid out
-        reparentItems();
-        // set parent item, then enable and show layout
-        changes.addChange(new ParentChange(currentLayoutItem, q, false));
-
-        // hide default layout, then show the new one
-        // there's no need to queue these property changes as we do not need
-        // to back up their previosus states
-        contentItem->setVisible(false);
-        currentLayoutItem->setVisible(true);
-        // apply changes
-        changes.apply();
+        showLayout();
         // clear previous layout
         delete previousLayoutItem;
         previousLayoutItem = 0;
 
         Q_EMIT q->currentLayoutChanged();
+        preload();
     } else if (status == Error) {
         error(q, errors());
     }
 }
 
+/*
+ * Lays out the items into the current layout item and shows it. Cached layouts
+ * already have their changes, those are only re-applied.
+ */
+void ULLayoutsPrivate::showLayout()
+{
+    Q_Q(ULLayouts);
+    if (changes.isEmpty()) {
+        //reparent components to be laid out
+        reparentItems();
+        // set parent item, then enable and show layout
+        changes.addChange(new ParentChange(currentLayoutItem, q, false));
+    } else {
+        // the default layout may have changed since the changes were recorded
+        changes.saveState();
+    }
+
+    // hide default layout, then show the new one
+    // there's no need to queue these property changes as we do not need
+    // to back up their previosus states
+    contentItem->setVisible(false);
+    currentLayoutItem->setVisible(true);
+    // apply changes
+    changes.apply();
+}
+
+/*
+ * Moves the current layout item and its (already reverted) changes into the
+ * layout cache.
+ */
+void ULLayoutsPrivate::stashLayout()
+{
+    if (!currentLayoutItem || !activeLayout) {
+        return;
+    }
+    ULLayoutInstance instance;
+    instance.item = currentLayoutItem;
+    instance.changes = QSharedPointer<ChangeList>(new ChangeList);
+    instance.changes->swap(changes);
+    currentLayoutItem->setVisible(false);
+    layoutCache.insert(activeLayout, instance);
+    currentLayoutItem = 0;
+    activeLayout = 0;
+}
+
+/*
+ * Activates the cached instance of the given layout, if there is any. Completes
+ * the preloading of the layout if that is still in progress.
+ */
+bool ULLayoutsPrivate::activateCachedLayout(ULConditionalLayout *layout)
+{
+    Q_FOREACH(ULLayoutPreloader *preloader, preloaders) {
+        if (preloader->layout == layout && preloader->isLoading()) {
+            preloader->forceCompletion();
+        }
+    }
+    if (!layoutCache.contains(layout)) {
+        return false;
+    }
+
+    ULLayoutInstance instance = layoutCache.take(layout);
+    currentLayoutItem = instance.item;
+    activeLayout = layout;
+    if (instance.changes) {
+        changes.swap(*instance.changes);
+    }
+    showLayout();
+
+    Q_Q(ULLayouts);
+    Q_EMIT q->currentLayoutChanged();
+    return true;
+}
+
+/*
+ * Starts incubating the layouts which are neither active nor cached. The incubation
+ * is asynchronous, so it is spread over several frames by the engine.
+ */
+void ULLayoutsPrivate::preload()
+{
+    if (!ready || !cacheLayouts || !preloadLayouts) {
+        return;
+    }
+
+    // drop the incubators which completed already
+    for (int i = preloaders.count() - 1; i >= 0; i--) {
+        if (!preloaders[i]->isLoading()) {
+            delete preloaders.takeAt(i);
+        }
+    }
+
+    QList<ULConditionalLayout*> pending;
+    Q_FOREACH(ULLayoutPreloader *preloader, preloaders) {
+        pending << preloader->layout;
+    }
+    Q_FOREACH(ULConditionalLayout *layout, layouts) {
+        if (!layout || !layout->layout() || layout->layoutName().isEmpty()
+                || layout == activeLayout || layout == incubatedLayout
+                || layoutCache.contains(layout) || pending.contains(layout)) {
+            continue;
+        }
+        ULLayoutPreloader *preloader = new ULLayoutPreloader(this, layout);
+        preloaders.append(preloader);
+        layout->layout()->create(*preloader, layoutContext());
+    }
+}
+
+/*
+ * The context the layout instances are created in. Each instance gets its own
+ * context from the component, so a single one serves all of them. It is owned
+ * by the Layouts, deleting an instance must not take it along.
+ */
+QQmlContext *ULLayoutsPrivate::layoutContext()
+{
+    if (!instanceContext) {
+        Q_Q(ULLayouts);
+        instanceContext = new QQmlContext(qmlContext(q), q);
+    }
+    return instanceContext;
+}
+
+void ULLayoutsPrivate::preloadStatusChanged(ULLayoutPreloader *preloader, Status status)
+{
+    if (status == Ready) {
+        ULLayoutInstance instance;
+        instance.item = qobject_cast<QQuickItem*>(preloader->object());
+        if (!instance.item || preloader->layout == activeLayout
+                || layoutCache.contains(preloader->layout)) {
+            // the layout got activated in the meantime
+            delete preloader->object();
+            return;
+        }
+        layoutCache.insert(preloader->layout, instance);
+    } else if (status == Error) {
+        Q_Q(ULLayouts);
+        error(q, preloader->errors());
+    }
+}
+
+/*
+ * Destroys the cached layout instances and cancels the preloading.
+ */
+void ULLayoutsPrivate::clearLayoutCache()
+{
+    qDeleteAll(preloaders);
+    preloaders.clear();
+    Q_FOREACH(const ULLayoutInstance &instance, layoutCache) {
+        delete instance.item;
+    }
+    layoutCache.clear();
+}
+
+ULLayoutPreloader::ULLayoutPreloader(ULLayoutsPrivate *layouts, ULConditionalLayout *layout)
+    : QQmlIncubator(Asynchronous)
+    , layouts(layouts)
+    , layout(layout)
+{
+}
+
+void ULLayoutPreloader::setInitialState(QObject *object)
+{
+    layouts->initLayoutItem(object);
+}
+
+void ULLayoutPreloader::statusChanged(Status status)
+{
+    layouts->preloadStatusChanged(this, status);
+}
+
 /*
  * Re-parent items to the new layout.
  */
@@ -269,16 +444,25 @@ void ULLayoutsPrivate::reLayout()
 
     // redo changes
     changes.revert();
-    changes.clear();
+    if (cacheLayouts) {
+        stashLayout();
+    } else {
+        changes.clear();
+    }
 
     // clear the incubator before using it
     clear();
-    QQmlComponent *component = layouts[currentLayoutIndex]->layout();
+    incubatedLayout = 0;
+    ULConditionalLayout *layout = layouts[currentLayoutIndex];
+    if (cacheLayouts && activateCachedLayout(layout)) {
+        preload();
+        return;
+    }
+    QQmlComponent *component = layout->layout();
     // create using incubation as it may be created asynchronously,
     // case when the attached properties are not yet enumerated
-    Q_Q(ULLayouts);
-    QQmlContext *context = new QQmlContext(qmlContext(q), q);
-    component->create(*this, context);
+    incubatedLayout = layout;
+    component->create(*this, layoutContext());
 }
 
 /*
@@ -312,12 +496,17 @@ void ULLayoutsPrivate::updateLayout()
     if (currentLayoutIndex >= 0) {
         // revert and clear changes
         changes.revert();
-        changes.clear();
+        if (cacheLayouts) {
+            stashLayout();
+        } else {
+            changes.clear();
+        }
         // make contentItem visible
 
         contentItem->setVisible(true);
         delete currentLayoutItem;
         currentLayoutItem = 0;
+        activeLayout = 0;
         currentLayoutIndex = -1;
         Q_Q(ULLayouts);
         Q_EMIT q->currentLayoutChanged();
@@ -580,6 +769,7 @@ void ULLayouts::componentComplete()
     d->validateConditionalLayouts();
     d->getLaidOutItems(d->contentItem);
     d->updateLayout();
+    d->preload();
 }
 
 void ULLayouts::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
@@ -603,6 +793,58 @@ QString ULLayouts::currentLayout() const
     return d->currentLayoutIndex >= 0 ? d->layouts[d->currentLayoutIndex]->layoutName() : QString();
 }
 
+/*!
+ * \qmlproperty bool Layouts::cacheLayouts
+ * By default the deactivated layouts are destroyed, and re-created when their
+ * condition becomes true again. When the property is set, the deactivated layouts
+ * are kept alive together with the changes laying out the items in them, so
+ * switching back and forth between layouts, i.e. when rotating the device, does
+ * not re-create them. Defaults to false.
+ * \note Items laid out by ItemLayouts created dynamically inside a cached layout,
+ * i.e. by a Repeater, are not reconsidered when the layout is re-activated.
+ */
+bool ULLayouts::cacheLayouts() const
+{
+    Q_D(const ULLayouts);
+    return d->cacheLayouts;
+}
+void ULLayouts::setCacheLayouts(bool cache)
+{
+    Q_D(ULLayouts);
+    if (d->cacheLayouts == cache) {
+        return;
+    }
+    d->cacheLayouts = cache;
+    if (!cache) {
+        d->clearLayoutCache();
+    } else {
+        d->preload();
+    }
+    Q_EMIT cacheLayoutsChanged();
+}
+
+/*!
+ * \qmlproperty bool Layouts::preloadLayouts
+ * When set together with \l cacheLayouts, the inactive layouts are created ahead
+ * of time. The creation is asynchronous, spread over several frames, so the first
+ * activation of a layout does not need to create it. Defaults to false.
+ */
+bool ULLayouts::preloadLayouts() const
+{
+    Q_D(const ULLayouts);
+    return d->preloadLayouts;
+}
+void ULLayouts::setPreloadLayouts(bool preload)
+{
+    Q_D(ULLayouts);
+    if (d->preloadLayouts == preload) {
+        return;
+    }
+    d->preloadLayouts = preload;
+    d->preload();
+    Q_EMIT preloadLayoutsChanged();
+}
+
 /*!
  * \internal
  * Provides a list of layouts for internal use.
@@ -56,6 +56,8 @@ class ULLayouts : public QQuickItem
 
     Q_PROPERTY(QString currentLayout READ currentLayout NOTIFY currentLayoutChanged DESIGNABLE false)
     Q_PROPERTY(QQmlListProperty<ULConditionalLayout> layouts READ layouts DESIGNABLE false)
+    Q_PROPERTY(bool cacheLayouts READ cacheLayouts WRITE setCacheLayouts NOTIFY cacheLayoutsChanged)
+    Q_PROPERTY(bool preloadLayouts READ preloadLayouts WRITE setPreloadLayouts NOTIFY preloadLayoutsChanged)
 
     Q_PROPERTY(QQmlListProperty<QObject> data READ data DESIGNABLE false)
     Q_PROPERTY(QQmlListProperty<QQuickItem> children READ children DESIGNABLE false)
@@ -69,9 +71,15 @@ public:
     QString currentLayout() const;
     QList<ULConditionalLayout*> layoutList();
     QQuickItem *contentItem() const;
+    bool cacheLayouts() const;
+    void setCacheLayouts(bool cache);
+    bool preloadLayouts() const;
+    void setPreloadLayouts(bool preload);
 
 Q_SIGNALS:
     void currentLayoutChanged();
+    void cacheLayoutsChanged();
+    void preloadLayoutsChanged();
 
 protected:
     void componentComplete() override;
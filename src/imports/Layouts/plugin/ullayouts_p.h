@@ -21,6 +21,7 @@
 
 #include "ullayouts.h"
 
+#include <QtCore/QSharedPointer>
 #include <QtQml/QQmlIncubator>
 
 #include "propertychanges_p.h"
@@ -28,12 +29,37 @@
 typedef QHash<QString, QQuickItem*> LaidOutItemsMap;
 typedef QHashIterator<QString, QQuickItem*> LaidOutItemsMapIterator;
 
+// an inactive layout instance kept alive together with the changes which lay
+// out the items into it; changes is empty for preloaded layouts
+struct ULLayoutInstance {
+    QQuickItem *item;
+    QSharedPointer<ChangeList> changes;
+};
+typedef QHash<ULConditionalLayout*, ULLayoutInstance> LayoutInstanceCache;
+
+class QQmlContext;
+class ULLayoutsPrivate;
+class ULLayoutPreloader : public QQmlIncubator
+{
+public:
+    ULLayoutPreloader(ULLayoutsPrivate *layouts, ULConditionalLayout *layout);
+
+    ULLayoutsPrivate *layouts;
+    ULConditionalLayout *layout;
+
+protected:
+    void setInitialState(QObject *object) override;
+    void statusChanged(Status status) override;
+};
+
 class ULItemLayout;
 class ULLayoutsPrivate : QQmlIncubator {
     Q_DECLARE_PUBLIC(ULLayouts)
+    friend class ULLayoutPreloader;
 public:
 
     ULLayoutsPrivate(ULLayouts *qq);
+    ~ULLayoutsPrivate();
 
     void validateConditionalLayouts();
     void getLaidOutItems(QQuickItem *item);
@@ -55,8 +81,15 @@ private:
     QQuickItem* currentLayoutItem;
     QQuickItem* previousLayoutItem;
     QQuickItem* contentItem;
+    ULConditionalLayout *activeLayout;
+    ULConditionalLayout *incubatedLayout;
+    LayoutInstanceCache layoutCache;
+    QList<ULLayoutPreloader*> preloaders;
+    QQmlContext *instanceContext;
     int currentLayoutIndex;
     bool ready:1;
+    bool cacheLayouts:1;
+    bool preloadLayouts:1;
 
     // callbacks for the "layouts" QQmlListProperty of ULLayouts
     static void append_layout(QQmlListProperty<ULConditionalLayout>*, ULConditionalLayout*);
@@ -65,6 +98,14 @@ private:
     static void clear_layouts(QQmlListProperty<ULConditionalLayout>*);
 
     void reLayout();
+    void showLayout();
+    void stashLayout();
+    bool activateCachedLayout(ULConditionalLayout *layout);
+    void preload();
+    void preloadStatusChanged(ULLayoutPreloader *preloader, Status status);
+    void clearLayoutCache();
+    QQmlContext *layoutContext();
+    void initLayoutItem(QObject *object);
     void reparentItems();
     QList<ULItemLayout*> collectContainers(QQuickItem *fromItem);
     void reparentToItemLayout(LaidOutItemsMap &map, ULItemLayout *fragment);
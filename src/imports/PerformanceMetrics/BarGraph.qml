@@ -41,7 +41,7 @@ Item {
 
     PerformanceMetrics.TextureFromImage {
         id: texture
-        image: graph.model.image
+        model: graph.model
     }
 
     ShaderEffect {
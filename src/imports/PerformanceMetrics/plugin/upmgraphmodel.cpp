@@ -24,24 +24,26 @@ UPMGraphModel::UPMGraphModel(QObject *parent) :
     QObject(parent),
     m_shift(0),
     m_samples(100),
-    m_currentValue(0)
+    m_currentValue(0),
+    m_columnsWritten(0),
+    m_generation(0)
 {
     m_image = QImage(m_samples, 1, QImage::Format_RGB32);
     m_image.fill(0);
 }
 
+/* The image is a circular buffer of columns, shift being the next column to
+   be written. Consumers keep track of columnsWritten() and only upload the
+   columns written since they last looked, see UPMGraphTexture. Nobody is
+   supposed to keep a reference to the image, so writing to it never triggers
+   a deep copy.
+*/
 void UPMGraphModel::appendValue(int width, int value)
 {
-    /* FIXME: modifying m_image here implicitly triggers a deep copy
-       of its data because UCTextureFromImage usually holds a reference
-       to that image
-    */
-    width = qMax(1, width);
+    width = qBound(1, width, m_image.width());
     QRgb* line = (QRgb*)m_image.scanLine(0);
 
-    if (width >= m_image.width()) {
-        memset(&line[0], value, m_image.width() * 4);
-    } else if (m_shift + width > m_image.width()) {
+    if (m_shift + width > m_image.width()) {
         int after = m_image.width() - m_shift;
         int before = width - after;
         memset(&line[m_shift], value, after * 4);
@@ -50,6 +52,7 @@ void UPMGraphModel::appendValue(int width, int value)
         memset(&line[m_shift], value, width * 4);
     }
     m_shift = (m_shift + width) % m_samples;
+    m_columnsWritten += width;
     m_currentValue = value;
 
     Q_EMIT imageChanged();
@@ -78,8 +81,12 @@ void UPMGraphModel::setSamples(int samples)
         m_samples = samples;
         m_image = QImage(m_samples, 1, QImage::Format_RGB32);
         m_image.fill(0);
+        m_shift = 0;
+        m_columnsWritten = 0;
+        m_generation++;
         Q_EMIT samplesChanged();
         Q_EMIT imageChanged();
+        Q_EMIT shiftChanged();
     }
 }
 
@@ -87,3 +94,14 @@ int UPMGraphModel::currentValue() const
 {
     return m_currentValue;
 }
+
+qint64 UPMGraphModel::columnsWritten() const
+{
+    return m_columnsWritten;
+}
+
+// incremented each time the image is recreated
+int UPMGraphModel::generation() const
+{
+    return m_generation;
+}
@@ -41,6 +41,8 @@ public:
     int shift() const;
     int samples() const;
     int currentValue() const;
+    qint64 columnsWritten() const;
+    int generation() const;
 
     // setters
     void setSamples(int samples);
@@ -56,6 +58,8 @@ private:
     int m_shift;
     int m_samples;
     int m_currentValue;
+    qint64 m_columnsWritten;
+    int m_generation;
 };
 
 #endif // UPMGRAPHMODEL_H
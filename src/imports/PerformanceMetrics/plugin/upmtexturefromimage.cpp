@@ -17,9 +17,125 @@
  */
 
 #include "upmtexturefromimage.h"
+#include "upmgraphmodel.h"
 
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
 #include <QtQuick/QQuickWindow>
 
+UPMGraphTexture::UPMGraphTexture() :
+    QSGTexture(),
+    m_model(NULL),
+    m_textureId(0),
+    m_generation(-1),
+    m_columnsWritten(0),
+    m_dirtyFrom(0),
+    m_dirtyCount(0),
+    m_reallocate(true)
+{
+}
+
+UPMGraphTexture::~UPMGraphTexture()
+{
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (m_textureId != 0 && context != NULL) {
+        context->functions()->glDeleteTextures(1, &m_textureId);
+    }
+}
+
+int UPMGraphTexture::textureId() const
+{
+    return m_textureId;
+}
+
+QSize UPMGraphTexture::textureSize() const
+{
+    return m_image.size();
+}
+
+bool UPMGraphTexture::hasAlphaChannel() const
+{
+    return false;
+}
+
+bool UPMGraphTexture::hasMipmaps() const
+{
+    return false;
+}
+
+/* Called from the scene graph synchronization, while the GUI thread is
+   blocked. Only copies the columns written since the previous call.
+*/
+void UPMGraphTexture::sync(UPMGraphModel* model)
+{
+    const QImage image = model->image();
+    if (model != m_model || model->generation() != m_generation || image.size() != m_image.size()) {
+        m_image = image.copy();
+        m_model = model;
+        m_generation = model->generation();
+        m_columnsWritten = model->columnsWritten();
+        m_dirtyFrom = 0;
+        m_dirtyCount = m_image.width();
+        m_reallocate = true;
+        return;
+    }
+
+    const int width = m_image.width();
+    const int count = qMin<qint64>(model->columnsWritten() - m_columnsWritten, width);
+    m_columnsWritten = model->columnsWritten();
+    if (count <= 0) {
+        return;
+    }
+    const int from = (model->shift() - count + width) % width;
+    const QRgb* source = reinterpret_cast<const QRgb*>(image.constScanLine(0));
+    QRgb* target = reinterpret_cast<QRgb*>(m_image.scanLine(0));
+    if (from + count > width) {
+        memcpy(&target[from], &source[from], (width - from) * 4);
+        memcpy(&target[0], &source[0], (from + count - width) * 4);
+    } else {
+        memcpy(&target[from], &source[from], count * 4);
+    }
+
+    // the pending columns always end where the new ones start
+    if (m_dirtyCount == 0) {
+        m_dirtyFrom = from;
+    }
+    m_dirtyCount = qMin(m_dirtyCount + count, width);
+}
+
+void UPMGraphTexture::bind()
+{
+    QOpenGLFunctions* gl = QOpenGLContext::currentContext()->functions();
+    if (m_textureId == 0) {
+        gl->glGenTextures(1, &m_textureId);
+        m_reallocate = true;
+    }
+    gl->glBindTexture(GL_TEXTURE_2D, m_textureId);
+    updateBindOptions(m_reallocate);
+
+    /* The graph only uses the red channel and every byte of a pixel holds the
+       value, so the RGB32 data is uploaded as is without any conversion. */
+    const uchar* bits = m_image.constScanLine(0);
+    if (m_reallocate) {
+        gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_image.width(), 1, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, bits);
+        m_reallocate = false;
+    } else if (m_dirtyCount > 0) {
+        const int width = m_image.width();
+        if (m_dirtyFrom + m_dirtyCount > width) {
+            gl->glTexSubImage2D(GL_TEXTURE_2D, 0, m_dirtyFrom, 0, width - m_dirtyFrom, 1,
+                                GL_RGBA, GL_UNSIGNED_BYTE, bits + m_dirtyFrom * 4);
+            gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_dirtyFrom + m_dirtyCount - width, 1,
+                                GL_RGBA, GL_UNSIGNED_BYTE, bits);
+        } else {
+            gl->glTexSubImage2D(GL_TEXTURE_2D, 0, m_dirtyFrom, 0, m_dirtyCount, 1,
+                                GL_RGBA, GL_UNSIGNED_BYTE, bits + m_dirtyFrom * 4);
+        }
+    }
+    m_dirtyCount = 0;
+}
+
+
 UPMTextureFromImageTextureProvider::UPMTextureFromImageTextureProvider() :
     QSGTextureProvider(),
     m_texture(NULL)
@@ -76,19 +192,44 @@ bool UPMTextureFromImage::isTextureProvider() const
 QSGTextureProvider* UPMTextureFromImage::textureProvider() const
 {
     if (m_textureProvider == NULL) {
-        const_cast<UPMTextureFromImage*>(this)->m_textureProvider = new UPMTextureFromImageTextureProvider;
-        m_textureProvider->setTexture(window()->createTextureFromImage(m_image));
+        UPMTextureFromImage* self = const_cast<UPMTextureFromImage*>(this);
+        self->m_textureProvider = new UPMTextureFromImageTextureProvider;
+        m_textureProvider->setTexture(self->createTexture());
+        self->m_textureNeedsUpdate = false;
     }
     return m_textureProvider;
 }
 
+/* Graph models are followed by a UPMGraphTexture updated in place. Without
+   OpenGL (software backend) a new texture is created from the image at each
+   change instead.
+*/
+QSGTexture* UPMTextureFromImage::createTexture()
+{
+    if (m_model.isNull()) {
+        return window()->createTextureFromImage(m_image);
+    }
+    if (QOpenGLContext::currentContext() == NULL) {
+        return window()->createTextureFromImage(m_model->image());
+    }
+    UPMGraphTexture* texture = new UPMGraphTexture;
+    texture->sync(m_model);
+    return texture;
+}
+
 QSGNode* UPMTextureFromImage::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData)
 {
     Q_UNUSED(oldNode)
     Q_UNUSED(updatePaintNodeData)
 
     if (m_textureNeedsUpdate && m_textureProvider != NULL) {
-        m_textureProvider->setTexture(window()->createTextureFromImage(m_image));
+        UPMGraphTexture* graphTexture = qobject_cast<UPMGraphTexture*>(m_textureProvider->texture());
+        if (graphTexture != NULL && !m_model.isNull()) {
+            graphTexture->sync(m_model);
+            Q_EMIT m_textureProvider->textureChanged();
+        } else {
+            m_textureProvider->setTexture(createTexture());
+        }
         m_textureNeedsUpdate = false;
     }
     return NULL;
@@ -99,6 +240,11 @@ QImage UPMTextureFromImage::image() const
     return m_image;
 }
 
+UPMGraphModel* UPMTextureFromImage::model() const
+{
+    return m_model;
+}
+
 void UPMTextureFromImage::setImage(QImage image)
 {
     if (image != m_image) {
@@ -108,3 +254,29 @@ void UPMTextureFromImage::setImage(QImage image)
         update();
     }
 }
+
+/* Takes the image from the model instead of the image property. The image
+   is not referenced, so the model can keep writing into it without copies.
+*/
+void UPMTextureFromImage::setModel(UPMGraphModel* model)
+{
+    if (model != m_model) {
+        if (!m_model.isNull()) {
+            QObject::disconnect(m_model, &UPMGraphModel::imageChanged,
+                                this, &UPMTextureFromImage::onModelImageChanged);
+        }
+        m_model = model;
+        if (!m_model.isNull()) {
+            QObject::connect(m_model, &UPMGraphModel::imageChanged,
+                             this, &UPMTextureFromImage::onModelImageChanged);
+        }
+        Q_EMIT modelChanged();
+        onModelImageChanged();
+    }
+}
+
+void UPMTextureFromImage::onModelImageChanged()
+{
+    m_textureNeedsUpdate = true;
+    update();
+}
@@ -19,9 +19,44 @@
 #ifndef UPMTEXTUREFROMIMAGE_H
 #define UPMTEXTUREFROMIMAGE_H
 
+#include <QtCore/QPointer>
 #include <QtQuick/QSGTextureProvider>
 #include <QtQuick/QQuickItem>
 
+#include "upmgraphmodel.h"
+
+/* Texture following the image of a UPMGraphModel, uploading only the
+   columns appended since the previous frame. Requires OpenGL.
+*/
+class UPMGraphTexture : public QSGTexture
+{
+    Q_OBJECT
+
+public:
+    explicit UPMGraphTexture();
+    virtual ~UPMGraphTexture();
+    int textureId() const override;
+    QSize textureSize() const override;
+    bool hasAlphaChannel() const override;
+    bool hasMipmaps() const override;
+    void bind() override;
+
+    void sync(UPMGraphModel* model);
+
+private:
+    // copy of the model image owned by the render thread
+    QImage m_image;
+    // only compared against, never dereferenced
+    const UPMGraphModel* m_model;
+    uint m_textureId;
+    int m_generation;
+    qint64 m_columnsWritten;
+    // columns to upload on next bind
+    int m_dirtyFrom;
+    int m_dirtyCount;
+    bool m_reallocate;
+};
+
 class UPMTextureFromImageTextureProvider : public QSGTextureProvider
 {
     Q_OBJECT
@@ -42,6 +77,7 @@ class UPMTextureFromImage : public QQuickItem
     Q_OBJECT
 
     Q_PROPERTY(QImage image READ image WRITE setImage NOTIFY imageChanged)
+    Q_PROPERTY(UPMGraphModel* model READ model WRITE setModel NOTIFY modelChanged)
 
 public:
     explicit UPMTextureFromImage(QQuickItem* parent = 0);
@@ -50,18 +86,27 @@ public:
     QSGTextureProvider* textureProvider() const override;
     QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData) override;
 
-    // getter
+    // getters
     QImage image() const;
+    UPMGraphModel* model() const;
 
     // setters
     void setImage(QImage image);
+    void setModel(UPMGraphModel* model);
 
 Q_SIGNALS:
     void imageChanged();
+    void modelChanged();
+
+private Q_SLOTS:
+    void onModelImageChanged();
 
 private:
+    QSGTexture* createTexture();
+
     UPMTextureFromImageTextureProvider* m_textureProvider;
     QImage m_image;
+    QPointer<UPMGraphModel> m_model;
     bool m_textureNeedsUpdate;
 };
 
@@ -17,6 +17,10 @@
  */
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QString>
 #include <QtCore/QTextCodec>
 #include <QtCore/QTimeZone>
@@ -40,6 +44,15 @@ class tst_UCAlarms : public QObject
 public:
     tst_UCAlarms() {}
 
+    static QStringList storedMessages(AlarmsAdapter *adapter)
+    {
+        QStringList messages;
+        Q_FOREACH(const QJsonObject &object, adapter->storedAlarms()) {
+            messages << object[QStringLiteral("message")].toString();
+        }
+        return messages;
+    }
+
 Q_SIGNALS:
     void alarmUpdated();
 
@@ -588,6 +601,112 @@ private Q_SLOTS:
         // check the tags
         QVERIFY(AlarmManager::instance().verifyChange(&alarm, AlarmManager::Enabled, enabled));
     }
+
+    void test_bulk_operations()
+    {
+        AlarmsAdapter *adapter = AlarmsAdapter::get();
+        if (adapter->manager->managerName() != QStringLiteral("memory")) {
+            QSKIP("The fallback storage is only used with the memory backend");
+        }
+        const int count = 10000;
+        const int initialCount = AlarmManager::instance().alarmCount();
+        QDateTime date = QDateTime::currentDateTime().addDays(2);
+
+        QList<QOrganizerItem> items;
+        for (int i = 0; i < count; i++) {
+            UCAlarm alarm(date.addSecs(i * 60), QStringLiteral("test_bulk_%1").arg(i));
+            AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
+            QCOMPARE(pAlarm->checkAlarm(), UCAlarm::NoError);
+            items << pAlarm->data();
+        }
+
+        // create: one batch fetch, one journal append
+        int writes = adapter->fileWrites;
+        int requests = adapter->managerRequests;
+        QVERIFY(adapter->manager->saveItems(&items));
+        QTRY_COMPARE(AlarmManager::instance().alarmCount(), initialCount + count);
+        QVERIFY(adapter->managerRequests - requests <= 2);
+        QVERIFY(adapter->fileWrites - writes <= 1);
+        int stored = 0;
+        Q_FOREACH(const QJsonObject &object, adapter->storedAlarms()) {
+            stored += object[QStringLiteral("message")].toString().startsWith(QStringLiteral("test_bulk_"));
+        }
+        QCOMPARE(stored, count);
+
+        // update: the journal gets compacted, verification is served by the batch fetch
+        for (int i = 0; i < count; i++) {
+            items[i].setDisplayLabel(QStringLiteral("test_bulk_updated_%1").arg(i));
+        }
+        writes = adapter->fileWrites;
+        requests = adapter->managerRequests;
+        QVERIFY(adapter->manager->saveItems(&items));
+        QTRY_COMPARE(adapter->storedAlarms().count(), AlarmManager::instance().alarmCount());
+        QVERIFY(adapter->managerRequests - requests <= 2);
+        QVERIFY(adapter->fileWrites - writes <= 1);
+        requests = adapter->managerRequests;
+        for (int i = 0; i < count; i++) {
+            UCAlarm alarm;
+            static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm))->setData(static_cast<QOrganizerTodo>(items[i]));
+            QVERIFY(AlarmManager::instance().verifyChange(&alarm, AlarmManager::Message, items[i].displayLabel()));
+        }
+        QVERIFY(adapter->managerRequests - requests <= 2);
+        stored = 0;
+        Q_FOREACH(const QJsonObject &object, adapter->storedAlarms()) {
+            stored += object[QStringLiteral("message")].toString().startsWith(QStringLiteral("test_bulk_updated_"));
+        }
+        QCOMPARE(stored, count);
+
+        // delete: no manager round-trip at all
+        QList<QOrganizerItemId> ids;
+        Q_FOREACH(const QOrganizerItem &item, items) {
+            ids << item.id();
+        }
+        writes = adapter->fileWrites;
+        requests = adapter->managerRequests;
+        QVERIFY(adapter->manager->removeItems(ids));
+        QTRY_COMPARE(AlarmManager::instance().alarmCount(), initialCount);
+        QCOMPARE(adapter->managerRequests, requests);
+        QVERIFY(adapter->fileWrites - writes <= 1);
+        Q_FOREACH(const QJsonObject &object, adapter->storedAlarms()) {
+            QVERIFY(!object[QStringLiteral("message")].toString().startsWith(QStringLiteral("test_bulk_")));
+        }
+    }
+
+    void test_torn_journal_record()
+    {
+        AlarmsAdapter *adapter = AlarmsAdapter::get();
+        if (adapter->manager->managerName() != QStringLiteral("memory")) {
+            QSKIP("The fallback storage is only used with the memory backend");
+        }
+        // start from a compacted database, then leave a complete record
+        // followed by one torn by an interrupted write in the journal
+        adapter->saveAlarms();
+        QFile journal(QStandardPaths::writableLocation(QStandardPaths::DataLocation) + QStringLiteral("/alarms.journal"));
+        QVERIFY(journal.open(QFile::WriteOnly | QFile::Truncate));
+        QJsonObject complete;
+        complete[QStringLiteral("key")] = 100000;
+        complete[QStringLiteral("message")] = QStringLiteral("test_torn_complete");
+        journal.write(QJsonDocument(complete).toJson(QJsonDocument::Compact) + '\n');
+        journal.write("{\"key\":100001,\"message\":\"test_to");
+        journal.close();
+
+        UCAlarm alarm(QDateTime::currentDateTime().addDays(2), QStringLiteral("test_torn_appended"));
+        AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
+        QCOMPARE(pAlarm->checkAlarm(), UCAlarm::NoError);
+        QOrganizerTodo event = pAlarm->data();
+        QVERIFY(adapter->manager->saveItem(&event));
+
+        // the record appended after the torn one is replayed, the torn one is skipped
+        QTRY_VERIFY(storedMessages(adapter).contains(QStringLiteral("test_torn_appended")));
+        QStringList messages = storedMessages(adapter);
+        QVERIFY(messages.contains(QStringLiteral("test_torn_complete")));
+        QVERIFY(!messages.contains(QStringLiteral("test_to")));
+
+        QVERIFY(adapter->manager->removeItem(event.id()));
+        QTRY_VERIFY(!storedMessages(adapter).contains(QStringLiteral("test_torn_appended")));
+        // drop the hand written record
+        adapter->saveAlarms();
+    }
 };
 
 QTEST_MAIN(tst_UCAlarms)
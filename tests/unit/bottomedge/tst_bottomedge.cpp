@@ -812,6 +812,80 @@ private Q_SLOTS:
         QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase(document));
     }
 
+    void test_region_index_lookup_data()
+    {
+        QTest::addColumn<qreal>("dragRatio");
+
+        QTest::newRow("below regions") << 0.1;
+        QTest::newRow("first region start") << 0.2;
+        QTest::newRow("inside first region") << 0.3;
+        QTest::newRow("overlapping boundary") << 0.4;
+        QTest::newRow("inside overlap") << 0.45;
+        QTest::newRow("first region end") << 0.5;
+        QTest::newRow("inside second region") << 0.55;
+        QTest::newRow("shared boundary") << 0.6;
+        QTest::newRow("top") << 1.0;
+    }
+    void test_region_index_lookup()
+    {
+        QFETCH(qreal, dragRatio);
+
+        QString document("OverlappingRegions.qml");
+        UbuntuTestCase::ignoreWarning(document, 34, 9, "QML BottomEdgeRegion: Region intersects the one from index 0 having from: 0.2 and to: 0.5", 1);
+        UbuntuTestCase::ignoreWarning(document, 37, 9, "QML BottomEdgeRegion: Region intersects the one from index 0 having from: 0.2 and to: 0.5", 1);
+        UbuntuTestCase::ignoreWarning(document, 37, 9, "QML BottomEdgeRegion: Region at index 1 contains this region. This region will never activate.", 1);
+        UbuntuTestCase::ignoreWarning(document, 41, 9, "QML BottomEdgeRegion: Region at index 1 contains this region. This region will never activate.", 1);
+        QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase(document));
+        UCBottomEdgePrivate *privateBottomEdge = UCBottomEdgePrivate::get(test->testItem());
+
+        // the index must pick the same region as a scan in declaration order
+        auto scan = [privateBottomEdge](qreal ratio) -> UCBottomEdgeRegion* {
+            Q_FOREACH(UCBottomEdgeRegion *region, privateBottomEdge->regions) {
+                if (region->contains(ratio)) {
+                    return region;
+                }
+            }
+            return nullptr;
+        };
+        QCOMPARE(privateBottomEdge->regionAt(dragRatio), scan(dragRatio));
+
+        // and follow the region changes
+        privateBottomEdge->regions[0]->setEnabled(false);
+        QCOMPARE(privateBottomEdge->regionAt(dragRatio), scan(dragRatio));
+        privateBottomEdge->regions[1]->setFrom(0.7);
+        QCOMPARE(privateBottomEdge->regionAt(dragRatio), scan(dragRatio));
+    }
+
+    void test_predictive_region_preload()
+    {
+        QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase("AlternateRegionContent.qml"));
+        UCBottomEdge *bottomEdge = test->testItem();
+        UCBottomEdgePrivate *privateBottomEdge = UCBottomEdgePrivate::get(bottomEdge);
+        UCBottomEdgeRegion *region = privateBottomEdge->regions[0];
+        UCBottomEdgeRegionPrivate *privateRegion = UCBottomEdgeRegionPrivate::get(region);
+        // preload when dragging faster than a tenth of the height per second
+        privateBottomEdge->setPreloadVelocity(0.1);
+        QVERIFY(!privateRegion->contentItem);
+
+        // drag fast, stopping before the region
+        QPoint from(bottomEdge->width() / 2.0f, bottomEdge->height() - 5);
+        QPoint to = from + QPoint(0, -(bottomEdge->height() * 0.15));
+        UCTestExtras::touchPress(0, bottomEdge, from);
+        QPoint movePos(from);
+        while (movePos.y() > to.y()) {
+            QTest::qWait(20);
+            UCTestExtras::touchMove(0, bottomEdge, movePos);
+            movePos += QPoint(0, -10);
+        }
+        QTRY_VERIFY_WITH_TIMEOUT(privateRegion->contentItem != nullptr, 1000);
+        QCOMPARE(bottomEdge->activeRegion(), privateBottomEdge->defaultRegion);
+
+        // content not entered is dropped once collapsed
+        UCTestExtras::touchRelease(0, bottomEdge, movePos);
+        QTRY_COMPARE_WITH_TIMEOUT(bottomEdge->status(), UCBottomEdge::Hidden, 1000);
+        QTRY_VERIFY_WITH_TIMEOUT(privateRegion->contentItem == nullptr, 1000);
+    }
+
     void test_region_does_not_activate_when_from_greater_than_to_data()
     {
         QTest::addColumn<bool>("withMouse");
@@ -0,0 +1,8 @@
+include(../test-include.pri)
+
+SOURCES += \
+    tst_componentcache.cpp
+
+DISTFILES += \
+    Document.qml \
+    FaultyDocument.qml
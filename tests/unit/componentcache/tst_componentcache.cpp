@@ -0,0 +1,163 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtQml/QQmlEngine>
+#include <QtQml/QQmlComponent>
+#include <QtTest/QtTest>
+#include <UbuntuToolkit/private/componentcache_p.h>
+
+UT_USE_NAMESPACE
+
+class tst_ComponentCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void test_cache_per_engine()
+    {
+        QQmlEngine engine1, engine2;
+        ComponentCache *cache1 = ComponentCache::forEngine(&engine1);
+        QVERIFY(cache1);
+        QCOMPARE(ComponentCache::forEngine(&engine1), cache1);
+        QVERIFY(ComponentCache::forEngine(&engine2) != cache1);
+        QVERIFY(!ComponentCache::forEngine(nullptr));
+    }
+
+    void test_acquire_invalid_url()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QVERIFY(!cache->acquire(QUrl()));
+        QCOMPARE(cache->misses(), 0);
+    }
+
+    void test_reuse_component()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QUrl document = QUrl::fromLocalFile("Document.qml");
+
+        QQmlComponent *first = cache->acquire(document, QQmlComponent::PreferSynchronous);
+        QVERIFY(first);
+        QTRY_VERIFY(first->isReady());
+        QQmlComponent *second = cache->acquire(document, QQmlComponent::PreferSynchronous);
+        QCOMPARE(second, first);
+        QCOMPARE(cache->misses(), 1);
+        QCOMPARE(cache->hits(), 1);
+
+        // released components stay cached
+        cache->release(first);
+        cache->release(second);
+        QCOMPARE(cache->count(), 1);
+        QCOMPARE(cache->acquire(document), first);
+        QCOMPARE(cache->hits(), 2);
+        cache->release(first);
+    }
+
+    void test_precompile()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QUrl document = QUrl::fromLocalFile("Document.qml");
+
+        cache->precompile(document);
+        QCOMPARE(cache->count(), 1);
+        QCOMPARE(cache->hits() + cache->misses(), 0);
+
+        QQmlComponent *component = cache->acquire(document);
+        QTRY_VERIFY(component->isReady());
+        QCOMPARE(cache->hits(), 1);
+        QCOMPARE(cache->misses(), 0);
+        cache->release(component);
+    }
+
+    void test_synchronous_acquire_while_precompiling()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QUrl document = QUrl::fromLocalFile("Document.qml");
+
+        cache->precompile(document);
+        QQmlComponent *component = cache->acquire(document, QQmlComponent::PreferSynchronous);
+        QVERIFY(component);
+        QVERIFY(component->isReady());
+        QScopedPointer<QObject> object(component->create());
+        QVERIFY(object);
+        QCOMPARE(cache->count(), 1);
+        QCOMPARE(cache->hits(), 1);
+        cache->release(component);
+
+        // the precompiled component got replaced by the ready one
+        QCOMPARE(cache->acquire(document), component);
+        cache->release(component);
+    }
+
+    void test_synchronous_acquire_while_loading()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QUrl document = QUrl::fromLocalFile("Document.qml");
+
+        QQmlComponent *pending = cache->acquire(document);
+        QVERIFY(pending->isLoading());
+        QPointer<QQmlComponent> component = cache->acquire(document, QQmlComponent::PreferSynchronous);
+        QVERIFY(component);
+        QVERIFY(component != pending);
+        QVERIFY(component->isReady());
+        QScopedPointer<QObject> object(component->create());
+        QVERIFY(object);
+
+        // the synchronous component is not shared
+        cache->release(component);
+        QTRY_VERIFY(component.isNull());
+        QCOMPARE(cache->count(), 1);
+        QTRY_VERIFY(pending->isReady());
+        cache->release(pending);
+    }
+
+    void test_cost_limit()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QUrl document = QUrl::fromLocalFile("Document.qml");
+
+        QPointer<QQmlComponent> component = cache->acquire(document, QQmlComponent::PreferSynchronous);
+        cache->setCostLimit(0);
+        // used components are never evicted
+        QCOMPARE(cache->count(), 1);
+        cache->release(component);
+        QCOMPARE(cache->count(), 0);
+        QCOMPARE(cache->totalCost(), 0);
+        QTRY_VERIFY(component.isNull());
+    }
+
+    void test_faulty_component_not_cached()
+    {
+        QQmlEngine engine;
+        ComponentCache *cache = ComponentCache::forEngine(&engine);
+        QUrl document = QUrl::fromLocalFile("FaultyDocument.qml");
+
+        QPointer<QQmlComponent> component = cache->acquire(document, QQmlComponent::PreferSynchronous);
+        QTRY_VERIFY(component->isError());
+        cache->release(component);
+        QCOMPARE(cache->count(), 0);
+        QTRY_VERIFY(component.isNull());
+    }
+};
+
+QTEST_MAIN(tst_ComponentCache)
+
+#include "tst_componentcache.moc"
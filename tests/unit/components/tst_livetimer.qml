@@ -23,6 +23,7 @@ TestCase {
 
     function test_0_defaults() {
         compare(liveTimer.frequency, LiveTimer.Disabled, "Default frequency");
+        compare(liveTimer.suspended, false, "Default suspended");
     }
 
     function test_frequency_data() {
@@ -45,7 +46,28 @@ TestCase {
         compare(liveTimer.relativeTime, new Date(2015, 0, 0, 0, 0, 0, 0), "Can set/get relativeTime")
     }
 
+    function test_suspended() {
+        secondTimer.suspended = true;
+        triggerSpy.clear();
+        wait(1100);
+        compare(triggerSpy.count, 0, "Suspended timer does not trigger");
+        secondTimer.suspended = false;
+        compare(triggerSpy.count, 1, "Resumed timer triggers the missed update");
+        triggerSpy.wait(1100);
+    }
+
     LiveTimer {
         id: liveTimer
     }
+
+    LiveTimer {
+        id: secondTimer
+        frequency: LiveTimer.Second
+    }
+
+    SignalSpy {
+        id: triggerSpy
+        target: secondTimer
+        signalName: "trigger"
+    }
 }
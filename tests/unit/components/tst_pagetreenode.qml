@@ -0,0 +1,95 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtTest 1.0
+import Ubuntu.Components 1.3
+import QtQuick 2.4
+
+TestCase {
+    name: "PageTreeNodeAPI"
+
+    // the tree is built bottom-up, the nested nodes get their intermediate
+    // items as parents before those are attached to the root
+    PageTreeNode {
+        id: root
+        Item {
+            Item {
+                PageTreeNode {
+                    id: nested
+                    Item {
+                        PageTreeNode {
+                            id: nestedChild
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    PageTreeNode {
+        id: leaf
+        isLeaf: true
+        Item {
+            PageTreeNode {
+                id: underLeaf
+            }
+        }
+    }
+
+    PageTreeNode {
+        id: otherRoot
+    }
+
+    Component {
+        id: nestedComponent
+        Item {
+            property alias node: node
+            Item {
+                PageTreeNode {
+                    id: node
+                }
+            }
+        }
+    }
+
+    function test_declarative_nested_nodes() {
+        compare(nested.parentNode, root, "nested node not attached to the root");
+        compare(nestedChild.parentNode, nested, "nested child not attached to its node");
+        compare(root.parentNode, null, "root node has a parent node");
+    }
+
+    function test_children_of_leaf_are_not_in_tree() {
+        compare(underLeaf.parentNode, null, "node under a leaf is part of the tree");
+    }
+
+    function test_created_nested_node() {
+        var holder = nestedComponent.createObject(otherRoot);
+        verify(holder);
+        compare(holder.node.parentNode, otherRoot, "created nested node not attached");
+        holder.destroy();
+    }
+
+    function test_reparent_updates_parent_node() {
+        var holder = nestedComponent.createObject(root);
+        compare(holder.node.parentNode, root);
+        // reparenting the node itself looks up the new parent node
+        holder.node.parent = otherRoot;
+        compare(holder.node.parentNode, otherRoot);
+        holder.node.parent = leaf;
+        compare(holder.node.parentNode, null);
+        holder.destroy();
+    }
+}
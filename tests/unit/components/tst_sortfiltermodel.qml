@@ -79,6 +79,44 @@ TestCase {
         filter.pattern: /bar/i
     }
 
+    ListModel {
+        id: words
+        ListElement { word: "abc" }
+        ListElement { word: "a.c" }
+        ListElement { word: "Abc" }
+        ListElement { word: "xabcx" }
+        ListElement { word: "cab" }
+        ListElement { word: "a+c" }
+        ListElement { word: "(ab)" }
+    }
+
+    SortFilterModel {
+        id: filtered
+        model: words
+        filter.property: "word"
+    }
+
+    ListModel {
+        id: animals
+        ListElement { word: "ant" }
+        ListElement { word: "bee" }
+        ListElement { word: "cow" }
+    }
+
+    SortFilterModel {
+        id: cached
+        model: animals
+        filter.property: "word"
+    }
+
+    function matchingWords() {
+        var result = [];
+        for (var i = 0; i < filtered.count; i++) {
+            result.push(filtered.get(i).word);
+        }
+        return result.sort();
+    }
+
     function test_passthrough() {
         compare(unmodified.count, things.count)
     }
@@ -131,4 +169,113 @@ TestCase {
     function test_case_sensitivity() {
         compare(caseSensitivity.get(0).foo, "Bar")
     }
+
+    function test_literal_and_regex_patterns_data() {
+        return [
+            {tag: "literal", pattern: /abc/, expected: ["abc", "xabcx"]},
+            {tag: "any character", pattern: /a.c/, expected: ["a+c", "a.c", "abc", "xabcx"]},
+            {tag: "character class", pattern: /a[.+]c/, expected: ["a+c", "a.c"]},
+            {tag: "alternation", pattern: /cab|a\+/, expected: ["a+c", "cab"]},
+            {tag: "quantifier", pattern: /^a.?c$/, expected: ["a+c", "a.c", "abc"]},
+        ];
+    }
+    function test_literal_and_regex_patterns(data) {
+        filtered.filter.pattern = data.pattern;
+        compare(matchingWords(), data.expected);
+    }
+
+    function test_anchors_data() {
+        return [
+            {tag: "start", pattern: /^a/, expected: ["a+c", "a.c", "abc"]},
+            {tag: "end", pattern: /c$/, expected: ["Abc", "a+c", "a.c", "abc"]},
+            {tag: "exact", pattern: /^abc$/, expected: ["abc"]},
+            {tag: "dollar not at the end", pattern: /c$x/, expected: []},
+        ];
+    }
+    function test_anchors(data) {
+        filtered.filter.pattern = data.pattern;
+        compare(matchingWords(), data.expected);
+    }
+
+    function test_escaped_metacharacters_data() {
+        return [
+            {tag: "dot", pattern: /a\.c/, expected: ["a.c"]},
+            {tag: "plus", pattern: /a\+c/, expected: ["a+c"]},
+            {tag: "parentheses", pattern: /^\(ab\)$/, expected: ["(ab)"]},
+            {tag: "escaped class", pattern: /\w\+/, expected: ["a+c"]},
+        ];
+    }
+    function test_escaped_metacharacters(data) {
+        filtered.filter.pattern = data.pattern;
+        compare(matchingWords(), data.expected);
+    }
+
+    function test_literal_case_sensitivity_data() {
+        return [
+            {tag: "sensitive", pattern: /ABC/, expected: []},
+            {tag: "insensitive", pattern: /abc/i, expected: ["Abc", "abc", "xabcx"]},
+            {tag: "insensitive exact", pattern: /^ABC$/i, expected: ["Abc", "abc"]},
+            {tag: "insensitive regex", pattern: /^a.c$/i, expected: ["Abc", "a+c", "a.c", "abc"]},
+        ];
+    }
+    function test_literal_case_sensitivity(data) {
+        filtered.filter.pattern = data.pattern;
+        compare(matchingWords(), data.expected);
+    }
+
+    function test_narrowing() {
+        // growing and shrinking the pattern as when typing in a search field
+        var steps = [
+            [/a/, ["(ab)", "a+c", "a.c", "abc", "cab", "xabcx"]],
+            [/ab/, ["(ab)", "abc", "cab", "xabcx"]],
+            [/abc/, ["abc", "xabcx"]],
+            [/abc/i, ["Abc", "abc", "xabcx"]],
+            [/abc/, ["abc", "xabcx"]],
+            [/ab/, ["(ab)", "abc", "cab", "xabcx"]],
+            [/^a/, ["a+c", "a.c", "abc"]],
+            [/^ab/, ["abc"]],
+            [/^abc$/, ["abc"]],
+            [/^a/, ["a+c", "a.c", "abc"]],
+            [/c$/, ["Abc", "a+c", "a.c", "abc"]],
+            [/bc$/, ["Abc", "abc"]],
+            [/b/, ["(ab)", "Abc", "abc", "cab", "xabcx"]],
+            [/a.c/, ["a+c", "a.c", "abc", "xabcx"]],
+            [/a/, ["(ab)", "a+c", "a.c", "abc", "cab", "xabcx"]],
+            [RegExp(), ["(ab)", "Abc", "a+c", "a.c", "abc", "cab", "xabcx"]],
+        ];
+        for (var i = 0; i < steps.length; i++) {
+            filtered.filter.pattern = steps[i][0];
+            compare(matchingWords(), steps[i][1], "pattern " + steps[i][0]);
+        }
+    }
+
+    function test_source_changes() {
+        cached.filter.pattern = RegExp();
+        compare(cached.get(0).word, "ant");
+        animals.setProperty(0, "word", "ape");
+        compare(cached.get(0).word, "ape", "get() returned a stale row");
+        animals.insert(0, {word: "asp"});
+        compare(cached.get(0).word, "asp");
+        compare(cached.get(1).word, "ape");
+        animals.remove(0);
+        compare(cached.get(0).word, "ape");
+
+        // the rows accepted by a filter are not reused once the source changed
+        cached.filter.pattern = /^a/;
+        compare(cached.count, 1);
+        animals.setProperty(1, "word", "ab");
+        compare(cached.count, 2);
+        cached.filter.pattern = /^ab/;
+        compare(cached.count, 1);
+        compare(cached.get(0).word, "ab");
+        animals.append({word: "abc"});
+        cached.filter.pattern = /^abc/;
+        compare(cached.count, 1);
+        compare(cached.get(0).word, "abc");
+
+        cached.filter.pattern = RegExp();
+        animals.remove(3);
+        animals.setProperty(0, "word", "ant");
+        animals.setProperty(1, "word", "bee");
+    }
 }
@@ -18,12 +18,22 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QUrl>
+#include <QtGui/QStandardItemModel>
 #include <QtQml/QQmlComponent>
+#include <QtQml/QQmlContext>
 #include <QtQml/QQmlEngine>
 #include <QtTest/QtTest>
+#include <QtQuick/QQuickItem>
+#include <UbuntuToolkit/private/ucaction_p.h>
+#include <UbuntuToolkit/private/ucactioncontext_p.h>
+#include <UbuntuToolkit/private/ucactionitem_p.h>
+#include <UbuntuToolkit/private/sortfiltermodel_p.h>
+#include <UbuntuToolkit/private/uctheme_p.h>
 
 #include "ucnamespace.h"
 
+UT_USE_NAMESPACE
+
 class tst_components_benchmark: public QObject
 {
     Q_OBJECT
@@ -96,7 +106,193 @@ private Q_SLOTS:
         }
     }
 
+    void benchmark_palette_color_data() {
+        QTest::addColumn<int>("lookup");
+
+        QTest::newRow("property lookup") << 0;
+        QTest::newRow("by name") << 1;
+        QTest::newRow("by index") << 2;
+    }
+
+    void benchmark_palette_color() {
+        QFETCH(int, lookup);
+
+        UCTheme *theme = UCTheme::defaultTheme(&engine);
+        QVERIFY(theme && theme->palette());
+        const int normal = UCTheme::paletteProfile("normal");
+        const int backgroundText = UCTheme::paletteColorRole("backgroundText");
+        QColor expected = theme->palette()->property("normal").value<QObject*>()
+                ->property("backgroundText").value<QColor>();
+        QCOMPARE(theme->paletteColor(normal, backgroundText), expected);
+
+        QBENCHMARK {
+            for (int i = 0; i < 10000; i++) {
+                switch (lookup) {
+                case 0:
+                    theme->palette()->property("normal").value<QObject*>()
+                            ->property("backgroundText").value<QColor>();
+                    break;
+                case 1:
+                    theme->getPaletteColor("normal", "backgroundText");
+                    break;
+                default:
+                    theme->paletteColor(normal, backgroundText);
+                    break;
+                }
+            }
+        }
+    }
+
+    void benchmark_creation_labels() {
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick 2.4\n"
+                          "import Ubuntu.Components 1.3\n"
+                          "Item { Repeater { model: 10000; Label { text: index } } }", QUrl());
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+        QBENCHMARK {
+            delete component.create();
+        }
+    }
+
+    void benchmark_theme_switch_labels() {
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick 2.4\n"
+                          "import Ubuntu.Components 1.3\n"
+                          "Item { Repeater { model: 10000; Label { text: index } } }", QUrl());
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY2(root, qPrintable(component.errorString()));
+        UCTheme *theme = UCTheme::defaultTheme(&engine);
+        QVERIFY(theme);
+
+        const QString themes[2] = {
+            QStringLiteral("Ubuntu.Components.Themes.SuruDark"),
+            QStringLiteral("Ubuntu.Components.Themes.Ambiance")
+        };
+        int switches = 0;
+        QBENCHMARK {
+            theme->setName(themes[switches++ % 2]);
+            // deliver the theme change to the items
+            QCoreApplication::sendPostedEvents(theme, QEvent::MetaCall);
+        }
+        theme->resetName();
+        QCoreApplication::sendPostedEvents(theme, QEvent::MetaCall);
+    }
+
+    void benchmark_theme_switch_styled_items() {
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick 2.4\n"
+                          "import Ubuntu.Components 1.3\n"
+                          "Item { Repeater { model: 20000; StyledItem {} } }", QUrl());
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY2(root, qPrintable(component.errorString()));
+        UCTheme *theme = UCTheme::defaultTheme(&engine);
+        QVERIFY(theme);
+
+        const QString themes[2] = {
+            QStringLiteral("Ubuntu.Components.Themes.SuruDark"),
+            QStringLiteral("Ubuntu.Components.Themes.Ambiance")
+        };
+        int switches = 0;
+        QBENCHMARK {
+            theme->setName(themes[switches++ % 2]);
+            QCoreApplication::sendPostedEvents(theme, QEvent::MetaCall);
+        }
+        theme->resetName();
+        QCoreApplication::sendPostedEvents(theme, QEvent::MetaCall);
+    }
+
+    void benchmark_action_context_data() {
+        QTest::addColumn<bool>("resolve");
+
+        QTest::newRow("resolved") << true;
+        QTest::newRow("cached") << false;
+    }
+
+    void benchmark_action_context() {
+        QFETCH(bool, resolve);
+
+        // 2000 actions spread across 50 contexts
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick 2.4\n"
+                          "import Ubuntu.Components 1.3\n"
+                          "Item {\n"
+                          "  Repeater {\n"
+                          "    model: 50\n"
+                          "    Item {\n"
+                          "      ActionContext { active: true }\n"
+                          "      Item { Item { Item {\n"
+                          "        Repeater { model: 40; ActionItem { action: Action { shortcut: 'Ctrl+' + index } } }\n"
+                          "      } } }\n"
+                          "    }\n"
+                          "  }\n"
+                          "}", QUrl());
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY2(root, qPrintable(component.errorString()));
+        QList<UCAction*> actions;
+        collectActions(qobject_cast<QQuickItem*>(root.data()), actions);
+        QCOMPARE(actions.count(), 2000);
+        Q_FOREACH(UCAction *action, actions) {
+            QVERIFY(action->isInActiveContext());
+        }
+
+        QBENCHMARK {
+            if (resolve) {
+                // attaching or destroying a context forces the actions to look up theirs again
+                delete new UCActionContext;
+            }
+            Q_FOREACH(UCAction *action, actions) {
+                action->isInActiveContext();
+            }
+        }
+    }
+
+    void benchmark_sortfiltermodel_typing_data() {
+        QTest::addColumn<QString>("text");
+        QTest::addColumn<QString>("prefix");
+
+        QTest::newRow("contains") << "a7f" << "";
+        QTest::newRow("starts with") << "a7f" << "^";
+        QTest::newRow("regular expression") << "a7f" << "[0-9]";
+    }
+
+    void benchmark_sortfiltermodel_typing() {
+        QFETCH(QString, text);
+        QFETCH(QString, prefix);
+
+        QStandardItemModel source;
+        for (int i = 0; i < 200000; i++) {
+            source.appendRow(new QStandardItem(QString::number(i * 2654435761u, 16)));
+        }
+        QSortFilterProxyModelQML proxy;
+        proxy.setModel(&source);
+        FilterBehavior *filter = proxy.property("filter").value<FilterBehavior*>();
+        QVERIFY(filter);
+        filter->setProperty(QStringLiteral("display"));
+        QCOMPARE(proxy.count(), 200000);
+
+        QBENCHMARK {
+            // type the text character by character, then clear it
+            for (int i = 1; i <= text.size(); i++) {
+                filter->setPattern(QRegExp(prefix + text.left(i), Qt::CaseInsensitive, QRegExp::RegExp2));
+                proxy.count();
+            }
+            filter->setPattern(QRegExp());
+        }
+        QCOMPARE(proxy.count(), 200000);
+    }
+
 private:
+    void collectActions(QQuickItem *item, QList<UCAction*> &actions) {
+        UCActionItem *actionItem = qobject_cast<UCActionItem*>(item);
+        if (actionItem && actionItem->action()) {
+            actions.append(actionItem->action());
+        }
+        Q_FOREACH(QQuickItem *child, item->childItems()) {
+            collectActions(child, actions);
+        }
+    }
+
     QQmlEngine engine;
 };
 
@@ -0,0 +1,4 @@
+include(../test-include.pri)
+QT += dbus
+SOURCES += \
+    tst_dbusserviceproperties.cpp
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtCore/QMutex>
+#include <QtCore/QProcess>
+#include <QtCore/QThread>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
+#include <QtDBus/QDBusVirtualObject>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+#include <QtTest/QtTest>
+#include <UbuntuToolkit/private/ucserviceproperties_p.h>
+
+UT_USE_NAMESPACE
+
+static const char serviceName[] = "com.ubuntu.test.Accounts";
+static const char adaptorName[] = "com.ubuntu.test.Sound";
+static const char propertiesInterface[] = "org.freedesktop.DBus.Properties";
+static const char userPath[] = "/Test/User";
+
+/*
+ * Minimal accounts service exposing one user object, counting the calls it
+ * receives so the tests can check the bus traffic of ServiceProperties. It
+ * lives in its own thread as the watcher makes blocking calls to it.
+ */
+class FakeAccounts : public QDBusVirtualObject
+{
+public:
+    int calls(const QString &member)
+    {
+        QMutexLocker lock(&mutex);
+        return callCount.value(member);
+    }
+    void reset(const QVariantMap &properties)
+    {
+        QMutexLocker lock(&mutex);
+        callCount.clear();
+        values = properties;
+    }
+
+    QString introspect(const QString &path) const override
+    {
+        Q_UNUSED(path);
+        return QString();
+    }
+
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override
+    {
+        QMutexLocker lock(&mutex);
+        const QString member = message.member();
+        callCount[member]++;
+        QDBusMessage reply;
+        if (member == QLatin1String("Introspect")) {
+            reply = message.createReply(QStringLiteral(
+                "<node><interface name=\"com.ubuntu.test.Accounts\">"
+                "<method name=\"FindUserById\">"
+                "<arg name=\"id\" type=\"x\" direction=\"in\"/>"
+                "<arg name=\"user\" type=\"o\" direction=\"out\"/>"
+                "</method></interface></node>"));
+        } else if (member == QLatin1String("FindUserById")) {
+            reply = message.createReply(QVariant::fromValue(QDBusObjectPath(userPath)));
+        } else if (member == QLatin1String("GetAll")) {
+            reply = message.createReply(values);
+        } else if (member == QLatin1String("Get")) {
+            const QString property = message.arguments().value(1).toString();
+            reply = values.contains(property)
+                ? message.createReply(QVariant::fromValue(QDBusVariant(values.value(property))))
+                : message.createErrorReply(QStringLiteral("org.freedesktop.DBus.Error.UnknownProperty"),
+                                           QStringLiteral("No such property '%1'").arg(property));
+        } else {
+            return false;
+        }
+        connection.send(reply);
+        return true;
+    }
+
+    void emitChanged(const QDBusConnection &connection, const QVariantMap &changed, const QStringList &invalidated)
+    {
+        QDBusMessage signal = QDBusMessage::createSignal(
+            userPath, propertiesInterface, QStringLiteral("PropertiesChanged"));
+        signal << QString(adaptorName) << changed << invalidated;
+        connection.send(signal);
+    }
+
+private:
+    QMutex mutex;
+    QHash<QString, int> callCount;
+    QVariantMap values;
+};
+
+class tst_DBusServiceProperties : public QObject
+{
+    Q_OBJECT
+
+    QProcess bus;
+    QThread serviceThread;
+    FakeAccounts accounts;
+    QDBusConnection serviceConnection = QDBusConnection(QString());
+
+    UCServiceProperties *createWatcher(QQmlEngine *engine, const QByteArray &properties)
+    {
+        QQmlComponent component(engine);
+        component.setData("import QtQuick 2.4\n"
+                          "import Ubuntu.Components 1.3\n"
+                          "ServiceProperties {\n"
+                          "  type: ServiceProperties.Session\n"
+                          "  service: 'com.ubuntu.test.Accounts'\n"
+                          "  serviceInterface: 'com.ubuntu.test.Accounts'\n"
+                          "  path: '/Test'\n"
+                          "  adaptorInterface: 'com.ubuntu.test.Sound'\n"
+                          + properties +
+                          "}", QUrl());
+        UCServiceProperties *watcher = qobject_cast<UCServiceProperties*>(component.create());
+        if (watcher) {
+            watcher->setParent(engine);
+        }
+        return watcher;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        // private bus, so the messages counted are only ours
+        bus.start(QStringLiteral("dbus-daemon"),
+                  QStringList() << "--session" << "--nofork" << "--print-address");
+        if (!bus.waitForReadyRead(5000)) {
+            QSKIP("Skip test: cannot start dbus-daemon");
+        }
+        const QString address = QString::fromLatin1(bus.readLine().trimmed());
+        qputenv("DBUS_SESSION_BUS_ADDRESS", address.toLatin1());
+
+        serviceThread.start();
+        accounts.moveToThread(&serviceThread);
+        serviceConnection = QDBusConnection::connectToBus(address, QStringLiteral("fakeaccounts"));
+        QVERIFY(serviceConnection.isConnected());
+        QVERIFY(serviceConnection.registerVirtualObject(
+                    QStringLiteral("/Test"), &accounts, QDBusConnection::SubPath));
+        QVERIFY(serviceConnection.registerService(serviceName));
+        QVERIFY(QDBusConnection::sessionBus().isConnected());
+    }
+
+    void cleanupTestCase()
+    {
+        QDBusConnection::disconnectFromBus(QStringLiteral("fakeaccounts"));
+        serviceThread.quit();
+        serviceThread.wait();
+        bus.terminate();
+        bus.waitForFinished();
+    }
+
+    void init()
+    {
+        QVariantMap values;
+        values.insert(QStringLiteral("IncomingCallVibrate"), false);
+        accounts.reset(values);
+    }
+
+    void test_single_fetch()
+    {
+        QQmlEngine engine;
+        UCServiceProperties *watcher = createWatcher(&engine, "property bool incomingCallVibrate: true\n");
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+        QCOMPARE(watcher->property("incomingCallVibrate").toBool(), false);
+
+        // the service object is introspected once, properties fetched at once
+        QCOMPARE(accounts.calls("Introspect"), 1);
+        QCOMPARE(accounts.calls("GetAll"), 1);
+        QCOMPARE(accounts.calls("Get"), 0);
+    }
+
+    void test_missing_property()
+    {
+        QQmlEngine engine;
+        UCServiceProperties *watcher = createWatcher(&engine,
+            "property bool incomingCallVibrate: true\n"
+            "property int thisIsAnInvalidPropertyToWatch\n");
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+        QCOMPARE(watcher->error(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
+        QCOMPARE(watcher->property("incomingCallVibrate").toBool(), false);
+        QCOMPARE(accounts.calls("GetAll"), 1);
+        QCOMPARE(accounts.calls("Get"), 0);
+    }
+
+    void test_changed_value_without_round_trip()
+    {
+        QQmlEngine engine;
+        UCServiceProperties *watcher = createWatcher(&engine, "property bool incomingCallVibrate: true\n");
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+
+        QVariantMap changed;
+        changed.insert(QStringLiteral("IncomingCallVibrate"), true);
+        accounts.emitChanged(serviceConnection, changed, QStringList());
+        QTRY_COMPARE(watcher->property("incomingCallVibrate").toBool(), true);
+        QCOMPARE(accounts.calls("GetAll"), 1);
+        QCOMPARE(accounts.calls("Get"), 0);
+    }
+
+    void test_invalidated_value_read()
+    {
+        QQmlEngine engine;
+        UCServiceProperties *watcher = createWatcher(&engine, "property bool incomingCallVibrate: true\n");
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+
+        QVariantMap values;
+        values.insert(QStringLiteral("IncomingCallVibrate"), true);
+        accounts.reset(values);
+        accounts.emitChanged(serviceConnection, QVariantMap(),
+                             QStringList() << QStringLiteral("IncomingCallVibrate"));
+        QTRY_COMPARE(watcher->property("incomingCallVibrate").toBool(), true);
+        QCOMPARE(accounts.calls("GetAll"), 0);
+        QCOMPARE(accounts.calls("Get"), 1);
+    }
+
+    void test_unwatched_changes_ignored()
+    {
+        QQmlEngine engine;
+        UCServiceProperties *watcher = createWatcher(&engine, "property bool incomingCallVibrate: true\n");
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+
+        QVariantMap changed;
+        changed.insert(QStringLiteral("SilentMode"), true);
+        accounts.emitChanged(serviceConnection, changed, QStringList() << QStringLiteral("SilentMode"));
+        QTest::qWait(50);
+        QVERIFY(!watcher->property("silentMode").isValid());
+        QCOMPARE(accounts.calls("Get"), 0);
+    }
+};
+
+QTEST_MAIN(tst_DBusServiceProperties)
+
+#include "tst_dbusserviceproperties.moc"
@@ -0,0 +1,4 @@
+include(../test-include.pri)
+QT += gui UbuntuMetrics-private
+SOURCES += \
+    tst_gputimer.cpp
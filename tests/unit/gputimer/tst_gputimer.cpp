@@ -0,0 +1,176 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLFunctions>
+#include <QtTest/QtTest>
+#include <UbuntuMetrics/private/gputimer_p.h>
+
+class tst_GPUTimer : public QObject
+{
+    Q_OBJECT
+
+    QOffscreenSurface *surface = nullptr;
+    QOpenGLContext *context = nullptr;
+    QOpenGLFramebufferObject *fbo = nullptr;
+
+    // Pushes a significant amount of work, on purpose big enough for a
+    // software rasterizer like Mesa llvmpipe.
+    void render(int clears)
+    {
+        QOpenGLFunctions *gl = context->functions();
+        fbo->bind();
+        for (int i = 0; i < clears; i++) {
+            gl->glClearColor(i & 1, 0.5f, 0.0f, 1.0f);
+            gl->glClear(GL_COLOR_BUFFER_BIT);
+        }
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QSurfaceFormat format;
+        format.setVersion(3, 2);
+        format.setProfile(QSurfaceFormat::CoreProfile);
+        surface = new QOffscreenSurface;
+        surface->setFormat(format);
+        surface->create();
+        context = new QOpenGLContext;
+        context->setFormat(format);
+        if (!context->create()) {
+            // fall back to the default version
+            context->setFormat(QSurfaceFormat());
+            if (!context->create()) {
+                QSKIP("No OpenGL context available");
+            }
+        }
+        QVERIFY(context->makeCurrent(surface));
+        fbo = new QOpenGLFramebufferObject(2048, 2048);
+        QVERIFY(fbo->isValid());
+    }
+
+    void cleanupTestCase()
+    {
+        delete fbo;
+        if (context) {
+            context->doneCurrent();
+        }
+        delete context;
+        delete surface;
+    }
+
+    void test_results_in_frame_order()
+    {
+        GPUTimer timer;
+        timer.initialize(3);
+        QCOMPARE(timer.depth(), 3);
+        for (quint32 frame = 1; frame <= 3; frame++) {
+            timer.start(frame);
+            render(4);
+            timer.stop();
+        }
+        QCOMPARE(timer.pendingCount(), 3);
+        context->functions()->glFinish();
+
+        quint32 frame;
+        qint64 time;
+        for (quint32 expected = 1; expected <= 3; expected++) {
+            QVERIFY(timer.harvest(&frame, &time));
+            QCOMPARE(frame, expected);
+            // either measured or reported as unavailable, never 0
+            QVERIFY(time == -1 || time > 0);
+        }
+        QVERIFY(!timer.harvest(&frame, &time));
+        QCOMPARE(timer.droppedCount(), 0u);
+        timer.finalize();
+    }
+
+    void test_oldest_dropped_when_full()
+    {
+        GPUTimer timer;
+        timer.initialize(2);
+        for (quint32 frame = 1; frame <= 5; frame++) {
+            timer.start(frame);
+            render(1);
+            timer.stop();
+        }
+        QCOMPARE(timer.pendingCount(), 2);
+        QCOMPARE(timer.droppedCount(), 3u);
+        context->functions()->glFinish();
+
+        quint32 frame;
+        qint64 time;
+        QVERIFY(timer.harvest(&frame, &time));
+        QCOMPARE(frame, 4u);
+        QVERIFY(timer.harvest(&frame, &time));
+        QCOMPARE(frame, 5u);
+        QCOMPARE(timer.pendingCount(), 0);
+        timer.finalize();
+    }
+
+    void test_depth_clamped()
+    {
+        GPUTimer timer;
+        timer.initialize(0);
+        QCOMPARE(timer.depth(), 1);
+        timer.finalize();
+        timer.initialize(1000);
+        QCOMPARE(timer.depth(), static_cast<int>(GPUTimer::MaxDepth));
+        timer.finalize();
+    }
+
+    void test_harvest_does_not_block()
+    {
+        GPUTimer timer;
+        timer.initialize();
+        QOpenGLFunctions *gl = context->functions();
+        gl->glFinish();
+
+        timer.start(1);
+        render(200);
+        timer.stop();
+
+        // whatever the GPU is doing, asking for the result must return at once
+        QElapsedTimer clock;
+        clock.start();
+        quint32 frame;
+        qint64 time;
+        bool harvested = timer.harvest(&frame, &time);
+        const qint64 harvestTime = clock.nsecsElapsed();
+        clock.start();
+        gl->glFinish();
+        const qint64 finishTime = clock.nsecsElapsed();
+
+        // had the harvest waited for the GPU, the finish would have nothing
+        // left to wait for
+        QVERIFY2(harvestTime <= finishTime + 2000000,
+                 qPrintable(QStringLiteral("harvest took %1 ns, finish %2 ns")
+                            .arg(harvestTime).arg(finishTime)));
+        if (!harvested) {
+            QVERIFY(timer.harvest(&frame, &time));
+        }
+        QCOMPARE(frame, 1u);
+        timer.finalize();
+    }
+};
+
+QTEST_MAIN(tst_GPUTimer)
+
+#include "tst_gputimer.moc"
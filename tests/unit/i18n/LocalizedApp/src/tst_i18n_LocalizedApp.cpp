@@ -193,6 +193,60 @@ private Q_SLOTS:
         QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Contar los gatitos"));
         QCOMPARE(i18n->ctr(QString("All Cats"), QString("All")), QString("Cada"));
     }
+
+    void testCase_TranslationCache()
+    {
+        UbuntuI18n* i18n = UbuntuI18n::instance();
+        i18n->setLanguage("en_US.utf8");
+        i18n->setDomain("localizedApp");
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Greets"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("Welcome")), QString("Greets"));
+
+        // Cached translations are dropped when the language changes
+        i18n->setLanguage("C");
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Welcome"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("Welcome")), QString("Welcome"));
+        i18n->setLanguage("en_US.utf8");
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Greets"));
+
+        // when the domain changes
+        i18n->setDomain("notLocalizedApp");
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Welcome"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("Welcome")), QString("Greets"));
+        i18n->setDomain("localizedApp");
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Greets"));
+
+        // and when the catalog of a domain is moved
+        QString localePath(QString::fromUtf8(C::bindtextdomain("localizedApp", ((const char*)0))));
+        i18n->bindtextdomain("localizedApp", QDir::currentPath() + "/nonexistent");
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Welcome"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("Welcome")), QString("Welcome"));
+        i18n->bindtextdomain("localizedApp", localePath);
+        QCOMPARE(i18n->tr(QString("Welcome")), QString("Greets"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("Welcome")), QString("Greets"));
+    }
+
+    void testCase_PluralTranslationCache()
+    {
+        UbuntuI18n* i18n = UbuntuI18n::instance();
+        i18n->setLanguage("en_US.utf8");
+        i18n->setDomain("localizedApp");
+
+        // Plural translations are cached per n, not per plural form
+        QCOMPARE(i18n->tr(QString("%1 kitten"), QString("%1 kittens"), 1), QString("%1 gatito"));
+        QCOMPARE(i18n->tr(QString("%1 kitten"), QString("%1 kittens"), 2), QString("%1 gatitos"));
+        QCOMPARE(i18n->tr(QString("%1 kitten"), QString("%1 kittens"), 1), QString("%1 gatito"));
+        QCOMPARE(i18n->tr(QString("%1 kitten"), QString("%1 kittens"), 0), QString("%1 gatitos"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("%1 kitten"), QString("%1 kittens"), 1), QString("%1 gatito"));
+        QCOMPARE(i18n->dtr(QString("localizedApp"), QString("%1 kitten"), QString("%1 kittens"), 5), QString("%1 gatitos"));
+        // the singular lookup of the same text is a different entry
+        QCOMPARE(i18n->tr(QString("%1 kitten")), QString("%1 gatito"));
+
+        i18n->setLanguage("C");
+        QCOMPARE(i18n->tr(QString("%1 kitten"), QString("%1 kittens"), 1), QString("%1 kitten"));
+        QCOMPARE(i18n->tr(QString("%1 kitten"), QString("%1 kittens"), 2), QString("%1 kittens"));
+        i18n->setLanguage("en_US.utf8");
+    }
 };
 
 // The C++ equivalent of QTEST_MAIN(tst_I18n_LocalizedApp) with added initialization
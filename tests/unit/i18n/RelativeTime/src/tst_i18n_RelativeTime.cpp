@@ -187,6 +187,42 @@ private Q_SLOTS:
         QCOMPARE(i18n->relativeDateTime(QDateTime::currentDateTime().addSecs(60)), QString("tr:1 minute"));
         QCOMPARE(i18n->relativeDateTime(QDateTime::currentDateTime().addSecs(-600)), QString("tr:10 minutes ago"));
         QCOMPARE(i18n->relativeDateTime(QDateTime::currentDateTime().addSecs(600)), QString("tr:10 minutes"));
+
+        // Batched translation
+        QList<QDateTime> datetimes;
+        datetimes << QDateTime::currentDateTime() << QDateTime(QDate(2000,1,1), QTime(0,0,0,0))
+                  << QDateTime::currentDateTime().addSecs(-600);
+        QCOMPARE(i18n->relativeDateTimes(datetimes),
+                 QStringList() << "tr:Now" << "tr:FarAway" << "tr:10 minutes ago");
+    }
+
+    void testCase_DateTimeFormat_data()
+    {
+        QTest::addColumn<QString>("format");
+
+        QTest::newRow("12h") << "h:mm ap";
+        QTest::newRow("24h") << "HH:mm";
+        QTest::newRow("quoted") << "'Yesterday\u2003'HH:mm";
+        QTest::newRow("escaped quote") << "'o''clock' h '' AP";
+        QTest::newRow("day names") << "ddd dddd d dd";
+        QTest::newRow("month names") << "M MM MMM MMMM";
+        QTest::newRow("years") << "yy yyyy";
+        QTest::newRow("seconds") << "hh:m:s:ss A";
+        QTest::newRow("fallback") << "HH:mm:ss.zzz t";
+    }
+    void testCase_DateTimeFormat()
+    {
+        QFETCH(QString, format);
+
+        DateTimeFormat parsed(format);
+        QList<QDateTime> datetimes;
+        datetimes << QDateTime(QDate(2000,1,1), QTime(0,0,0,0))
+                  << QDateTime(QDate(2017,3,14), QTime(9,5,7,0))
+                  << QDateTime(QDate(2017,12,31), QTime(12,30,59,0))
+                  << QDateTime(QDate(2018,7,6), QTime(23,59,1,0));
+        Q_FOREACH(const QDateTime &datetime, datetimes) {
+            QCOMPARE(parsed.toString(datetime, QLocale::system()), datetime.toString(format));
+        }
     }
 };
 
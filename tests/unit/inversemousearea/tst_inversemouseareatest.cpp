@@ -285,6 +285,21 @@ private Q_SLOTS:
         imaDSpy.clear();
     }
 
+    void testCase_InverseMouseAreaOnTopTopmostMoves()
+    {
+        QScopedPointer<InverseMouseAreaTest> quickView(new InverseMouseAreaTest("InverseMouseAreaOnTop.qml"));
+        InverseMouseAreaType *area = quickView->findItem<InverseMouseAreaType*>("IMA");
+        area->setProperty("topmostItem", true);
+        QVERIFY(!area->hoverEnabled());
+
+        QSignalSpy positionSpy(area, SIGNAL(positionChanged(QQuickMouseEvent*)));
+        // moves over the area are grabbed even if not pressed
+        QTest::mouseMove(quickView.data(), QPoint(10, 10));
+        QTest::mouseMove(quickView.data(), QPoint(20, 65));
+        QCoreApplication::processEvents();
+        QVERIFY(positionSpy.count() > 0);
+    }
+
     void testCase_InverseMouseAreaSignals()
     {
         QScopedPointer<InverseMouseAreaTest> quickView(new InverseMouseAreaTest("InverseMouseAreaSignals.qml"));
@@ -455,6 +470,36 @@ private Q_SLOTS:
         QCOMPARE(imaSpy.count(), 1);
     }
 
+    void benchmark_StackedMoveEvents_data()
+    {
+        QTest::addColumn<bool>("hoverEnabled");
+
+        QTest::newRow("moves not tracked") << false;
+        QTest::newRow("moves tracked") << true;
+    }
+
+    void benchmark_StackedMoveEvents()
+    {
+        QFETCH(bool, hoverEnabled);
+        QScopedPointer<InverseMouseAreaTest> quickView(new InverseMouseAreaTest("StackedInverseMouseAreas.qml"));
+        QList<InverseMouseAreaType*> areas = quickView->rootObject()->findChildren<InverseMouseAreaType*>();
+        QCOMPARE(areas.count(), 10);
+        Q_FOREACH(InverseMouseAreaType *area, areas) {
+            area->setHoverEnabled(hoverEnabled);
+        }
+        // move within the hole so none of the areas consumes the events
+        QQuickItem *hole = quickView->findItem<QQuickItem*>("hole");
+        QPointF origin = hole->mapToScene(QPointF(hole->width() / 2, hole->height() / 2));
+
+        QBENCHMARK {
+            for (int i = 0; i < 100000; i++) {
+                QPointF pos = origin + QPointF(i % 10, (i / 10) % 10);
+                QMouseEvent move(QEvent::MouseMove, pos, pos, quickView->mapToGlobal(pos.toPoint()),
+                                 Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+                QCoreApplication::sendEvent(quickView.data(), &move);
+            }
+        }
+    }
 };
 
 QTEST_MAIN(tst_InverseMouseAreaTest)
@@ -39,4 +39,5 @@ OTHER_FILES += \
     DialerCrash.qml \
     ExcludedItemDeleted.qml \
     Visibility.qml \
-    NestedVisibility.qml
+    NestedVisibility.qml \
+    CachedLayouts.qml
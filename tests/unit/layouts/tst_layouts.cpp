@@ -19,6 +19,7 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QString>
 #include <QtCore/QThread>
+#include <QtQml/QQmlContext>
 #include <QtQml/QQmlEngine>
 #include <QtQuick/QQuickItem>
 #include <QtQuick/QQuickView>
@@ -1004,6 +1005,135 @@ private Q_SLOTS:
         QCOMPARE(layout->contentItem()->isVisible(), true);
     }
 
+    void testCase_CachedLayouts()
+    {
+        QScopedPointer<QQuickView> view(loadTest("CachedLayouts.qml"));
+        QVERIFY(view);
+        QQuickItem *root = view->rootObject();
+        QVERIFY(root);
+
+        ULLayouts *layouts = qobject_cast<ULLayouts*>(testItem(root, "layouts"));
+        QVERIFY(layouts);
+        QVERIFY(layouts->cacheLayouts());
+        QSignalSpy layoutChangeSpy(layouts, SIGNAL(currentLayoutChanged()));
+        layoutChangeSpy.wait(300);
+        QCOMPARE(layouts->currentLayout(), QString("small"));
+
+        QPointer<QQuickItem> smallLayout(testItem(layouts, "smallLayout"));
+        QVERIFY(smallLayout);
+        QQuickItem *item = testItem(root, "item1");
+        QVERIFY(item);
+        QVERIFY(hasChildItem(item, smallLayout));
+
+        // switch to medium, the small layout is kept
+        layoutChangeSpy.clear();
+        root->setWidth(UCUnits::instance()->gu(55));
+        layoutChangeSpy.wait(300);
+        QCOMPARE(layouts->currentLayout(), QString("medium"));
+        QVERIFY(smallLayout);
+        QCOMPARE(smallLayout->isVisible(), false);
+        QVERIFY(item->parentItem()->parentItem()->inherits("QQuickFlow"));
+        QPointer<QQuickItem> mediumLayout(testItem(layouts, "mediumLayout"));
+        QVERIFY(mediumLayout);
+
+        // switch back, the cached instance is re-used
+        layoutChangeSpy.clear();
+        root->setWidth(UCUnits::instance()->gu(40));
+        QTRY_COMPARE(layoutChangeSpy.count(), 1);
+        QCOMPARE(layouts->currentLayout(), QString("small"));
+        QCOMPARE(testItem(layouts, "smallLayout"), smallLayout.data());
+        QCOMPARE(smallLayout->isVisible(), true);
+        QVERIFY(hasChildItem(item, smallLayout));
+        QVERIFY(mediumLayout);
+
+        // switching caching off destroys the inactive layouts
+        layouts->setCacheLayouts(false);
+        QTRY_VERIFY(mediumLayout.isNull());
+        QVERIFY(smallLayout);
+    }
+
+    void testCase_PreloadLayouts()
+    {
+        QScopedPointer<QQuickView> view(loadTest("CachedLayouts.qml"));
+        QVERIFY(view);
+        QQuickItem *root = view->rootObject();
+        QVERIFY(root);
+
+        ULLayouts *layouts = qobject_cast<ULLayouts*>(testItem(root, "layouts"));
+        QVERIFY(layouts);
+        QSignalSpy layoutChangeSpy(layouts, SIGNAL(currentLayoutChanged()));
+        layoutChangeSpy.wait(300);
+        QCOMPARE(layouts->currentLayout(), QString("small"));
+        QVERIFY(!testItem(layouts, "mediumLayout"));
+
+        // the inactive layout gets created in the background
+        root->setProperty("preload", true);
+        QTRY_VERIFY(testItem(layouts, "mediumLayout"));
+        QPointer<QQuickItem> mediumLayout(testItem(layouts, "mediumLayout"));
+        QCOMPARE(mediumLayout->isVisible(), false);
+
+        layoutChangeSpy.clear();
+        root->setWidth(UCUnits::instance()->gu(55));
+        QTRY_COMPARE(layoutChangeSpy.count(), 1);
+        QCOMPARE(layouts->currentLayout(), QString("medium"));
+        QCOMPARE(testItem(layouts, "mediumLayout"), mediumLayout.data());
+        QVERIFY(testItem(root, "item1")->parentItem()->parentItem()->inherits("QQuickFlow"));
+    }
+
+    void testCase_RecreatedCachedLayouts()
+    {
+        QScopedPointer<QQuickView> view(loadTest("CachedLayouts.qml"));
+        QVERIFY(view);
+        QQuickItem *root = view->rootObject();
+        QVERIFY(root);
+
+        ULLayouts *layouts = qobject_cast<ULLayouts*>(testItem(root, "layouts"));
+        QVERIFY(layouts);
+        QSignalSpy layoutChangeSpy(layouts, SIGNAL(currentLayoutChanged()));
+        layoutChangeSpy.wait(300);
+        QCOMPARE(layouts->currentLayout(), QString("small"));
+        root->setProperty("preload", true);
+        QTRY_VERIFY(testItem(layouts, "mediumLayout"));
+        QPointer<QQuickItem> smallLayout(testItem(layouts, "smallLayout"));
+        QPointer<QQuickItem> mediumLayout(testItem(layouts, "mediumLayout"));
+        QVERIFY(smallLayout);
+
+        // destroying the preloaded instance keeps the active one bound
+        layouts->setCacheLayouts(false);
+        QTRY_VERIFY(mediumLayout.isNull());
+        QVERIFY(smallLayout);
+        QVERIFY(qmlContext(smallLayout)->isValid());
+        root->setWidth(UCUnits::instance()->gu(35));
+        QCOMPARE(smallLayout->property("rootWidth").toReal(), root->width());
+
+        // and new instances can be created afterwards
+        layouts->setCacheLayouts(true);
+        QTRY_VERIFY(testItem(layouts, "mediumLayout"));
+        mediumLayout = testItem(layouts, "mediumLayout");
+        for (int i = 0; i < 3; i++) {
+            layoutChangeSpy.clear();
+            root->setWidth(UCUnits::instance()->gu(55));
+            QTRY_COMPARE(layoutChangeSpy.count(), 1);
+            QCOMPARE(layouts->currentLayout(), QString("medium"));
+            QCOMPARE(testItem(layouts, "mediumLayout"), mediumLayout.data());
+            QCOMPARE(mediumLayout->property("rootWidth").toReal(), root->width());
+
+            layoutChangeSpy.clear();
+            root->setWidth(UCUnits::instance()->gu(40));
+            QTRY_COMPARE(layoutChangeSpy.count(), 1);
+            QCOMPARE(layouts->currentLayout(), QString("small"));
+            QCOMPARE(smallLayout->property("rootWidth").toReal(), root->width());
+
+            // drop the cached medium instance, the next switch creates a new one
+            layouts->setCacheLayouts(false);
+            QTRY_VERIFY(mediumLayout.isNull());
+            layouts->setCacheLayouts(true);
+            QTRY_VERIFY(testItem(layouts, "mediumLayout"));
+            mediumLayout = testItem(layouts, "mediumLayout");
+            QVERIFY(qmlContext(mediumLayout)->isValid());
+        }
+    }
+
     void testCase_NestedVisibility_data() {
         QTest::addColumn<QString>("layoutFunction");
         QTest::addColumn<QString>("layoutName");
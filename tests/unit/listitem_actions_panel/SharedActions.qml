@@ -0,0 +1,80 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+ListView {
+    id: listView
+    width: units.gu(40)
+    height: units.gu(60)
+    model: 1000
+
+    // when false, every row declares its own ListItemActions
+    property bool shared: true
+
+    ListItemActions {
+        id: sharedLeading
+        objectName: "sharedLeading"
+        actions: Action {
+            objectName: "delete"
+            iconName: "delete"
+        }
+    }
+    ListItemActions {
+        id: sharedTrailing
+        objectName: "sharedTrailing"
+        actions: [
+            Action {
+                objectName: "edit"
+                iconName: "edit"
+            },
+            Action {
+                objectName: "share"
+                iconName: "share"
+            }
+        ]
+    }
+
+    delegate: ListItem {
+        objectName: "listItem" + index
+        leadingActions: listView.shared ? sharedLeading : ownLeading
+        trailingActions: listView.shared ? sharedTrailing : ownTrailing
+        ListItemActions {
+            id: ownLeading
+            actions: Action {
+                objectName: "delete"
+                iconName: "delete"
+            }
+        }
+        ListItemActions {
+            id: ownTrailing
+            actions: [
+                Action {
+                    objectName: "edit"
+                    iconName: "edit"
+                },
+                Action {
+                    objectName: "share"
+                    iconName: "share"
+                }
+            ]
+        }
+        Label {
+            text: "Row " + index
+        }
+    }
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <UbuntuToolkit/private/uclistitem_p.h>
+#include <UbuntuToolkit/private/uclistitem_p_p.h>
+#include <UbuntuToolkit/private/uclistitemactions_p.h>
+#include <QtQuick/private/qquicklistview_p.h>
+#include <QtTest/QtTest>
+
+#include "uctestcase.h"
+
+UT_USE_NAMESPACE
+
+class tst_ListItemActionsPanel : public QObject
+{
+    Q_OBJECT
+
+private:
+
+    static QQuickItem *findItem(QQuickItem *root, const QString &objectName)
+    {
+        Q_FOREACH(QQuickItem *child, root->childItems()) {
+            if (child->objectName() == objectName) {
+                return child;
+            }
+            QQuickItem *item = findItem(child, objectName);
+            if (item) {
+                return item;
+            }
+        }
+        return Q_NULLPTR;
+    }
+
+    // brings the row into the view and returns its ListItem
+    static UCListItem *listItemAt(QQuickListView *view, int index)
+    {
+        view->positionViewAtIndex(index, QQuickItemView::Contain);
+        return qobject_cast<UCListItem*>(findItem(view->contentItem(), QStringLiteral("listItem%1").arg(index)));
+    }
+
+    static void swipe(UCListItem *item)
+    {
+        UCListItemPrivate *d = UCListItemPrivate::get(item);
+        d->loadStyleItem(false);
+        d->setSwiped(true);
+    }
+
+    // the panel Loaders release their items with deleteLater()
+    static void rebound(UCListItem *item)
+    {
+        UCListItemPrivate::get(item)->setSwiped(false);
+        QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+    }
+
+    static QQuickItem *panelOf(UCListItem *item, bool leading)
+    {
+        return findItem(item, leading ? QStringLiteral("ListItemPanelLeading") : QStringLiteral("ListItemPanelTrailing"));
+    }
+
+    // the index the action delegate of the panel is bound to
+    static int delegateIndex(QQuickItem *panel, const QString &action)
+    {
+        QQuickItem *delegate = findItem(panel, action);
+        return (delegate && delegate->parentItem()) ? delegate->parentItem()->property("index").toInt() : -2;
+    }
+
+private Q_SLOTS:
+
+    void test_panel_shared()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SharedActions.qml"));
+        QQuickListView *view = static_cast<QQuickListView*>(test->rootObject());
+
+        UCListItem *first = listItemAt(view, 0);
+        QVERIFY(first);
+        swipe(first);
+        QPointer<QQuickItem> leadingPanel = panelOf(first, true);
+        QPointer<QQuickItem> trailingPanel = panelOf(first, false);
+        QVERIFY(leadingPanel);
+        QVERIFY(trailingPanel);
+        QCOMPARE(first->leadingActions()->container(), first);
+        QCOMPARE(first->trailingActions()->container(), first);
+        rebound(first);
+        QVERIFY(!first->leadingActions()->container());
+
+        UCListItem *next = listItemAt(view, 5);
+        QVERIFY(next);
+        swipe(next);
+        QVERIFY(leadingPanel);
+        QCOMPARE(panelOf(next, true), leadingPanel.data());
+        QCOMPARE(panelOf(next, false), trailingPanel.data());
+        QVERIFY(!panelOf(first, true));
+        QCOMPARE(next->leadingActions()->container(), next);
+        rebound(next);
+    }
+
+    void test_busy_panel_fallback()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SharedActions.qml"));
+        QQuickListView *view = static_cast<QQuickListView*>(test->rootObject());
+
+        UCListItem *first = listItemAt(view, 0);
+        UCListItem *second = listItemAt(view, 1);
+        QVERIFY(first && second);
+        swipe(first);
+        QQuickItem *shared = panelOf(first, true);
+        QVERIFY(shared);
+
+        // the first ListItem is still swiped, as when snapping out, while the
+        // second one gets swiped; the first one keeps the shared panel
+        swipe(second);
+        QCOMPARE(panelOf(first, true), shared);
+        QVERIFY(shared->parentItem()->property("panelWidth").toReal() > 0);
+        QPointer<QQuickItem> fallback = panelOf(second, true);
+        QVERIFY(fallback);
+        QVERIFY(fallback != shared);
+        QCOMPARE(first->leadingActions()->container(), first);
+        QCOMPARE(delegateIndex(shared, QStringLiteral("delete")), 0);
+        QCOMPARE(delegateIndex(fallback, QStringLiteral("delete")), 1);
+
+        // the fallback panel goes away with the second ListItem's swipe
+        rebound(second);
+        QVERIFY(!fallback);
+        QCOMPARE(panelOf(first, true), shared);
+        rebound(first);
+
+        // and the shared panel is free again
+        swipe(second);
+        QCOMPARE(panelOf(second, true), shared);
+        QCOMPARE(second->leadingActions()->container(), second);
+        rebound(second);
+    }
+
+    void test_container_cleared_on_deletion()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SharedActions.qml"));
+        QQuickListView *view = static_cast<QQuickListView*>(test->rootObject());
+
+        UCListItem *item = listItemAt(view, 0);
+        QVERIFY(item);
+        UCListItemActions *actions = item->leadingActions();
+        swipe(item);
+        QCOMPARE(actions->container(), item);
+
+        QSignalSpy containerSpy(actions, SIGNAL(containerChanged()));
+        QSignalSpy destroyedSpy(item, SIGNAL(destroyed()));
+        // drop the delegates while the ListItem is still swiped
+        view->setProperty("model", 0);
+        QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+        QCOMPARE(destroyedSpy.count(), 1);
+        QVERIFY(!actions->container());
+        QVERIFY(containerSpy.count() > 0);
+    }
+
+    void test_per_row_actions()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SharedActions.qml"));
+        QQuickListView *view = static_cast<QQuickListView*>(test->rootObject());
+        view->setProperty("shared", false);
+
+        UCListItem *first = listItemAt(view, 0);
+        UCListItem *next = listItemAt(view, 1);
+        QVERIFY(first && next);
+        swipe(first);
+        swipe(next);
+        QVERIFY(panelOf(first, true));
+        QVERIFY(panelOf(next, true));
+        QVERIFY(panelOf(first, true) != panelOf(next, true));
+        QCOMPARE(first->leadingActions()->container(), first);
+        QCOMPARE(next->leadingActions()->container(), next);
+        rebound(first);
+        rebound(next);
+    }
+
+    void test_index_rebinding()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SharedActions.qml"));
+        QQuickListView *view = static_cast<QQuickListView*>(test->rootObject());
+
+        UCListItem *item = listItemAt(view, 2);
+        QVERIFY(item);
+        swipe(item);
+        QQuickItem *leadingPanel = panelOf(item, true);
+        QQuickItem *trailingPanel = panelOf(item, false);
+        QCOMPARE(delegateIndex(leadingPanel, QStringLiteral("delete")), 2);
+        QCOMPARE(delegateIndex(trailingPanel, QStringLiteral("share")), 2);
+        rebound(item);
+
+        item = listItemAt(view, 700);
+        QVERIFY(item);
+        swipe(item);
+        QCOMPARE(panelOf(item, true), leadingPanel);
+        QCOMPARE(delegateIndex(leadingPanel, QStringLiteral("delete")), 700);
+        QCOMPARE(delegateIndex(trailingPanel, QStringLiteral("edit")), 700);
+        QCOMPARE(delegateIndex(trailingPanel, QStringLiteral("share")), 700);
+        // the panel is owned by the actions, not by the ListItems showing it
+        QCOMPARE(leadingPanel->parent(), static_cast<QObject*>(item->leadingActions()));
+        rebound(item);
+    }
+
+    void benchmark_rapid_swipes_data()
+    {
+        QTest::addColumn<bool>("shared");
+
+        QTest::newRow("per-row actions") << false;
+        QTest::newRow("shared actions") << true;
+    }
+    void benchmark_rapid_swipes()
+    {
+        QFETCH(bool, shared);
+
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SharedActions.qml"));
+        QQuickListView *view = static_cast<QQuickListView*>(test->rootObject());
+        view->setProperty("shared", shared);
+        const int rows = view->property("count").toInt();
+
+        QBENCHMARK {
+            for (int i = 0; i < rows; i++) {
+                UCListItem *item = listItemAt(view, i);
+                QVERIFY(item);
+                swipe(item);
+                rebound(item);
+            }
+            view->positionViewAtBeginning();
+        }
+    }
+};
+
+QTEST_MAIN(tst_ListItemActionsPanel)
+
+#include "tst_listitem_actions_panel.moc"
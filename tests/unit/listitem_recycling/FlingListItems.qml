@@ -0,0 +1,61 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+import Ubuntu.Components.Themes 1.3
+
+ListView {
+    id: listView
+    width: units.gu(40)
+    height: units.gu(60)
+    model: 100000
+
+    property bool recycle: false
+    ViewItems.recycleDelegates: recycle
+    ViewItems.selectMode: true
+
+    // shared by the delegates, so the tests can change its palette
+    ThemeSettings {
+        id: listTheme
+        objectName: "listTheme"
+        palette: Palette {}
+    }
+
+    delegate: ListItem {
+        objectName: "listItem" + index
+        theme: listTheme
+        leadingActions: ListItemActions {
+            actions: Action {
+                iconName: "delete"
+            }
+        }
+        trailingActions: ListItemActions {
+            actions: [
+                Action {
+                    iconName: "edit"
+                },
+                Action {
+                    iconName: "share"
+                }
+            ]
+        }
+        ListItemLayout {
+            title.text: "Row " + index
+            subtitle.text: "Scrolled in the fling benchmark"
+        }
+    }
+}
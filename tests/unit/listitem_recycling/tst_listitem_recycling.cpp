@@ -0,0 +1,273 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <UbuntuToolkit/private/uclistitem_p.h>
+#include <UbuntuToolkit/private/uclistitem_p_p.h>
+#include <UbuntuToolkit/private/uclistitemstyle_p.h>
+#include <UbuntuToolkit/private/uctheme_p.h>
+#include <QtQml/QQmlContext>
+#include <QtQml/qqml.h>
+#include <QtQuick/private/qquickanchors_p.h>
+#include <QtQuick/private/qquickflickable_p.h>
+#include <QtQuick/private/qquickitem_p.h>
+#include <QtTest/QtTest>
+#include <cstdlib>
+#include <new>
+
+#include "uctestcase.h"
+
+UT_USE_NAMESPACE
+
+// Counts the allocations done through operator new, which covers the QObjects
+// and their private data created for each delegate.
+static QBasicAtomicInt allocations = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+void *operator new(std::size_t size)
+{
+    allocations.ref();
+    void *pointer = std::malloc(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) Q_DECL_NOTHROW
+{
+    std::free(pointer);
+}
+
+class tst_ListItemRecycling : public QObject
+{
+    Q_OBJECT
+
+private:
+
+    // allocations per row measured with recycling off, compared against the
+    // ones measured with recycling on
+    qreal allocationsWithoutRecycling = -1;
+
+    static QList<UCListItem*> listItems(QQuickFlickable *view)
+    {
+        QList<UCListItem*> items;
+        Q_FOREACH(QQuickItem *child, view->contentItem()->childItems()) {
+            UCListItem *item = qobject_cast<UCListItem*>(child);
+            if (item && item->isVisible()) {
+                items << item;
+            }
+        }
+        return items;
+    }
+
+    static QQuickItem *styleOf(UCListItem *item)
+    {
+        return UCListItemPrivate::get(item)->styleItem;
+    }
+
+    static int indexOf(UCListItem *item)
+    {
+        return qmlContext(item)->contextProperty(QStringLiteral("index")).toInt();
+    }
+
+    static UCViewItemsAttached *viewItems(QQuickFlickable *view)
+    {
+        return qobject_cast<UCViewItemsAttached*>(qmlAttachedPropertiesObject<UCViewItemsAttached>(view, false));
+    }
+
+    // scrolls the view row by row, the way a fling moves it, and destroys the
+    // delegates released on the way
+    static void scrollRows(QQuickFlickable *view, int rows)
+    {
+        const qreal rowHeight = listItems(view).first()->height();
+        const qreal step = rows < 0 ? -rowHeight : rowHeight;
+        for (int i = 0; i < qAbs(rows); i++) {
+            view->setContentY(view->contentY() + step);
+            QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+        }
+    }
+
+private Q_SLOTS:
+
+    void test_style_recycling_data()
+    {
+        QTest::addColumn<bool>("recycle");
+
+        QTest::newRow("recycling off") << false;
+        QTest::newRow("recycling on") << true;
+    }
+    void test_style_recycling()
+    {
+        QFETCH(bool, recycle);
+
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("FlingListItems.qml"));
+        QQuickFlickable *view = static_cast<QQuickFlickable*>(test->rootObject());
+        view->setProperty("recycle", recycle);
+
+        QList< QPointer<QQuickItem> > styles;
+        Q_FOREACH(UCListItem *item, listItems(view)) {
+            QVERIFY(styleOf(item));
+            styles << styleOf(item);
+        }
+        scrollRows(view, 2 * styles.size());
+
+        int reused = 0;
+        Q_FOREACH(UCListItem *item, listItems(view)) {
+            QQuickItem *style = styleOf(item);
+            QVERIFY(style);
+            QCOMPARE(style->parentItem(), static_cast<QQuickItem*>(item));
+            Q_FOREACH(const QPointer<QQuickItem> &oldStyle, styles) {
+                if (oldStyle && oldStyle == style) {
+                    reused++;
+                }
+            }
+        }
+        QCOMPARE(reused > 0, recycle);
+    }
+
+    void test_recycled_state_reset()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("FlingListItems.qml"));
+        QQuickFlickable *view = static_cast<QQuickFlickable*>(test->rootObject());
+        view->setProperty("recycle", true);
+        QList<int> selected;
+        selected << 1 << 30;
+        viewItems(view)->setSelectedIndices(selected);
+
+        // scroll away, so the page left behind gets styles created while recycling
+        // is on, then back, so every item on the first page gets a recycled style
+        scrollRows(view, 40);
+        QSet<QQuickItem*> parkedStyles;
+        Q_FOREACH(UCListItem *item, listItems(view)) {
+            parkedStyles << styleOf(item);
+        }
+        scrollRows(view, -40);
+
+        QList<UCListItem*> items = listItems(view);
+        QVERIFY(!items.isEmpty());
+        // the select mode panel shifts the content equally on every item
+        const qreal contentX = items.first()->contentItem()->x();
+        QVERIFY(contentX > 0);
+        QList<UCListItemStyle*> recycledStyles;
+        Q_FOREACH(UCListItem *item, items) {
+            const int index = indexOf(item);
+            QCOMPARE(item->property("selected").toBool(), selected.contains(index));
+            QVERIFY(!item->isSwiped());
+            QCOMPARE(item->contentItem()->x(), contentX);
+            UCListItemStyle *style = qobject_cast<UCListItemStyle*>(styleOf(item));
+            QVERIFY(style);
+            QCOMPARE(style->index(), index);
+            QCOMPARE(item->findChildren<UCListItemStyle*>(QString(), Qt::FindDirectChildrenOnly).size(), 1);
+            if (parkedStyles.contains(style)) {
+                recycledStyles << style;
+            }
+        }
+        QVERIFY(!recycledStyles.isEmpty());
+
+        // the styledItem bindings of a recycled style follow the new ListItem
+        Q_FOREACH(UCListItemStyle *style, recycledStyles) {
+            UCListItem *item = static_cast<UCListItem*>(style->parentItem());
+            QQuickAnchors *anchors = QQuickItemPrivate::get(style)->anchors();
+            item->divider()->setVisible(false);
+            QCOMPARE(anchors->bottomMargin(), 0.0);
+            item->divider()->setVisible(true);
+            QVERIFY(item->divider()->height() > 0);
+            QCOMPARE(anchors->bottomMargin(), item->divider()->height());
+        }
+
+        // so do the theme bindings
+        UCTheme *theme = items.first()->getTheme();
+        QObject *normal = theme->palette()->property("normal").value<QObject*>();
+        QVERIFY(normal);
+        normal->setProperty("foreground", QColor("red"));
+        Q_FOREACH(UCListItemStyle *style, recycledStyles) {
+            QCOMPARE(style->property("leadingPanelColor").value<QColor>(), QColor("red"));
+        }
+    }
+
+    void test_reparented_item_keeps_style()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("FlingListItems.qml"));
+        QQuickFlickable *view = static_cast<QQuickFlickable*>(test->rootObject());
+        view->setProperty("recycle", true);
+        // let the visible items load their styles while recycling is on
+        scrollRows(view, 40);
+
+        UCListItem *item = listItems(view).first();
+        QPointer<QQuickItem> style = styleOf(item);
+        QVERIFY(style);
+        QQuickItem *parentItem = item->parentItem();
+        item->setParentItem(Q_NULLPTR);
+        QCOMPARE(styleOf(item), style.data());
+        item->setParentItem(parentItem);
+        QCOMPARE(styleOf(item), style.data());
+        QCOMPARE(style->parentItem(), static_cast<QQuickItem*>(item));
+    }
+
+    void test_disabling_clears_pool()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("FlingListItems.qml"));
+        QQuickFlickable *view = static_cast<QQuickFlickable*>(test->rootObject());
+        UCViewItemsAttached *attached = viewItems(view);
+        view->setProperty("recycle", true);
+
+        // a jump releases the whole page after creating the new one, so the
+        // released styles stay in the pool
+        view->setContentY(view->height() * 4);
+        QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+        QVERIFY(!attached->findChildren<UCListItemStyle*>(QString(), Qt::FindDirectChildrenOnly).isEmpty());
+
+        view->setProperty("recycle", false);
+        QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+        QVERIFY(attached->findChildren<UCListItemStyle*>(QString(), Qt::FindDirectChildrenOnly).isEmpty());
+    }
+
+    void benchmark_fling_data()
+    {
+        QTest::addColumn<bool>("recycle");
+
+        QTest::newRow("recycling off") << false;
+        QTest::newRow("recycling on") << true;
+    }
+    void benchmark_fling()
+    {
+        QFETCH(bool, recycle);
+        const int rows = 2000;
+
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("FlingListItems.qml"));
+        QQuickFlickable *view = static_cast<QQuickFlickable*>(test->rootObject());
+        view->setProperty("recycle", recycle);
+        QMetaObject::invokeMethod(view, "positionViewAtIndex", Q_ARG(int, 50000), Q_ARG(int, 0));
+        // warm up, so the pool and the caches are filled
+        scrollRows(view, 50);
+
+        allocations.store(0);
+        scrollRows(view, rows);
+        // report the allocations per scrolled row
+        const qreal perRow = qreal(allocations.load()) / rows;
+        QTest::setBenchmarkResult(perRow, QTest::Events);
+        if (!recycle) {
+            allocationsWithoutRecycling = perRow;
+        } else if (allocationsWithoutRecycling >= 0) {
+            QVERIFY2(perRow < allocationsWithoutRecycling,
+                     qPrintable(QString("%1 allocations per row with recycling, %2 without")
+                                .arg(perRow).arg(allocationsWithoutRecycling)));
+        }
+    }
+};
+
+QTEST_MAIN(tst_ListItemRecycling)
+
+#include "tst_listitem_recycling.moc"
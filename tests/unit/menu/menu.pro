@@ -0,0 +1,3 @@
+include(../test-include.pri)
+QT += core-private gui-private
+SOURCES += tst_menu.cpp
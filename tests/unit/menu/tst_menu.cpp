@@ -0,0 +1,237 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtGui/private/qguiapplication_p.h>
+#include <QtGui/qpa/qplatformmenu.h>
+#include <QtGui/qpa/qplatformtheme.h>
+#include <QtTest/QtTest>
+#include <UbuntuToolkit/private/actionlist_p.h>
+#include <UbuntuToolkit/private/menu_p.h>
+
+UT_USE_NAMESPACE
+
+class MockMenuItem : public QPlatformMenuItem
+{
+    Q_OBJECT
+public:
+    void setTag(quintptr tag) override { m_tag = tag; }
+    quintptr tag() const override { return m_tag; }
+    void setText(const QString &text) override { this->text = text; textSets++; }
+    void setIcon(const QIcon &) override { iconSets++; }
+    void setMenu(QPlatformMenu *) override {}
+    void setVisible(bool visible) override { this->visible = visible; }
+    void setIsSeparator(bool isSeparator) override { separator = isSeparator; }
+    void setFont(const QFont &) override {}
+    void setRole(MenuRole) override {}
+    void setCheckable(bool) override {}
+    void setChecked(bool) override {}
+    void setShortcut(const QKeySequence &) override { shortcutSets++; }
+    void setEnabled(bool enabled) override { this->enabled = enabled; }
+    void setIconSize(int) override {}
+
+    QString text;
+    bool visible = true;
+    bool enabled = true;
+    bool separator = false;
+    int textSets = 0;
+    int iconSets = 0;
+    int shortcutSets = 0;
+    int syncs = 0;
+
+private:
+    quintptr m_tag = 0;
+};
+
+class MockMenu : public QPlatformMenu
+{
+    Q_OBJECT
+public:
+    void insertMenuItem(QPlatformMenuItem *menuItem, QPlatformMenuItem *before) override
+    {
+        int index = items.indexOf(before);
+        items.insert(index < 0 ? items.count() : index, menuItem);
+    }
+    void removeMenuItem(QPlatformMenuItem *menuItem) override
+    {
+        items.removeOne(menuItem);
+    }
+    void syncMenuItem(QPlatformMenuItem *menuItem) override
+    {
+        static_cast<MockMenuItem*>(menuItem)->syncs++;
+        syncs++;
+    }
+    void syncSeparatorsCollapsible(bool) override {}
+    void setTag(quintptr tag) override { m_tag = tag; }
+    quintptr tag() const override { return m_tag; }
+    void setText(const QString &) override {}
+    void setIcon(const QIcon &) override {}
+    void setEnabled(bool) override {}
+    void setVisible(bool) override {}
+    QPlatformMenuItem *menuItemAt(int position) const override
+    {
+        return items.value(position, Q_NULLPTR);
+    }
+    QPlatformMenuItem *menuItemForTag(quintptr) const override
+    {
+        return Q_NULLPTR;
+    }
+    QPlatformMenuItem *createMenuItem() const override
+    {
+        // the menu items are owned by the toolkit
+        return new MockMenuItem;
+    }
+
+    // the texts of the items, separators are marked with "|"
+    QStringList layout() const
+    {
+        QStringList result;
+        Q_FOREACH(QPlatformMenuItem *item, items) {
+            MockMenuItem *mock = static_cast<MockMenuItem*>(item);
+            result << (mock->separator ? QStringLiteral("|") : mock->text);
+        }
+        return result;
+    }
+
+    QList<QPlatformMenuItem*> items;
+    int syncs = 0;
+
+private:
+    quintptr m_tag = 0;
+};
+
+class MockTheme : public QPlatformTheme
+{
+public:
+    QPlatformMenu *createPlatformMenu() const override
+    {
+        return new MockMenu;
+    }
+};
+
+class tst_Menu : public QObject
+{
+    Q_OBJECT
+private:
+    QPlatformTheme *originalTheme = Q_NULLPTR;
+    MockTheme theme;
+
+    UCAction *createAction(const QString &text, QObject *parent)
+    {
+        UCAction *action = new UCAction(parent);
+        action->setText(text);
+        return action;
+    }
+    MockMenu *platformMenu(Menu *menu)
+    {
+        return static_cast<MockMenu*>(menu->platformMenu());
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        originalTheme = QGuiApplicationPrivate::platform_theme;
+        QGuiApplicationPrivate::platform_theme = &theme;
+    }
+    void cleanupTestCase()
+    {
+        QGuiApplicationPrivate::platform_theme = originalTheme;
+    }
+
+    void test_changes_synced_once()
+    {
+        Menu menu;
+        UCAction *action = createAction("first", &menu);
+        menu.appendObject(action);
+        MockMenu *mock = platformMenu(&menu);
+        QVERIFY(mock);
+        QCOMPARE(mock->items.count(), 1);
+        MockMenuItem *item = static_cast<MockMenuItem*>(mock->items[0]);
+        QCOMPARE(item->text, QString("first"));
+        QCoreApplication::processEvents();
+        const int syncs = mock->syncs;
+        const int iconSets = item->iconSets;
+        const int shortcutSets = item->shortcutSets;
+
+        action->setText("second");
+        action->setText("third");
+        action->setEnabled(false);
+        // nothing is pushed until the next event loop turn
+        QCOMPARE(mock->syncs, syncs);
+        QCOMPARE(item->text, QString("first"));
+
+        QTRY_COMPARE(mock->syncs, syncs + 1);
+        QCOMPARE(item->text, QString("third"));
+        QCOMPARE(item->enabled, false);
+        // untouched attributes are not pushed again
+        QCOMPARE(item->iconSets, iconSets);
+        QCOMPARE(item->shortcutSets, shortcutSets);
+    }
+
+    void test_insert_between_lists()
+    {
+        Menu menu;
+        ActionList *list = new ActionList(&menu);
+        list->addAction(createAction("b1", list));
+        list->addAction(createAction("b2", list));
+        menu.appendObject(createAction("a1", &menu));
+        menu.appendObject(list);
+        menu.appendObject(createAction("a3", &menu));
+        MockMenu *mock = platformMenu(&menu);
+        QCOMPARE(mock->layout(), QStringList() << "a1" << "|" << "b1" << "b2" << "|" << "a3");
+
+        menu.insertObject(1, createAction("a2", &menu));
+        QCOMPARE(mock->layout(), QStringList() << "a1" << "|" << "a2" << "|" << "b1" << "b2" << "|" << "a3");
+
+        // list changes refresh the list entries in place
+        list->addAction(createAction("b3", list));
+        QCOMPARE(mock->layout(), QStringList() << "a1" << "|" << "a2" << "|" << "b1" << "b2" << "b3" << "|" << "a3");
+    }
+
+    void test_many_dynamic_entries()
+    {
+        Menu menu;
+        QStringList expected;
+        for (int i = 0; i < 500; i++) {
+            // prepend every second entry, append the rest
+            QString text = QString::number(i);
+            if (i % 2) {
+                menu.insertObject(0, createAction(text, &menu));
+                expected.prepend(text);
+            } else {
+                menu.appendObject(createAction(text, &menu));
+                expected.append(text);
+            }
+        }
+        QQmlListProperty<QObject> data = menu.data();
+        QCOMPARE(data.count(&data), 500);
+        QStringList layout = platformMenu(&menu)->layout();
+        layout.removeAll("|");
+        QCOMPARE(layout, expected);
+
+        // remove from the middle
+        QObject *middle = data.at(&data, 250);
+        expected.removeAt(250);
+        menu.removeObject(middle);
+        QCOMPARE(data.count(&data), 499);
+        layout = platformMenu(&menu)->layout();
+        layout.removeAll("|");
+        QCOMPARE(layout, expected);
+    }
+};
+
+QTEST_MAIN(tst_Menu)
+
+#include "tst_menu.moc"
@@ -0,0 +1,10 @@
+include(../test-include.pri)
+
+PERFORMANCEMETRICS_SRC = $$PWD/../../../src/imports/PerformanceMetrics/plugin
+INCLUDEPATH += $$PERFORMANCEMETRICS_SRC
+
+SOURCES += \
+    tst_performancemetrics.cpp \
+    $$PERFORMANCEMETRICS_SRC/upmgraphmodel.cpp
+HEADERS += \
+    $$PERFORMANCEMETRICS_SRC/upmgraphmodel.h
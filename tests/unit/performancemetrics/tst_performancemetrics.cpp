@@ -0,0 +1,102 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest/QtTest>
+#include "upmgraphmodel.h"
+
+class tst_PerformanceMetrics : public QObject
+{
+    Q_OBJECT
+
+    static int pixel(const UPMGraphModel &model, int column)
+    {
+        return qRed(reinterpret_cast<const QRgb*>(model.image().constScanLine(0))[column]);
+    }
+
+private Q_SLOTS:
+
+    void test_append_wraps_around()
+    {
+        UPMGraphModel model;
+        model.setSamples(10);
+        QCOMPARE(model.columnsWritten(), qint64(0));
+
+        model.appendValue(4, 1);
+        model.appendValue(4, 2);
+        model.appendValue(4, 3);
+        QCOMPARE(model.shift(), 2);
+        QCOMPARE(model.columnsWritten(), qint64(12));
+        QCOMPARE(model.currentValue(), 3);
+        QCOMPARE(pixel(model, 0), 3);
+        QCOMPARE(pixel(model, 1), 3);
+        QCOMPARE(pixel(model, 2), 1);
+        QCOMPARE(pixel(model, 7), 2);
+        QCOMPARE(pixel(model, 8), 3);
+
+        // wider than the image
+        model.appendValue(25, 4);
+        QCOMPARE(model.shift(), 2);
+        for (int i = 0; i < 10; i++) {
+            QCOMPARE(pixel(model, i), 4);
+        }
+    }
+
+    void test_resize_resets()
+    {
+        UPMGraphModel model;
+        int generation = model.generation();
+        model.appendValue(30, 5);
+        model.setSamples(20);
+        QCOMPARE(model.generation(), generation + 1);
+        QCOMPARE(model.shift(), 0);
+        QCOMPARE(model.columnsWritten(), qint64(0));
+        QCOMPARE(model.image().width(), 20);
+        QCOMPARE(pixel(model, 0), 0);
+    }
+
+    void test_append_does_not_copy()
+    {
+        UPMGraphModel model;
+        const uchar *bits = model.image().constBits();
+        for (int i = 0; i < 1000; i++) {
+            model.appendValue(3, i % 256);
+        }
+        QCOMPARE(model.image().constBits(), bits);
+    }
+
+    void benchmark_append_data()
+    {
+        QTest::addColumn<int>("samples");
+        QTest::newRow("100 samples") << 100;
+        QTest::newRow("10000 samples") << 10000;
+    }
+    void benchmark_append()
+    {
+        QFETCH(int, samples);
+        UPMGraphModel model;
+        model.setSamples(samples);
+        QBENCHMARK {
+            for (int i = 0; i < 100000; i++) {
+                model.appendValue(2, i % 256);
+            }
+        }
+        QCOMPARE(model.image().width(), samples);
+    }
+};
+
+QTEST_MAIN(tst_PerformanceMetrics)
+
+#include "tst_performancemetrics.moc"
@@ -0,0 +1,367 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Loads the scenes of tests/unit/performance one by one in an offscreen window
+ * and measures, for each of them, the compilation and creation times, the sync
+ * and render times of the first frame, the average time of the following frames
+ * and the peak RSS. The results are written as JSON and can be compared against
+ * a baseline written by a previous run, in which case the exit code is 1 if one
+ * of the measures regressed by more than the given tolerance.
+ *
+ * Example:
+ *   performancerunner --output baseline.json
+ *   performancerunner --baseline baseline.json --tolerance 15
+ */
+
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtGui/QGuiApplication>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickWindow>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+#include <QtQuick/QSGRendererInterface>
+#endif
+#include <algorithm>
+
+// Scenes taking too long to be part of a regular run, see tst_performance.
+static const char *const skippedScenes[] = { "ListItemsBaseList.qml" };
+
+static const int frameTimeout = 10000;
+
+static const char peakRssMeasure[] = "peakRss";
+
+// Resets the peak RSS of the process, supported by Linux 4.0 and later.
+static void resetPeakRss()
+{
+    QFile clearRefs(QStringLiteral("/proc/self/clear_refs"));
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+}
+
+// Returns the peak RSS of the process in kB, or -1 if not available.
+static qint64 peakRss()
+{
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("VmHWM:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+static double milliseconds(qint64 nanoseconds)
+{
+    return nanoseconds / 1000000.0;
+}
+
+class SceneRunner : public QObject
+{
+public:
+    SceneRunner(const QStringList &importPaths, int frames)
+        : m_importPaths(importPaths)
+        , m_frames(frames)
+    {
+    }
+
+    // Runs the scene, returns an empty object on failure.
+    QJsonObject run(const QString &fileName)
+    {
+        QJsonObject result;
+        resetPeakRss();
+
+        QQmlEngine engine;
+        engine.setImportPathList(m_importPaths + engine.importPathList());
+        QElapsedTimer timer;
+
+        timer.start();
+        QQmlComponent component(&engine);
+        component.loadUrl(QUrl::fromLocalFile(fileName), QQmlComponent::PreferSynchronous);
+        if (!component.isReady()) {
+            qWarning("%s", qPrintable(component.errorString()));
+            return QJsonObject();
+        }
+        result.insert(QStringLiteral("compileTime"), milliseconds(timer.nsecsElapsed()));
+
+        timer.restart();
+        QScopedPointer<QObject> root(component.create());
+        QQuickItem *rootItem = qobject_cast<QQuickItem*>(root.data());
+        if (!rootItem) {
+            qWarning("%s: the root object is not an Item", qPrintable(fileName));
+            return QJsonObject();
+        }
+        result.insert(QStringLiteral("creationTime"), milliseconds(timer.nsecsElapsed()));
+
+        QQuickWindow window;
+        window.setGeometry(0, 0, 240, 320);
+        rootItem->setParentItem(window.contentItem());
+        if (!measureFrames(&window, &result)) {
+            qWarning("%s: frames were not rendered in time", qPrintable(fileName));
+            return QJsonObject();
+        }
+        // delete the item before the window it is in
+        root.reset();
+
+        result.insert(QLatin1String(peakRssMeasure), peakRss());
+        return result;
+    }
+
+private:
+    // The scene graph signals may be emitted from the render thread.
+    bool measureFrames(QQuickWindow *window, QJsonObject *result)
+    {
+        QElapsedTimer clock;
+        QAtomicInteger<qint64> syncBegin(0), syncTime(0), renderBegin(0), renderTime(0);
+        connect(window, &QQuickWindow::beforeSynchronizing, this, [&]() {
+            syncBegin.store(clock.nsecsElapsed());
+        }, Qt::DirectConnection);
+        connect(window, &QQuickWindow::afterSynchronizing, this, [&]() {
+            syncTime.store(clock.nsecsElapsed() - syncBegin.load());
+        }, Qt::DirectConnection);
+        connect(window, &QQuickWindow::beforeRendering, this, [&]() {
+            renderBegin.store(clock.nsecsElapsed());
+        }, Qt::DirectConnection);
+        connect(window, &QQuickWindow::afterRendering, this, [&]() {
+            renderTime.store(clock.nsecsElapsed() - renderBegin.load());
+        }, Qt::DirectConnection);
+
+        // frames are requested continuously, the first one is reported on its
+        // own, the following ones are averaged
+        QEventLoop loop;
+        int swapped = 0;
+        qint64 steadyBegin = 0;
+        connect(window, &QQuickWindow::frameSwapped, &loop, [&]() {
+            if (swapped == 0) {
+                result->insert(QStringLiteral("firstFrameSyncTime"), milliseconds(syncTime.load()));
+                result->insert(QStringLiteral("firstFrameRenderTime"), milliseconds(renderTime.load()));
+                steadyBegin = clock.nsecsElapsed();
+            }
+            if (swapped++ == m_frames) {
+                const qint64 steadyTime = clock.nsecsElapsed() - steadyBegin;
+                result->insert(QStringLiteral("frameTime"), milliseconds(steadyTime / m_frames));
+                loop.quit();
+            } else {
+                window->update();
+            }
+        }, Qt::QueuedConnection);
+        QTimer::singleShot(frameTimeout, &loop, &QEventLoop::quit);
+
+        clock.start();
+        window->show();
+        loop.exec();
+        window->hide();
+        disconnect(window, nullptr, this, nullptr);
+        return swapped > m_frames;
+    }
+
+    QStringList m_importPaths;
+    int m_frames;
+};
+
+// Returns the median of each measure over the runs.
+static QJsonObject median(const QList<QJsonObject> &runs)
+{
+    QJsonObject result;
+    for (const QString &key : runs.first().keys()) {
+        QVector<double> values;
+        for (const QJsonObject &run : runs) {
+            values << run.value(key).toDouble();
+        }
+        std::sort(values.begin(), values.end());
+        result.insert(key, values[values.size() / 2]);
+    }
+    return result;
+}
+
+// Prints the regressions against the baseline, returns false if any.
+static bool compare(const QJsonObject &scenes, const QJsonObject &baseline,
+                    double tolerance, double minimumDelta)
+{
+    bool passed = true;
+    for (const QString &scene : scenes.keys()) {
+        const QJsonObject current = scenes.value(scene).toObject();
+        const QJsonObject reference = baseline.value(scene).toObject();
+        if (reference.isEmpty()) {
+            qWarning("%s: not in the baseline", qPrintable(scene));
+            continue;
+        }
+        for (const QString &key : current.keys()) {
+            if (!reference.contains(key)) {
+                continue;
+            }
+            const double value = current.value(key).toDouble();
+            const double referenceValue = reference.value(key).toDouble();
+            const bool time = key != QLatin1String(peakRssMeasure);
+            // time measures below a minimal delta are noise
+            if (value > referenceValue * (1.0 + tolerance / 100.0)
+                    && (!time || value - referenceValue > minimumDelta)) {
+                qWarning("REGRESSION %s %s: %.3f %s, baseline %.3f (%+.1f%%)",
+                         qPrintable(scene), qPrintable(key), value, time ? "ms" : "kB",
+                         referenceValue, (value / referenceValue - 1.0) * 100.0);
+                passed = false;
+            }
+        }
+    }
+    return passed;
+}
+
+int main(int argc, char *argv[])
+{
+    // headless by default
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication application(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Measures the performance of QML scenes."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(
+        QStringLiteral("scenes"), QStringLiteral("Scenes to run, all the scenes if not set."));
+    QCommandLineOption scenesOption(
+        QStringLiteral("scenes"), QStringLiteral("Directory of the scenes."),
+        QStringLiteral("directory"), QStringLiteral(SCENES_DIR));
+    QCommandLineOption framesOption(
+        QStringLiteral("frames"), QStringLiteral("Frames measured after the first one."),
+        QStringLiteral("count"), QStringLiteral("60"));
+    QCommandLineOption repeatOption(
+        QStringLiteral("repeat"), QStringLiteral("Runs of each scene, the median is reported."),
+        QStringLiteral("count"), QStringLiteral("3"));
+    QCommandLineOption outputOption(
+        QStringLiteral("output"), QStringLiteral("JSON file to write, standard output if not set."),
+        QStringLiteral("file"));
+    QCommandLineOption baselineOption(
+        QStringLiteral("baseline"), QStringLiteral("JSON file of a previous run to compare with."),
+        QStringLiteral("file"));
+    QCommandLineOption toleranceOption(
+        QStringLiteral("tolerance"), QStringLiteral("Tolerated regression in percent."),
+        QStringLiteral("percent"), QStringLiteral("10"));
+    QCommandLineOption minimumDeltaOption(
+        QStringLiteral("minimum-delta"), QStringLiteral("Time regressions below are ignored."),
+        QStringLiteral("milliseconds"), QStringLiteral("0.5"));
+    QCommandLineOption softwareOption(
+        QStringLiteral("software"), QStringLiteral("Use the software scene graph backend."));
+    parser.addOption(scenesOption);
+    parser.addOption(framesOption);
+    parser.addOption(repeatOption);
+    parser.addOption(outputOption);
+    parser.addOption(baselineOption);
+    parser.addOption(toleranceOption);
+    parser.addOption(minimumDeltaOption);
+    parser.addOption(softwareOption);
+    parser.process(application);
+
+    if (parser.isSet(softwareOption)) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+        QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+#else
+        qWarning("The software backend requires Qt 5.8");
+        return 2;
+#endif
+    }
+
+    const QDir scenesDir(parser.value(scenesOption));
+    QStringList scenes = parser.positionalArguments();
+    if (scenes.isEmpty()) {
+        scenes = scenesDir.entryList(QStringList() << QStringLiteral("*.qml"), QDir::Files, QDir::Name);
+        for (const char *skipped : skippedScenes) {
+            scenes.removeAll(QLatin1String(skipped));
+        }
+    }
+    const int frames = qMax(1, parser.value(framesOption).toInt());
+    const int repeat = qMax(1, parser.value(repeatOption).toInt());
+
+    QStringList importPaths;
+    if (QDir(QStringLiteral(UBUNTU_QML_IMPORT_PATH)).exists()) {
+        importPaths << QStringLiteral(UBUNTU_QML_IMPORT_PATH);
+    }
+    SceneRunner runner(importPaths, frames);
+
+    // load the plugins ahead so that the first scene doesn't pay for it
+    {
+        QQmlEngine engine;
+        engine.setImportPathList(importPaths + engine.importPathList());
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick 2.4\nimport Ubuntu.Components 1.3\nItem {}", QUrl());
+        delete component.create();
+    }
+
+    QJsonObject results;
+    bool failed = false;
+    for (const QString &scene : scenes) {
+        QList<QJsonObject> runs;
+        for (int i = 0; i < repeat; i++) {
+            QJsonObject run = runner.run(scenesDir.absoluteFilePath(scene));
+            if (run.isEmpty()) {
+                break;
+            }
+            runs << run;
+        }
+        if (runs.size() < repeat) {
+            failed = true;
+            continue;
+        }
+        results.insert(QFileInfo(scene).fileName(), median(runs));
+    }
+
+    QJsonObject document;
+    document.insert(QStringLiteral("platform"), QGuiApplication::platformName());
+    document.insert(QStringLiteral("software"), parser.isSet(softwareOption));
+    document.insert(QStringLiteral("frames"), frames);
+    document.insert(QStringLiteral("repeat"), repeat);
+    document.insert(QStringLiteral("scenes"), results);
+    const QByteArray json = QJsonDocument(document).toJson();
+    if (parser.isSet(outputOption)) {
+        QFile output(parser.value(outputOption));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(json) != json.size()) {
+            qWarning("Can't write %s", qPrintable(output.fileName()));
+            return 2;
+        }
+    } else {
+        fputs(json.constData(), stdout);
+    }
+
+    if (parser.isSet(baselineOption)) {
+        QFile baselineFile(parser.value(baselineOption));
+        if (!baselineFile.open(QIODevice::ReadOnly)) {
+            qWarning("Can't read %s", qPrintable(baselineFile.fileName()));
+            return 2;
+        }
+        const QJsonObject baseline =
+            QJsonDocument::fromJson(baselineFile.readAll()).object().value(QStringLiteral("scenes")).toObject();
+        if (!compare(results, baseline, parser.value(toleranceOption).toDouble(),
+                     parser.value(minimumDeltaOption).toDouble())) {
+            return 1;
+        }
+    }
+    return failed ? 2 : 0;
+}
@@ -0,0 +1,26 @@
+TEMPLATE = app
+TARGET = performancerunner
+QT += qml quick
+CONFIG += no_keywords c++11
+QMAKE_CXXFLAGS += -Werror
+
+DEFINES += SCENES_DIR=\\\"$$PWD/../performance/\\\"
+DEFINES += UBUNTU_QML_IMPORT_PATH='\\"$${ROOT_BUILD_DIR}/qml\\"'
+
+SOURCES += \
+    performancerunner.cpp
+
+# The scenes take a while to run and their timings depend on the machine, so
+# they are not part of 'make check'; run them with 'make performance'. That
+# compares against baseline.json when there is one, write it with
+# 'performancerunner --output baseline.json' on the reference setup.
+performance.target = performance
+performance.depends = $${TARGET}
+performance.commands += cd $$_PRO_FILE_PWD_;
+performance.commands += . $${ROOT_SOURCE_DIR}/export_qml_dir.sh;
+exists($$PWD/baseline.json) {
+    performance.commands += '$$shadowed($$_PRO_FILE_PWD_)/$${TARGET} --output $$shadowed($$_PRO_FILE_PWD_)/performance.json --baseline $$PWD/baseline.json';
+} else {
+    performance.commands += '$$shadowed($$_PRO_FILE_PWD_)/$${TARGET} --output $$shadowed($$_PRO_FILE_PWD_)/performance.json';
+}
+QMAKE_EXTRA_TARGETS += performance
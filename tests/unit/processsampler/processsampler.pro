@@ -0,0 +1,4 @@
+include(../test-include.pri)
+QT += UbuntuMetrics-private
+SOURCES += \
+    tst_processsampler.cpp
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtCore/QFile>
+#include <QtTest/QtTest>
+#include <UbuntuMetrics/private/events_p.h>
+
+class tst_ProcessSampler : public QObject
+{
+    Q_OBJECT
+
+    UMProcessEvent sample(ProcessSampler *sampler)
+    {
+        UMProcessEvent event;
+        memset(&event, 0, sizeof(event));
+        sampler->sample(&event);
+        return event;
+    }
+
+private Q_SLOTS:
+
+    void test_sane_values()
+    {
+        ProcessSampler sampler;
+        UMProcessEvent event = sample(&sampler);
+        QVERIFY(event.threadCount >= 1);
+        QVERIFY(event.vszMemory > 0);
+        QVERIFY(event.rssMemory > 0);
+        QVERIFY(event.rssMemory <= event.vszMemory);
+        QVERIFY(event.minorFaults > 0);
+        if (QFile::exists(QStringLiteral("/proc/self/smaps_rollup"))) {
+            QVERIFY(event.pssMemory > 0);
+            QVERIFY(event.ussMemory > 0);
+            QVERIFY(event.ussMemory <= event.pssMemory);
+            QVERIFY(event.pssMemory <= event.rssMemory);
+        }
+    }
+
+    void test_monotonic_counters()
+    {
+        ProcessSampler sampler;
+        UMProcessEvent first = sample(&sampler);
+
+        // Fault in fresh pages and give the scheduler a chance to switch.
+        QByteArray pages(16 * 4096, '\0');
+        for (int i = 0; i < pages.size(); i += 4096) {
+            pages[i] = 1;
+        }
+        QTest::qSleep(10);
+
+        UMProcessEvent second = sample(&sampler);
+        QVERIFY(second.minorFaults >= first.minorFaults);
+        QVERIFY(second.majorFaults >= first.majorFaults);
+        QVERIFY(second.voluntaryContextSwitches > first.voluntaryContextSwitches);
+        QVERIFY(second.involuntaryContextSwitches >= first.involuntaryContextSwitches);
+        QVERIFY(second.ioReadBytes >= first.ioReadBytes);
+        QVERIFY(second.ioWriteBytes >= first.ioWriteBytes);
+        QVERIFY(second.schedulingWaitTime >= first.schedulingWaitTime);
+    }
+
+    void benchmark_update_process_event()
+    {
+        UMEventUtils utils;
+        UMEvent event;
+        QBENCHMARK {
+            utils.updateProcessEvent(&event);
+        }
+    }
+};
+
+QTEST_MAIN(tst_ProcessSampler)
+
+#include "tst_processsampler.moc"
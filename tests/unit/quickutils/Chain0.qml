@@ -0,0 +1,4 @@
+import QtQuick 2.4
+
+Item {
+}
@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain0 {
+    property int depth1: 1
+}
@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain1 {
+    property int depth2: 2
+}
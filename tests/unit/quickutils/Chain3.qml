@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain2 {
+    property int depth3: 3
+}
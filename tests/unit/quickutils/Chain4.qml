@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain3 {
+    property int depth4: 4
+}
@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain4 {
+    property int depth5: 5
+}
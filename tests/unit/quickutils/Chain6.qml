@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain5 {
+    property int depth6: 6
+}
@@ -0,0 +1,5 @@
+import QtQuick 2.4
+
+Chain6 {
+    property int depth7: 7
+}
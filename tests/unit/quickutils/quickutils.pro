@@ -1,2 +1,12 @@
 include(../test-include.pri)
 SOURCES += tst_quickutils.cpp
+
+OTHER_FILES += \
+    Chain0.qml \
+    Chain1.qml \
+    Chain2.qml \
+    Chain3.qml \
+    Chain4.qml \
+    Chain5.qml \
+    Chain6.qml \
+    Chain7.qml
@@ -15,6 +15,8 @@
  */
 
 #include <QtQml/QQmlEngine>
+#include <QtQml/QQmlComponent>
+#include <QtQuick/QQuickItem>
 #include <UbuntuToolkit/private/quickutils_p.h>
 
 #include "uctestcase.h"
@@ -30,6 +32,16 @@ public:
 private:
     QString imEnvVar;
 
+    QObject *createChain(QQmlEngine *engine, int depth)
+    {
+        QQmlComponent component(engine, QUrl::fromLocalFile(QString("Chain%1.qml").arg(depth)));
+        QObject *object = component.create();
+        if (!object) {
+            qWarning() << component.errors();
+        }
+        return object;
+    }
+
 private Q_SLOTS:
     void initTestCase()
     {
@@ -57,6 +69,91 @@ private Q_SLOTS:
         qputenv("QT_IM_MODULE", envVar);
         QVERIFY(QuickUtils::instance()->inputMethodProvider().isEmpty());
     }
+
+    void test_inherits_data()
+    {
+        QTest::addColumn<QString>("className");
+        QTest::addColumn<bool>("inherits");
+
+        QTest::newRow("itself") << "Chain7" << true;
+        QTest::newRow("QML base") << "Chain0" << true;
+        QTest::newRow("C++ base") << "QQuickItem" << true;
+        QTest::newRow("QObject") << "QObject" << true;
+        QTest::newRow("QML type suffix") << "Chain7_QMLTYPE" << false;
+        QTest::newRow("unrelated") << "QQuickRectangle" << false;
+        QTest::newRow("empty") << "" << false;
+    }
+    void test_inherits()
+    {
+        QFETCH(QString, className);
+        QFETCH(bool, inherits);
+
+        QQmlEngine engine;
+        QScopedPointer<QObject> object(createChain(&engine, 7));
+        QVERIFY(object);
+        // uncached and cached
+        QCOMPARE(QuickUtils::inherits(object.data(), className), inherits);
+        QCOMPARE(QuickUtils::inherits(object.data(), className), inherits);
+    }
+
+    void test_inherits_cache_shared_by_instances()
+    {
+        QQmlEngine engine;
+        QScopedPointer<QObject> chain3(createChain(&engine, 3));
+        QScopedPointer<QObject> chain5(createChain(&engine, 5));
+        QScopedPointer<QObject> other(createChain(&engine, 5));
+        QVERIFY(chain3 && chain5 && other);
+
+        QVERIFY(QuickUtils::inherits(chain5.data(), "Chain4"));
+        QVERIFY(QuickUtils::inherits(other.data(), "Chain4"));
+        QVERIFY(!QuickUtils::inherits(chain3.data(), "Chain4"));
+        QVERIFY(!QuickUtils::inherits(nullptr, "QObject"));
+    }
+
+    void test_inherits_after_engine_teardown()
+    {
+        // the QML types of a new engine must not hit the results of the old one
+        for (int i = 0; i < 3; i++) {
+            QQmlEngine engine;
+            QScopedPointer<QObject> object(createChain(&engine, (i % 2) ? 2 : 6));
+            QVERIFY(object);
+            QCOMPARE(QuickUtils::inherits(object.data(), "Chain5"), (i % 2) == 0);
+            QVERIFY(QuickUtils::inherits(object.data(), "Chain1"));
+        }
+    }
+
+    void benchmark_inherits_data()
+    {
+        QTest::addColumn<int>("depth");
+        QTest::addColumn<QString>("className");
+        QTest::addColumn<bool>("cold");
+
+        QTest::newRow("C++ type, cold") << -1 << "QQuickItem" << true;
+        QTest::newRow("C++ type, warm") << -1 << "QQuickItem" << false;
+        QTest::newRow("shallow, cold") << 1 << "Chain0" << true;
+        QTest::newRow("shallow, warm") << 1 << "Chain0" << false;
+        QTest::newRow("deep, cold") << 7 << "Chain0" << true;
+        QTest::newRow("deep, warm") << 7 << "Chain0" << false;
+        QTest::newRow("deep mismatch, cold") << 7 << "Palette" << true;
+        QTest::newRow("deep mismatch, warm") << 7 << "Palette" << false;
+    }
+    void benchmark_inherits()
+    {
+        QFETCH(int, depth);
+        QFETCH(QString, className);
+        QFETCH(bool, cold);
+
+        QQmlEngine engine;
+        QScopedPointer<QObject> object(depth < 0 ? new QQuickItem : createChain(&engine, depth));
+        QVERIFY(object);
+        QuickUtils::inherits(object.data(), className);
+        QBENCHMARK {
+            if (cold) {
+                QuickUtils::clearInheritsCache();
+            }
+            QuickUtils::inherits(object.data(), className);
+        }
+    }
 };
 
 QTEST_MAIN(tst_QuickUtils)
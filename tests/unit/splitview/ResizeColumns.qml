@@ -0,0 +1,59 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+import Ubuntu.Components.Labs 1.0
+
+SplitView {
+    objectName: "testItem"
+    width: units.gu(200)
+    height: units.gu(70)
+
+    layouts: SplitViewLayout {
+        when: true
+        ViewColumn {
+            objectName: "resized"
+            preferredWidth: units.gu(40)
+            minimumWidth: units.gu(20)
+            maximumWidth: units.gu(100)
+        }
+        ViewColumn {
+            fillWidth: true
+            minimumWidth: units.gu(20)
+            maximumWidth: units.gu(40)
+        }
+        ViewColumn {
+            fillWidth: true
+            minimumWidth: units.gu(10)
+        }
+        ViewColumn {
+            preferredWidth: units.gu(30)
+        }
+        ViewColumn {
+            fillWidth: true
+            maximumWidth: units.gu(60)
+        }
+    }
+
+    Repeater {
+        model: 5
+        Item {
+            objectName: "column" + index
+            height: parent.height
+        }
+    }
+}
@@ -0,0 +1,8 @@
+include(../test-include-x11.pri)
+QT += core-private qml-private quick-private gui-private
+
+SOURCES += \
+    tst_splitview.cpp
+
+DISTFILES += \
+    ResizeColumns.qml
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <UbuntuToolkit/private/splitview_p.h>
+#include <UbuntuToolkit/private/splitview_p_p.h>
+#include <UbuntuToolkit/private/ucunits_p.h>
+#include <QtTest/QtTest>
+#include <random>
+
+#include "uctestcase.h"
+
+UT_USE_NAMESPACE
+
+typedef SplitViewPrivate::ColumnConstraint ColumnConstraint;
+
+class tst_SplitView : public QObject
+{
+    Q_OBJECT
+
+private:
+
+    // Reference solution: the fill columns take the same width clamped to their
+    // limits, so look up that common width by bisection.
+    static QVector<qreal> referenceWidths(const QVector<ColumnConstraint> &columns, qreal width)
+    {
+        qreal low = 0.0;
+        qreal high = width;
+        for (const ColumnConstraint &column : columns) {
+            if (!column.fillWidth) {
+                width -= column.preferredWidth;
+            } else {
+                high = qMax(high, column.maximumWidth);
+            }
+        }
+        low = qMin(low, width);
+        for (int i = 0; i < 200; i++) {
+            qreal level = (low + high) / 2;
+            qreal sum = 0.0;
+            for (const ColumnConstraint &column : columns) {
+                if (column.fillWidth) {
+                    sum += qBound(column.minimumWidth, level, column.maximumWidth);
+                }
+            }
+            if (sum < width) {
+                low = level;
+            } else {
+                high = level;
+            }
+        }
+        QVector<qreal> widths;
+        for (const ColumnConstraint &column : columns) {
+            widths << (column.fillWidth
+                       ? qBound(column.minimumWidth, low, column.maximumWidth)
+                       : column.preferredWidth);
+        }
+        return widths;
+    }
+
+private Q_SLOTS:
+
+    void test_solve_widths_data()
+    {
+        QTest::addColumn<quint32>("seed");
+
+        for (quint32 seed = 1; seed <= 20; seed++) {
+            QTest::newRow(qPrintable(QString("seed %1").arg(seed))) << seed;
+        }
+    }
+    void test_solve_widths()
+    {
+        QFETCH(quint32, seed);
+
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> count(1, 8);
+        std::uniform_int_distribution<int> fill(0, 2);
+        std::uniform_real_distribution<qreal> size(0.0, 1.0);
+        QVector<qreal> widths;
+        for (int run = 0; run < 500; run++) {
+            QVector<ColumnConstraint> columns(count(random));
+            qreal minimumTotal = 0.0;
+            qreal maximumTotal = 0.0;
+            qreal fixedTotal = 0.0;
+            for (ColumnConstraint &column : columns) {
+                column.minimumWidth = 300.0 * size(random);
+                column.maximumWidth = column.minimumWidth + 500.0 * size(random);
+                column.preferredWidth = column.minimumWidth + (column.maximumWidth - column.minimumWidth) * size(random);
+                column.fillWidth = fill(random) > 0;
+                if (column.fillWidth) {
+                    minimumTotal += column.minimumWidth;
+                    maximumTotal += column.maximumWidth;
+                } else {
+                    fixedTotal += column.preferredWidth;
+                }
+            }
+            const qreal width = 2000.0 * size(random);
+
+            SplitViewPrivate::solveWidths(columns, width, &widths);
+            QVector<qreal> expected = referenceWidths(columns, width);
+            QCOMPARE(widths.size(), columns.size());
+
+            qreal total = 0.0;
+            for (int i = 0; i < columns.size(); i++) {
+                const ColumnConstraint &column = columns[i];
+                if (column.fillWidth) {
+                    QVERIFY2(widths[i] >= column.minimumWidth - 1e-6, qPrintable(QString("run %1, column %2").arg(run).arg(i)));
+                    QVERIFY2(widths[i] <= column.maximumWidth + 1e-6, qPrintable(QString("run %1, column %2").arg(run).arg(i)));
+                } else {
+                    QCOMPARE(widths[i], column.preferredWidth);
+                }
+                QVERIFY2(qAbs(widths[i] - expected[i]) < 1e-6,
+                         qPrintable(QString("run %1, column %2: %3 != %4").arg(run).arg(i).arg(widths[i]).arg(expected[i])));
+                total += widths[i];
+            }
+            // whenever the limits allow it, the columns take the whole width
+            const qreal available = width - fixedTotal;
+            if (minimumTotal > 0.0 && available >= minimumTotal && available <= maximumTotal) {
+                QVERIFY2(qAbs(total - width) < 1e-6, qPrintable(QString("run %1: %2 != %3").arg(run).arg(total).arg(width)));
+            }
+        }
+    }
+
+    void test_fill_limits_redistributed()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("ResizeColumns.qml"));
+        SplitView *view = static_cast<SplitView*>(test->rootObject());
+        const qreal spacing = view->spacing();
+
+        // 200 - 40 - 30 = 130 grid units to share between the fill columns; the
+        // second column is capped at 40, the remainder goes to the other two
+        const qreal share = (UCUnits::instance()->gu(90) - 4 * spacing) / 2;
+        QCOMPARE(test->findItem<QQuickItem*>("column0")->width(), UCUnits::instance()->gu(40));
+        QCOMPARE(test->findItem<QQuickItem*>("column1")->width(), UCUnits::instance()->gu(40));
+        QCOMPARE(test->findItem<QQuickItem*>("column2")->width(), share);
+        QCOMPARE(test->findItem<QQuickItem*>("column3")->width(), UCUnits::instance()->gu(30));
+        QCOMPARE(test->findItem<QQuickItem*>("column4")->width(), share);
+    }
+
+    void benchmark_resize_drag()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("ResizeColumns.qml"));
+        SplitView *view = static_cast<SplitView*>(test->rootObject());
+        QObject *resized = view->findChild<QObject*>("resized");
+        QVERIFY(resized);
+        const qreal from = UCUnits::instance()->gu(20);
+        const qreal to = UCUnits::instance()->gu(100);
+
+        // drag the first column's edge across its whole range, one pixel at a time
+        QBENCHMARK {
+            for (qreal width = from; width <= to; width++) {
+                resized->setProperty("preferredWidth", width);
+            }
+            for (qreal width = to; width >= from; width--) {
+                resized->setProperty("preferredWidth", width);
+            }
+        }
+    }
+
+    void benchmark_resize_view()
+    {
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("ResizeColumns.qml"));
+        SplitView *view = static_cast<SplitView*>(test->rootObject());
+        const qreal from = UCUnits::instance()->gu(100);
+        const qreal to = UCUnits::instance()->gu(300);
+
+        QBENCHMARK {
+            for (qreal width = from; width <= to; width++) {
+                view->setWidth(width);
+            }
+        }
+    }
+};
+
+QTEST_MAIN(tst_SplitView)
+
+#include "tst_splitview.moc"
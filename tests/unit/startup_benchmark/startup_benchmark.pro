@@ -0,0 +1,7 @@
+include(../test-include.pri)
+
+SOURCES += \
+    tst_startup_benchmark.cpp
+
+DISTFILES += \
+    MinimalMainView.qml
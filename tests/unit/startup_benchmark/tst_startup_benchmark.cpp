@@ -0,0 +1,119 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QProcess>
+#include <QtGui/QGuiApplication>
+#include <QtQuick/QQuickView>
+#include <QtTest/QtTest>
+#include <algorithm>
+
+// Startup times are measured in a child process each, so that no state is
+// shared between the runs and the module is initialized from scratch.
+static const char firstFrameArgument[] = "--first-frame";
+static const int runCount = 5;
+
+class tst_StartupBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+
+    // Returns the time-to-first-frame in milliseconds reported by a child
+    // process, or -1 on failure.
+    qint64 runChild(const QString &fileName, bool deferred)
+    {
+        QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+        environment.insert(QStringLiteral("QT_QPA_PLATFORM"), QStringLiteral("offscreen"));
+        if (deferred) {
+            environment.insert(QStringLiteral("UC_DEFERRED_INITIALIZATION"), QStringLiteral("1"));
+        } else {
+            environment.remove(QStringLiteral("UC_DEFERRED_INITIALIZATION"));
+        }
+
+        QProcess child;
+        child.setProcessEnvironment(environment);
+        child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        child.start(QCoreApplication::applicationFilePath(),
+                    QStringList() << QString(firstFrameArgument) << fileName);
+        if (!child.waitForFinished(30000) || child.exitCode() != 0) {
+            child.kill();
+            return -1;
+        }
+        bool ok = false;
+        const qint64 elapsed = child.readAllStandardOutput().trimmed().toLongLong(&ok);
+        return ok ? elapsed : -1;
+    }
+
+private Q_SLOTS:
+
+    void benchmark_first_frame_data()
+    {
+        QTest::addColumn<bool>("deferred");
+
+        QTest::newRow("eager initialization") << false;
+        QTest::newRow("deferred initialization") << true;
+    }
+    void benchmark_first_frame()
+    {
+        QFETCH(bool, deferred);
+
+        QVector<qint64> times;
+        for (int i = 0; i < runCount; i++) {
+            const qint64 elapsed = runChild(QFINDTESTDATA("MinimalMainView.qml"), deferred);
+            QVERIFY2(elapsed >= 0, "time-to-first-frame could not be measured");
+            times << elapsed;
+        }
+        // report the median, startup times are noisy
+        std::sort(times.begin(), times.end());
+        QTest::setBenchmarkResult(times[runCount / 2], QTest::WalltimeMilliseconds);
+    }
+};
+
+// Child process, loads the document in a view and prints the time elapsed since
+// the process started until the first frame got swapped.
+static int firstFrame(int argc, char *argv[], const QString &fileName)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QGuiApplication application(argc, argv);
+    QQuickView view;
+    QObject::connect(&view, &QQuickWindow::frameSwapped, &application, [&timer, &application]() {
+        printf("%lld\n", timer.elapsed());
+        fflush(stdout);
+        application.quit();
+    }, Qt::QueuedConnection);
+    view.setSource(QUrl::fromLocalFile(fileName));
+    if (view.status() != QQuickView::Ready) {
+        return 1;
+    }
+    view.show();
+    return application.exec();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 3 && !qstrcmp(argv[1], firstFrameArgument)) {
+        return firstFrame(argc, argv, QString::fromLocal8Bit(argv[2]));
+    }
+    QGuiApplication application(argc, argv);
+    tst_StartupBenchmark test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_startup_benchmark.moc"
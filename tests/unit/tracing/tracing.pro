@@ -0,0 +1,6 @@
+include(../test-include.pri)
+QT += UbuntuMetrics-private
+SOURCES += \
+    tst_tracing.cpp
+DISTFILES += \
+    StyledItems.qml
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+#include <QtTest/QtTest>
+#include <UbuntuMetrics/private/tracing_p.h>
+
+class tst_Tracing : public QObject
+{
+    Q_OBJECT
+
+    QVector<UMTracing::Span> spans()
+    {
+        QVector<UMTracing::Span> spans(UMTracing::memorySpanCount);
+        spans.resize(UMTracing::memorySpans(spans.data(), spans.size()));
+        return spans;
+    }
+
+    static bool balanced(const QVector<UMTracing::Span> &spans)
+    {
+        QVector<const char*> stack;
+        for (const UMTracing::Span &span : spans) {
+            if (span.begin) {
+                stack << span.name;
+            } else if (stack.isEmpty() || qstrcmp(stack.takeLast(), span.name)) {
+                return false;
+            }
+        }
+        return stack.isEmpty();
+    }
+
+    // Returns the first span named name followed by the spans enclosing it,
+    // outermost first, or an empty list if there's no such span.
+    static QStringList stackOf(const QVector<UMTracing::Span> &spans, const char *name)
+    {
+        QStringList stack;
+        for (const UMTracing::Span &span : spans) {
+            if (span.begin) {
+                if (!qstrcmp(span.name, name)) {
+                    stack.prepend(QString::fromLatin1(name));
+                    return stack;
+                }
+                stack << QString::fromLatin1(span.name);
+            } else if (!stack.isEmpty()) {
+                stack.removeLast();
+            }
+        }
+        return QStringList();
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        UMTracing::setBackend(UMTracing::MemoryBackend);
+    }
+
+    void init()
+    {
+        UMTracing::clearMemorySpans();
+    }
+
+    void test_memory_ring()
+    {
+        UMTracing::beginSpan("outer");
+        {
+            UMTracingSpan span("inner");
+        }
+        UMTracing::endSpan("outer");
+
+        QVector<UMTracing::Span> recorded = spans();
+        QCOMPARE(recorded.size(), 4);
+        QCOMPARE(recorded[0].name, "outer");
+        QVERIFY(recorded[0].begin);
+        QCOMPARE(recorded[1].name, "inner");
+        QVERIFY(recorded[1].begin);
+        QCOMPARE(recorded[2].name, "inner");
+        QVERIFY(!recorded[2].begin);
+        QCOMPARE(recorded[3].name, "outer");
+        QVERIFY(!recorded[3].begin);
+        for (int i = 1; i < recorded.size(); i++) {
+            QVERIFY(recorded[i].timeStamp >= recorded[i - 1].timeStamp);
+        }
+    }
+
+    void test_memory_ring_wraps()
+    {
+        const int count = UMTracing::memorySpanCount + 10;
+        for (int i = 0; i < count; i++) {
+            UMTracing::beginSpan(i < count - 1 ? "old" : "last");
+        }
+        QVector<UMTracing::Span> recorded = spans();
+        QCOMPARE(recorded.size(), static_cast<int>(UMTracing::memorySpanCount));
+        QCOMPARE(recorded.last().name, "last");
+    }
+
+    void test_no_backend()
+    {
+        UMTracing::setBackend(UMTracing::NoBackend);
+        UMTracing::beginSpan("dropped");
+        UMTracing::endSpan("dropped");
+        UMTracing::setBackend(UMTracing::MemoryBackend);
+        QCOMPARE(spans().size(), 0);
+    }
+
+    void test_startup_spans()
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, QUrl::fromLocalFile(QFINDTESTDATA("StyledItems.qml")));
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY2(root, qPrintable(component.errorString()));
+
+        QVector<UMTracing::Span> recorded = spans();
+        QVERIFY(balanced(recorded));
+        QCOMPARE(stackOf(recorded, "initializeModule"),
+                 QStringList() << "initializeModule");
+        QCOMPARE(stackOf(recorded, "units"),
+                 QStringList() << "units" << "initializeModule");
+        QCOMPARE(stackOf(recorded, "theme"),
+                 QStringList() << "theme" << "initializeModule");
+        QCOMPARE(stackOf(recorded, "imageProviders"),
+                 QStringList() << "imageProviders" << "initializeModule");
+        QVERIFY(!stackOf(recorded, "loadStyleItem").isEmpty());
+    }
+};
+
+QTEST_MAIN(tst_Tracing)
+
+#include "tst_tracing.moc"
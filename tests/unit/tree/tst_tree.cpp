@@ -459,6 +459,77 @@ private Q_SLOTS:
         //out of bounds
         QVERIFY(tree.top(0, true, 19) == nullptr);
     }
+
+    void test_pushAndPopManyPages () {
+        Tree tree;
+        QObject parent;
+        const int columns = 3;
+
+        // reference model of the tree, in order of addition
+        QList<QObject *> nodes;
+        QList<int> stems;
+        QList<QObject *> parents;
+
+        QObject *rootNode = new QObject(&parent);
+        QVERIFY(tree.add(0, nullptr, rootNode));
+        nodes << rootNode;
+        stems << 0;
+        parents << nullptr;
+
+        quint32 seed = 1;
+        for (int i = 0; i < 10000; i++) {
+            seed = seed * 1103515245 + 12345;
+            const int column = (seed >> 16) % columns;
+
+            if ((seed >> 8) % 4 == 0 && nodes.size() > 1) {
+                // pop the top page
+                QObject *top = tree.top();
+                QCOMPARE(top, nodes.last());
+                QList<QObject *> removed = tree.chop(QVariant());
+                QCOMPARE(removed.size(), 1);
+                nodes.removeLast();
+                stems.removeLast();
+                parents.removeLast();
+                delete top;
+                continue;
+            }
+
+            // push a page in the column, removing the pages of the columns after it
+            QList<QObject *> expectedRemoved;
+            for (int n = nodes.size() - 1; n > 0; n--) {
+                if (stems[n] >= column + 1) {
+                    expectedRemoved.prepend(nodes.takeAt(n));
+                    stems.removeAt(n);
+                    parents.removeAt(n);
+                }
+            }
+            QCOMPARE(tree.prune(column + 1), expectedRemoved);
+            qDeleteAll(expectedRemoved);
+
+            QObject *parentNode = nodes.last();
+            QObject *page = new QObject(&parent);
+            QVERIFY(tree.add(column, parentNode, page));
+            nodes << page;
+            stems << column;
+            parents << parentNode;
+
+            if (i % 500 == 0) {
+                for (int n = 0; n < nodes.size(); n++) {
+                    QCOMPARE(tree.index(nodes[n]), n);
+                    QCOMPARE(tree.parent(nodes[n]), n ? parents[n] : nullptr);
+                }
+                for (int stem = 0; stem < columns; stem++) {
+                    int matching = 0;
+                    for (int n = nodes.size() - 1; n >= 0 && matching < 2; n--) {
+                        if (stems[n] >= stem) {
+                            QCOMPARE(tree.top(stem, false, matching++), nodes[n]);
+                        }
+                    }
+                }
+            }
+        }
+        QCOMPARE(tree.top(), nodes.last());
+    }
 };
 
 QTEST_MAIN(tst_Tree)
@@ -34,6 +34,7 @@ SUBDIRS += \
     touchregistry \
     bottomedge \
     asyncloader \
+    componentcache \
     custom_qpa \
     units \
     scaling_image_provider \
@@ -48,4 +49,15 @@ SUBDIRS += \
     alarms \
     theme \
     quickutils \
-    tree
+    menu \
+    tree \
+    performancemetrics \
+    gputimer \
+    processsampler \
+    dbusserviceproperties \
+    splitview \
+    startup_benchmark \
+    tracing \
+    performancerunner \
+    listitem_recycling \
+    listitem_actions_panel